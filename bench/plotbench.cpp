@@ -0,0 +1,426 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Headless plot benchmark.
+ *
+ * Renders TimePlotViews and XYPlotViews with synthetic signals of 10^3 to
+ * 10^max_exp samples on the Qt offscreen platform and measures:
+ *
+ *  - replot: A full render of the plot into an offscreen image. Tiled
+ *            curves are drawn synchronously in this case, so the time
+ *            covers all decimation and painting work.
+ *  - update: Appending a block of samples and refreshing the plot
+ *            (Plot::refresh() -> update_intervals() / update_curves()),
+ *            including the following paint event.
+ *  - zoom:   Zooming the x axis to the middle half of the data and
+ *            rendering the plot.
+ *
+ * The median of all repetitions is printed as CSV. With a baseline file (the
+ * output of a previous run), every measurement that is slower than the
+ * baseline by more than the given tolerance factor is reported and the exit
+ * code is 1, so CI can catch regressions e.g. after Qt or Qwt upgrades.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <libsigrokcxx/libsigrokcxx.hpp>
+
+#include <QApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+
+#include <qwt_plot_renderer.h>
+
+#include "src/devicemanager.hpp"
+#include "src/session.hpp"
+#include "src/settingsmanager.hpp"
+#include "src/channels/userchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/userdevice.hpp"
+#include "src/ui/views/timeplotview.hpp"
+#include "src/ui/views/xyplotview.hpp"
+#include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/curve.hpp"
+#include "src/ui/widgets/plot/plot.hpp"
+
+using std::exception;
+using std::map;
+using std::set;
+using std::shared_ptr;
+using std::static_pointer_cast;
+using std::string;
+using std::tuple;
+using std::vector;
+
+namespace {
+
+const uint64_t samplerate = 1000000;
+const size_t push_block_size = 1000000;
+const size_t update_block_size = 1000;
+const int plot_width = 1280;
+const int plot_height = 720;
+
+// map<tuple<view, points, metric>, milliseconds>
+typedef map<tuple<string, uint64_t, string>, double> results_t;
+
+void usage()
+{
+	fprintf(stdout,
+		"Usage:\n"
+		"  smuview-bench [OPTIONS]\n"
+		"\n"
+		"Help Options:\n"
+		"  -h, -?, --help             Show help option\n"
+		"\n"
+		"Application Options:\n"
+		"  -m, --max-exponent         Largest signal has 10^m samples (3-8, default: 8)\n"
+		"  -r, --repeat               Repetitions per measurement (default: 5)\n"
+		"  -o, --output               Write the results as CSV to file\n"
+		"  -b, --baseline             Compare against the CSV of a previous run\n"
+		"  -t, --tolerance            Allowed slowdown factor against the baseline\n"
+		"                             (default: 1.5)\n"
+		"\n");
+}
+
+/**
+ * Fill the signal with a noisy sine. The samples are pushed in blocks, like
+ * a real device would do.
+ */
+void push_samples(shared_ptr<sv::data::AnalogTimeSignal> signal,
+	uint64_t offset, uint64_t count, double phase)
+{
+	vector<double> block;
+	block.reserve((size_t)std::min<uint64_t>(count, push_block_size));
+	uint64_t pos = 0;
+	while (pos < count) {
+		const size_t size =
+			(size_t)std::min<uint64_t>(count - pos, push_block_size);
+		block.resize(size);
+		for (size_t i=0; i<size; ++i) {
+			const uint64_t n = offset + pos + i;
+			block[i] = std::sin((double)n * 0.0001 + phase) +
+				0.05 * (double)((n * 2654435761u) % 1000) / 1000.;
+		}
+		const double timestamp = signal->signal_start_timestamp() +
+			(double)(offset + pos) / (double)samplerate;
+		signal->push_samples(block.data(), size, timestamp, samplerate,
+			sizeof(double), 7, 3);
+		pos += size;
+	}
+}
+
+double median(vector<double> values)
+{
+	std::sort(values.begin(), values.end());
+	return values[values.size() / 2];
+}
+
+double elapsed_ms(const QElapsedTimer &timer)
+{
+	return (double)timer.nsecsElapsed() / 1000000.;
+}
+
+double measure_replot(sv::ui::widgets::plot::Plot *plot)
+{
+	QImage image(plot->size(), QImage::Format_ARGB32_Premultiplied);
+	QPainter painter(&image);
+	QwtPlotRenderer renderer;
+
+	QElapsedTimer timer;
+	timer.start();
+	renderer.render(plot, &painter, QRectF(image.rect()));
+	return elapsed_ms(timer);
+}
+
+double measure_zoom(sv::ui::widgets::plot::Plot *plot)
+{
+	const auto *curve = plot->curve_map().begin()->second;
+	const QRectF rect = curve->curve_data()->boundingRect();
+	const int x_axis_id = curve->x_axis_id();
+
+	QElapsedTimer timer;
+	timer.start();
+	plot->setAxisScale(x_axis_id,
+		rect.left() + rect.width() / 4, rect.right() - rect.width() / 4);
+	const double ms = measure_replot(plot) + elapsed_ms(timer);
+	plot->setAxisScale(x_axis_id, rect.left(), rect.right());
+	return ms;
+}
+
+/**
+ * Process events until all samples are visible in the curve. XY curves align
+ * their samples on the worker pool.
+ */
+void wait_for_curve(sv::ui::widgets::plot::Plot *plot, uint64_t count)
+{
+	const auto *curve_data = plot->curve_map().begin()->second->curve_data();
+	while (curve_data->size() < count) {
+		QCoreApplication::processEvents();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+void run_view(results_t &results, const string &view_name,
+	sv::ui::views::BasePlotView *view,
+	vector<shared_ptr<sv::data::AnalogTimeSignal>> signals,
+	uint64_t count, int repeat)
+{
+	auto *plot = view->plot();
+	// Refreshes are triggered by hand, not by the refresh scheduler.
+	plot->stop();
+	view->resize(plot_width, plot_height);
+	view->show();
+	QCoreApplication::processEvents();
+
+	wait_for_curve(plot, count);
+	plot->refresh();
+	QCoreApplication::processEvents();
+
+	vector<double> replot_ms;
+	vector<double> update_ms;
+	vector<double> zoom_ms;
+	uint64_t size = count;
+	for (int i=0; i<repeat; ++i) {
+		replot_ms.push_back(measure_replot(plot));
+		zoom_ms.push_back(measure_zoom(plot));
+
+		for (size_t j=0; j<signals.size(); ++j)
+			push_samples(signals[j], size, update_block_size, (double)j);
+		size += update_block_size;
+		wait_for_curve(plot, size);
+		QElapsedTimer timer;
+		timer.start();
+		plot->refresh();
+		QCoreApplication::processEvents();
+		update_ms.push_back(elapsed_ms(timer));
+	}
+
+	results[tuple<string, uint64_t, string>(view_name, count, "replot")] =
+		median(replot_ms);
+	results[tuple<string, uint64_t, string>(view_name, count, "update")] =
+		median(update_ms);
+	results[tuple<string, uint64_t, string>(view_name, count, "zoom")] =
+		median(zoom_ms);
+
+	view->close();
+	delete view;
+}
+
+void run_size(sv::Session &session, results_t &results, uint64_t count,
+	int repeat)
+{
+	auto device = session.add_user_device();
+	auto channel = device->add_user_channel("Bench", "Bench");
+	auto x_signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+		channel->add_signal(sv::data::Quantity::Voltage,
+			set<sv::data::QuantityFlag>(), sv::data::Unit::Volt));
+	auto y_signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+		channel->add_signal(sv::data::Quantity::Current,
+			set<sv::data::QuantityFlag>(), sv::data::Unit::Ampere));
+	push_samples(x_signal, 0, count, 0.);
+	push_samples(y_signal, 0, count, 1.);
+
+	auto *time_view = new sv::ui::views::TimePlotView(session);
+	time_view->add_signal(x_signal);
+	run_view(results, "timeplot", time_view, { x_signal }, count, repeat);
+
+	auto *xy_view = new sv::ui::views::XYPlotView(session);
+	xy_view->add_signals(x_signal, y_signal);
+	run_view(results, "xyplot", xy_view, { x_signal, y_signal }, count,
+		repeat);
+
+	session.remove_device(device);
+}
+
+void write_results(std::ostream &stream, const results_t &results)
+{
+	stream << "view,points,metric,ms\n";
+	for (const auto &result : results) {
+		stream << std::get<0>(result.first) << ","
+			<< std::get<1>(result.first) << ","
+			<< std::get<2>(result.first) << ","
+			<< result.second << "\n";
+	}
+}
+
+bool read_results(const string &file_name, results_t &results)
+{
+	std::ifstream file(file_name);
+	if (!file)
+		return false;
+
+	string line;
+	std::getline(file, line); // Header
+	while (std::getline(file, line)) {
+		std::istringstream stream(line);
+		string view;
+		string points;
+		string metric;
+		string ms;
+		if (!std::getline(stream, view, ',') ||
+				!std::getline(stream, points, ',') ||
+				!std::getline(stream, metric, ',') ||
+				!std::getline(stream, ms, ','))
+			continue;
+		results[tuple<string, uint64_t, string>(
+			view, std::stoull(points), metric)] = std::stod(ms);
+	}
+	return true;
+}
+
+/**
+ * Return the number of measurements, that are slower than the baseline by
+ * more than the tolerance factor.
+ */
+int compare_results(const results_t &results, const results_t &baseline,
+	double tolerance)
+{
+	int regressions = 0;
+	for (const auto &result : results) {
+		const auto it = baseline.find(result.first);
+		if (it == baseline.end())
+			continue;
+		if (result.second > it->second * tolerance) {
+			fprintf(stderr, "Regression: %s %llu %s: %.3f ms (baseline %.3f ms)\n",
+				std::get<0>(result.first).c_str(),
+				(unsigned long long)std::get<1>(result.first),
+				std::get<2>(result.first).c_str(),
+				result.second, it->second);
+			++regressions;
+		}
+	}
+	return regressions;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	int max_exponent = 8;
+	int repeat = 5;
+	string output_file;
+	string baseline_file;
+	double tolerance = 1.5;
+
+	// Run without a display, unless the platform is set explicitly.
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	QApplication app(argc, argv);
+	QApplication::setApplicationName("SmuView Benchmark");
+	QApplication::setOrganizationName("sigrok");
+
+	while (true) {
+		static const struct option long_options[] = {
+			{ "help", no_argument, nullptr, 'h' },
+			{ "max-exponent", required_argument, nullptr, 'm' },
+			{ "repeat", required_argument, nullptr, 'r' },
+			{ "output", required_argument, nullptr, 'o' },
+			{ "baseline", required_argument, nullptr, 'b' },
+			{ "tolerance", required_argument, nullptr, 't' },
+			{ nullptr, 0, nullptr, 0 }
+		};
+
+		const int arg_char = getopt_long(argc, argv,
+			"h?m:r:o:b:t:", long_options, nullptr);
+		if (arg_char == -1)
+			break;
+
+		switch (arg_char) {
+		case 'h':
+		case '?':
+			usage();
+			return 0;
+		case 'm':
+			max_exponent = std::max(3, std::min(8, atoi(optarg)));
+			break;
+		case 'r':
+			repeat = std::max(1, atoi(optarg));
+			break;
+		case 'o':
+			output_file = optarg;
+			break;
+		case 'b':
+			baseline_file = optarg;
+			break;
+		case 't':
+			tolerance = atof(optarg);
+			break;
+		}
+	}
+
+	results_t results;
+	try {
+		auto context = sigrok::Context::create();
+		sv::Session::sr_context = context;
+		sv::Session::session_start_timestamp =
+			(double)QDateTime::currentMSecsSinceEpoch() / (double)1000;
+		sv::SettingsManager::set_restore_settings(false);
+
+		sv::DeviceManager device_manager(context, vector<string>(), false);
+		sv::Session session(device_manager);
+
+		uint64_t count = 1000;
+		for (int exp=3; exp<=max_exponent; ++exp) {
+			fprintf(stderr, "Benchmarking %llu points\n",
+				(unsigned long long)count);
+			run_size(session, results, count, repeat);
+			count *= 10;
+		}
+	}
+	catch (exception &e) {
+		fprintf(stderr, "Benchmark failed: %s\n", e.what());
+		return 2;
+	}
+
+	write_results(std::cout, results);
+	if (!output_file.empty()) {
+		std::ofstream file(output_file);
+		write_results(file, results);
+	}
+
+	if (!baseline_file.empty()) {
+		results_t baseline;
+		if (!read_results(baseline_file, baseline)) {
+			fprintf(stderr, "Cannot read baseline %s\n", baseline_file.c_str());
+			return 2;
+		}
+		if (compare_results(results, baseline, tolerance) > 0)
+			return 1;
+	}
+
+	return 0;
+}
@@ -60,10 +60,10 @@ AddSCChannel::AddSCChannel(
 	sr_digits_ = signal_->sr_digits();
 
 	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
-		this, &AddSCChannel::on_sample_appended);
+		this, &AddSCChannel::on_sample_appended, Qt::DirectConnection);
 }
 
-void AddSCChannel::on_sample_appended()
+void AddSCChannel::process_samples()
 {
 	size_t signal_sample_count = signal_->sample_count();
 	while (next_signal_pos_ < signal_sample_count) {
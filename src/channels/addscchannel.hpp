@@ -62,14 +62,14 @@ public:
 		const string &channel_name,
 		double channel_start_timestamp);
 
+protected:
+	void process_samples() override;
+
 private:
 	shared_ptr<data::AnalogTimeSignal> signal_;
 	double constant_;
 	size_t next_signal_pos_;
 
-private Q_SLOTS:
-	void on_sample_appended();
-
 };
 
 } // namespace channels
@@ -0,0 +1,206 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <QDebug>
+
+#include "biquadfilterchannel.hpp"
+#include "src/channels/filterchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::set;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+BiquadFilterChannel::BiquadFilterChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		BiquadFilterType filter_type,
+		double frequency,
+		double q,
+		unsigned int section_count,
+		double samplerate,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	FilterChannel(quantity, quantity_flags, unit, signal,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	filter_type_(filter_type),
+	frequency_(frequency),
+	q_(q),
+	section_count_(section_count),
+	samplerate_(samplerate),
+	state_initialized_(false)
+{
+	assert(frequency_ > 0);
+	assert(q_ > 0);
+	assert(section_count_ > 0);
+}
+
+BiquadFilterType BiquadFilterChannel::filter_type() const
+{
+	return filter_type_;
+}
+
+double BiquadFilterChannel::frequency() const
+{
+	return frequency_;
+}
+
+double BiquadFilterChannel::q() const
+{
+	return q_;
+}
+
+unsigned int BiquadFilterChannel::section_count() const
+{
+	return section_count_;
+}
+
+double BiquadFilterChannel::samplerate() const
+{
+	return samplerate_;
+}
+
+bool BiquadFilterChannel::init_filter()
+{
+	if (samplerate_ <= 0) {
+		// Estimate the samplerate from the mean sample interval.
+		samplerate_ = signal_->mean_samplerate();
+		if (samplerate_ <= 0)
+			return false;
+	}
+
+	double frequency = frequency_;
+	if (frequency >= samplerate_ / 2) {
+		frequency = 0.49 * samplerate_;
+		qWarning() << "BiquadFilterChannel::init_filter(): Frequency" <<
+			frequency_ << "Hz is above the Nyquist frequency, using" <<
+			frequency << "Hz";
+	}
+
+	// Coefficients from the "Audio EQ Cookbook" by Robert Bristow-Johnson
+	const double pi = std::acos(-1);
+	const double w0 = 2 * pi * frequency / samplerate_;
+	const double cos_w0 = std::cos(w0);
+	const double alpha = std::sin(w0) / (2 * q_);
+
+	double b0;
+	double b1;
+	double b2;
+	switch (filter_type_) {
+	case BiquadFilterType::HighPass:
+		b0 = (1 + cos_w0) / 2;
+		b1 = -(1 + cos_w0);
+		b2 = (1 + cos_w0) / 2;
+		break;
+	case BiquadFilterType::BandPass:
+		b0 = alpha;
+		b1 = 0;
+		b2 = -alpha;
+		break;
+	case BiquadFilterType::Notch:
+		b0 = 1;
+		b1 = -2 * cos_w0;
+		b2 = 1;
+		break;
+	case BiquadFilterType::LowPass:
+	default:
+		b0 = (1 - cos_w0) / 2;
+		b1 = 1 - cos_w0;
+		b2 = (1 - cos_w0) / 2;
+		break;
+	}
+	const double a0 = 1 + alpha;
+	const double a1 = -2 * cos_w0;
+	const double a2 = 1 - alpha;
+
+	BiquadSection section;
+	section.b0 = b0 / a0;
+	section.b1 = b1 / a0;
+	section.b2 = b2 / a0;
+	section.a1 = a1 / a0;
+	section.a2 = a2 / a0;
+	section.z1 = 0;
+	section.z2 = 0;
+	sections_.assign(section_count_, section);
+
+	return true;
+}
+
+void BiquadFilterChannel::filter_block(
+	const double *in, double *out, size_t count)
+{
+	if (count == 0)
+		return;
+
+	if (!state_initialized_) {
+		// Start in the steady state for the first sample, so there is no
+		// step response at the beginning of the signal.
+		double x = in[0];
+		for (auto &s : sections_) {
+			double y = x * (s.b0 + s.b1 + s.b2) / (1 + s.a1 + s.a2);
+			s.z1 = y - s.b0 * x;
+			s.z2 = s.b2 * x - s.a2 * y;
+			x = y;
+		}
+		state_initialized_ = true;
+	}
+
+	// Run the whole block through one section after the other. The
+	// recursion can't be vectorized, but the coefficients and the state stay
+	// in registers for the whole block.
+	const double *src = in;
+	for (auto &s : sections_) {
+		const double b0 = s.b0;
+		const double b1 = s.b1;
+		const double b2 = s.b2;
+		const double a1 = s.a1;
+		const double a2 = s.a2;
+		double z1 = s.z1;
+		double z2 = s.z2;
+		for (size_t i=0; i<count; ++i) {
+			const double x = src[i];
+			const double y = b0 * x + z1;
+			z1 = b1 * x - a1 * y + z2;
+			z2 = b2 * x - a2 * y;
+			out[i] = y;
+		}
+		s.z1 = z1;
+		s.z2 = z2;
+		src = out;
+	}
+}
+
+} // namespace channels
+} // namespace sv
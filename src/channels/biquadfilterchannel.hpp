@@ -0,0 +1,127 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CHANNELS_BIQUADFILTERCHANNEL_HPP
+#define CHANNELS_BIQUADFILTERCHANNEL_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/filterchannel.hpp"
+#include "src/data/datautil.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+enum class BiquadFilterType {
+	LowPass,
+	HighPass,
+	BandPass,
+	Notch
+};
+
+/**
+ * A cascaded biquad IIR filter. All sections have the same coefficients,
+ * which are calculated from the filter type, the center/cutoff frequency
+ * and the quality factor (Q).
+ */
+class BiquadFilterChannel : public FilterChannel
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * Create a new biquad filter channel.
+	 *
+	 * @param[in] filter_type The filter type.
+	 * @param[in] frequency The cutoff/center frequency in Hz.
+	 * @param[in] q The quality factor of a single section. Use 1/sqrt(2) for
+	 *              a Butterworth response.
+	 * @param[in] section_count The number of cascaded biquad sections.
+	 * @param[in] samplerate The samplerate of the source signal in Hz. If 0,
+	 *                       the samplerate is estimated from the timestamps
+	 *                       of the first samples.
+	 */
+	BiquadFilterChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		BiquadFilterType filter_type,
+		double frequency,
+		double q,
+		unsigned int section_count,
+		double samplerate,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+	BiquadFilterType filter_type() const;
+	double frequency() const;
+	double q() const;
+	unsigned int section_count() const;
+	double samplerate() const;
+
+protected:
+	bool init_filter() override;
+	void filter_block(const double *in, double *out, size_t count) override;
+
+private:
+	struct BiquadSection
+	{
+		// Normalized coefficients (a0 = 1)
+		double b0, b1, b2, a1, a2;
+		// State of the transposed direct form II
+		double z1, z2;
+	};
+
+	BiquadFilterType filter_type_;
+	double frequency_;
+	double q_;
+	unsigned int section_count_;
+	double samplerate_;
+	bool state_initialized_;
+	vector<BiquadSection> sections_;
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_BIQUADFILTERCHANNEL_HPP
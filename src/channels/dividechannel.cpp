@@ -18,10 +18,11 @@
  */
 
 #include <cassert>
+#include <limits>
 #include <memory>
-#include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <QDebug>
 
@@ -32,11 +33,9 @@
 #include "src/data/datautil.hpp"
 #include "src/devices/basedevice.hpp"
 
-using std::lock_guard;
-using std::make_shared;
-using std::mutex;
 using std::set;
 using std::string;
+using std::vector;
 
 namespace sv {
 namespace channels {
@@ -56,12 +55,15 @@ DivideChannel::DivideChannel(
 		channel_start_timestamp),
 	dividend_signal_(dividend_signal),
 	divisor_signal_(divisor_signal),
-	dividend_signal_pos_(0),
-	divisor_signal_pos_(0)
+	index_(0., false),
+	next_row_(0)
 {
 	assert(dividend_signal_);
 	assert(divisor_signal_);
 
+	index_.add_signal(dividend_signal_);
+	index_.add_signal(divisor_signal_);
+
 	if (dividend_signal->total_digits() >= divisor_signal->total_digits())
 		total_digits_ = dividend_signal->total_digits();
 	else
@@ -74,37 +76,40 @@ DivideChannel::DivideChannel(
 		sr_digits_ = divisor_signal->sr_digits();
 
 	connect(dividend_signal_.get(), &data::AnalogTimeSignal::sample_appended,
-		this, &DivideChannel::on_sample_appended);
+		this, &DivideChannel::on_sample_appended, Qt::DirectConnection);
 	connect(divisor_signal_.get(), &data::AnalogTimeSignal::sample_appended,
-		this, &DivideChannel::on_sample_appended);
+		this, &DivideChannel::on_sample_appended, Qt::DirectConnection);
 }
 
-void DivideChannel::on_sample_appended()
+void DivideChannel::process_samples()
 {
-	lock_guard<mutex> lock(sample_append_mutex_);
-
-	shared_ptr<vector<double>> time = make_shared<vector<double>>();
-	shared_ptr<vector<double>> dividend_data = make_shared<vector<double>>();
-	shared_ptr<vector<double>> divisor_data = make_shared<vector<double>>();
+	index_.update();
 
-	sv::data::AnalogTimeSignal::combine_signals(
-		dividend_signal_, dividend_signal_pos_,
-		divisor_signal_, divisor_signal_pos_,
-		time, dividend_data, divisor_data);
+	// Values: [0] = dividend, [1] = divisor
+	vector<double> values;
+	for (; next_row_ < index_.row_count(); ++next_row_) {
+		const auto interpolation =
+			index_.interpolated_values(next_row_, values);
+		// Wait for the next sample to interpolate the row.
+		if (interpolation ==
+				data::MergedTimestampIndex::Interpolation::NoNextSample)
+			break;
+		// Ignore the first sample(s), before both signals have started.
+		if (interpolation != data::MergedTimestampIndex::Interpolation::Ok)
+			continue;
 
-	for (size_t i=0; i<time->size(); i++) {
 		// Division
 		double value;
-		if (divisor_data->at(i) == 0) {
-			if (dividend_data->at(i) > 0)
+		if (values[1] == 0) {
+			if (values[0] > 0)
 				value = std::numeric_limits<double>::max();
 			else
 				value = std::numeric_limits<double>::lowest();
 		}
 		else {
-			value = dividend_data->at(i) / divisor_data->at(i);
+			value = values[0] / values[1];
 		}
-		push_sample(value, time->at(i));
+		push_sample(value, index_.row_timestamp(next_row_));
 	}
 }
 
@@ -21,7 +21,6 @@
 #define CHANNELS_DIVIDECHANNEL_HPP
 
 #include <memory>
-#include <mutex>
 #include <set>
 #include <string>
 
@@ -30,8 +29,8 @@
 #include "src/channels/basechannel.hpp"
 #include "src/channels/mathchannel.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/mergedtimestampindex.hpp"
 
-using std::mutex;
 using std::set;
 using std::shared_ptr;
 using std::string;
@@ -64,15 +63,15 @@ public:
 		const string &channel_name,
 		double channel_start_timestamp);
 
+protected:
+	void process_samples() override;
+
 private:
 	shared_ptr<data::AnalogTimeSignal> dividend_signal_;
 	shared_ptr<data::AnalogTimeSignal> divisor_signal_;
-	size_t dividend_signal_pos_;
-	size_t divisor_signal_pos_;
-	mutex sample_append_mutex_;
-
-private Q_SLOTS:
-	void on_sample_appended();
+	/** Merged timeline of both signals, processed up to next_row_. */
+	data::MergedTimestampIndex index_;
+	size_t next_row_;
 
 };
 
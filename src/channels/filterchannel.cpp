@@ -0,0 +1,109 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <QDebug>
+
+#include "filterchannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::set;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+const size_t FilterChannel::block_size_;
+
+FilterChannel::FilterChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	next_signal_pos_(0),
+	filter_ready_(false)
+{
+	assert(signal_);
+
+	total_digits_ = signal_->total_digits();
+	sr_digits_ = signal_->sr_digits();
+
+	time_block_.reserve(block_size_);
+	in_block_.reserve(block_size_);
+	out_block_.reserve(block_size_);
+
+	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
+		this, &FilterChannel::on_sample_appended, Qt::DirectConnection);
+}
+
+bool FilterChannel::init_filter()
+{
+	return true;
+}
+
+void FilterChannel::process_samples()
+{
+	if (!filter_ready_) {
+		filter_ready_ = init_filter();
+		if (!filter_ready_)
+			return;
+	}
+
+	size_t signal_sample_count = signal_->sample_count();
+	while (next_signal_pos_ < signal_sample_count) {
+		size_t count = std::min(block_size_,
+			signal_sample_count - next_signal_pos_);
+
+		time_block_.resize(count);
+		in_block_.resize(count);
+		out_block_.resize(count);
+		for (size_t i=0; i<count; ++i) {
+			auto sample = signal_->get_sample(next_signal_pos_ + i, false);
+			time_block_[i] = sample.first;
+			in_block_[i] = sample.second;
+		}
+
+		filter_block(in_block_.data(), out_block_.data(), count);
+
+		for (size_t i=0; i<count; ++i)
+			push_sample(out_block_[i], time_block_[i]);
+		next_signal_pos_ += count;
+	}
+}
+
+} // namespace channels
+} // namespace sv
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CHANNELS_FILTERCHANNEL_HPP
+#define CHANNELS_FILTERCHANNEL_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+/**
+ * Base class for all digital filter channels. The new samples of the source
+ * signal are filtered in blocks, the filter state is carried over from one
+ * block to the next.
+ */
+class FilterChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	FilterChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+protected:
+	void process_samples() override;
+
+	/**
+	 * Prepare the filter, before the first block is filtered. This is called
+	 * again for every block until it returns true.
+	 *
+	 * @return true if the filter is ready to filter samples.
+	 */
+	virtual bool init_filter();
+
+	/**
+	 * Filter a block of samples.
+	 *
+	 * @param[in] in The input samples.
+	 * @param[out] out The filtered samples. Has the same size as in.
+	 * @param[in] count The number of samples in the block.
+	 */
+	virtual void filter_block(const double *in, double *out, size_t count) = 0;
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+
+private:
+	/** The maximum number of samples that are filtered at once. */
+	static const size_t block_size_ = 1024;
+
+	size_t next_signal_pos_;
+	bool filter_ready_;
+	vector<double> time_block_;
+	vector<double> in_block_;
+	vector<double> out_block_;
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_FILTERCHANNEL_HPP
@@ -0,0 +1,104 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QDebug>
+
+#include "firfilterchannel.hpp"
+#include "src/channels/filterchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::set;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace channels {
+
+FirFilterChannel::FirFilterChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		const vector<double> &taps,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	FilterChannel(quantity, quantity_flags, unit, signal,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	taps_(taps),
+	history_initialized_(false)
+{
+	assert(!taps_.empty());
+}
+
+vector<double> FirFilterChannel::taps() const
+{
+	return taps_;
+}
+
+void FirFilterChannel::filter_block(
+	const double *in, double *out, size_t count)
+{
+	if (count == 0)
+		return;
+
+	const size_t tap_count = taps_.size();
+	const size_t history_size = tap_count - 1;
+
+	if (!history_initialized_) {
+		// Pretend the signal was constant before the first sample, so there
+		// is no step response at the beginning of the signal.
+		history_.assign(history_size, in[0]);
+		history_initialized_ = true;
+	}
+
+	work_.resize(history_size + count);
+	std::copy(history_.begin(), history_.end(), work_.begin());
+	std::copy(in, in + count, work_.begin() + history_size);
+
+	// out[i] = sum(taps[k] * work[history_size + i - k])
+	// The loop over the taps is the outer loop, so the inner loop has no
+	// dependencies between the iterations and can be vectorized by the
+	// compiler without reordering the floating point additions.
+	std::fill(out, out + count, 0.);
+	const double *work = work_.data();
+	for (size_t k=0; k<tap_count; ++k) {
+		const double tap = taps_[k];
+		const double *src = work + history_size - k;
+		for (size_t i=0; i<count; ++i)
+			out[i] += tap * src[i];
+	}
+
+	std::copy(work_.end() - history_size, work_.end(), history_.begin());
+}
+
+} // namespace channels
+} // namespace sv
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CHANNELS_FIRFILTERCHANNEL_HPP
+#define CHANNELS_FIRFILTERCHANNEL_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/filterchannel.hpp"
+#include "src/data/datautil.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+/**
+ * A FIR filter with user defined taps.
+ */
+class FirFilterChannel : public FilterChannel
+{
+	Q_OBJECT
+
+public:
+	FirFilterChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		const vector<double> &taps,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+	vector<double> taps() const;
+
+protected:
+	void filter_block(const double *in, double *out, size_t count) override;
+
+private:
+	const vector<double> taps_;
+	/** The last (taps - 1) input samples of the previous block. */
+	vector<double> history_;
+	bool history_initialized_;
+	/** History followed by the actual block. */
+	vector<double> work_;
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_FIRFILTERCHANNEL_HPP
@@ -33,9 +33,11 @@
 #include "src/channels/basechannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/framebuffer.hpp"
 #include "src/devices/basedevice.hpp"
 
 using std::make_pair;
+using std::make_shared;
 using std::set;
 using std::static_pointer_cast;
 using std::string;
@@ -51,7 +53,10 @@ HardwareChannel::HardwareChannel(
 		const set<string> &channel_group_names,
 		double channel_start_timestamp) :
 	BaseChannel(sr_channel, parent_device, channel_group_names,
-		channel_start_timestamp)
+		channel_start_timestamp),
+	frame_buffer_(make_shared<data::FrameBuffer>()),
+	scope_mode_count_(0),
+	store_frames_in_signal_(true)
 {
 	assert(sr_channel);
 
@@ -111,6 +116,12 @@ void HardwareChannel::push_interleaved_samples(const float *data,
 		data += stride;
 	}
 
+	if (frame_buffer_->in_frame()) {
+		frame_buffer_->append(deint_data.get(), sample_count, samplerate);
+		if (!store_frames_in_signal_ && is_scope_mode())
+			return;
+	}
+
 	// NOTE: Not implementet in sigrok yet, so using the default for now.
 	const int total_digits = data::DefaultTotalDigits;
 
@@ -119,5 +130,50 @@ void HardwareChannel::push_interleaved_samples(const float *data,
 		sr_analog->unitsize(), total_digits, sr_analog->digits());
 }
 
+void HardwareChannel::begin_frame()
+{
+	// The frames are only copied into the frame buffer, while they are shown.
+	if (is_scope_mode())
+		frame_buffer_->begin_frame();
+}
+
+void HardwareChannel::end_frame()
+{
+	if (frame_buffer_->in_frame())
+		frame_buffer_->end_frame();
+	Q_EMIT frame_ended();
+}
+
+shared_ptr<data::FrameBuffer> HardwareChannel::frame_buffer() const
+{
+	return frame_buffer_;
+}
+
+void HardwareChannel::enable_scope_mode()
+{
+	++scope_mode_count_;
+}
+
+void HardwareChannel::disable_scope_mode()
+{
+	assert(scope_mode_count_ > 0);
+	--scope_mode_count_;
+}
+
+bool HardwareChannel::is_scope_mode() const
+{
+	return scope_mode_count_ > 0;
+}
+
+void HardwareChannel::set_store_frames_in_signal(bool store_frames_in_signal)
+{
+	store_frames_in_signal_ = store_frames_in_signal;
+}
+
+bool HardwareChannel::store_frames_in_signal() const
+{
+	return store_frames_in_signal_;
+}
+
 } // namespace channels
 } // namespace sv
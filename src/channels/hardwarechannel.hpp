@@ -20,6 +20,7 @@
 #ifndef CHANNELS_HARDWARECHANNEL_HPP
 #define CHANNELS_HARDWARECHANNEL_HPP
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <string>
@@ -28,6 +29,7 @@
 
 #include "src/channels/basechannel.hpp"
 
+using std::atomic;
 using std::set;
 using std::shared_ptr;
 using std::string;
@@ -39,6 +41,9 @@ class Channel;
 
 namespace sv {
 
+namespace data {
+class FrameBuffer;
+}
 namespace devices {
 class BaseDevice;
 }
@@ -68,6 +73,46 @@ public:
 		size_t stride, double timestamp, uint64_t samplerate,
 		shared_ptr<sigrok::Analog> sr_analog);
 
+	/**
+	 * Start a new frame. In scope mode, all samples pushed until end_frame()
+	 * are also stored in the frame buffer.
+	 */
+	void begin_frame();
+	void end_frame();
+	/** The last frames of the channel, e.g. of an oscilloscope. */
+	shared_ptr<data::FrameBuffer> frame_buffer() const;
+
+	/**
+	 * In scope mode, the samples of frames are also copied into the frame
+	 * buffer, where they overwrite the oldest frame. Every scope curve of the
+	 * channel enables the scope mode until it is destroyed.
+	 */
+	void enable_scope_mode();
+	void disable_scope_mode();
+	bool is_scope_mode() const;
+
+	/**
+	 * Set if the samples of frames are appended to the signal in scope mode
+	 * (default). If not, the frames are only kept in the frame buffer, so the
+	 * memory doesn't grow with every frame, but all other users of the
+	 * signal (plots, math channels, ...) don't get the samples of frames.
+	 */
+	void set_store_frames_in_signal(bool store_frames_in_signal);
+	bool store_frames_in_signal() const;
+
+private:
+	shared_ptr<data::FrameBuffer> frame_buffer_;
+	/** The number of users of the scope mode. */
+	atomic<unsigned int> scope_mode_count_;
+	atomic<bool> store_frames_in_signal_;
+
+Q_SIGNALS:
+	/**
+	 * Emitted from the acquisition thread, after the last sample of a frame
+	 * was pushed.
+	 */
+	void frame_ended();
+
 };
 
 } // namespace channels
@@ -18,6 +18,8 @@
  */
 
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
@@ -52,7 +54,8 @@ IntegrateChannel::IntegrateChannel(
 	int_signal_(int_signal),
 	next_int_signal_pos_(0),
 	last_timestamp_(channel_start_timestamp),
-	last_value_(0.)
+	last_value_(0.),
+	pending_start_timestamp_(std::numeric_limits<double>::quiet_NaN())
 {
 	assert(int_signal_);
 
@@ -62,18 +65,25 @@ IntegrateChannel::IntegrateChannel(
 	connect(this, &IntegrateChannel::channel_start_timestamp_changed,
 		this, &IntegrateChannel::on_channel_start_timestamp_changed);
 	connect(int_signal_.get(), &data::AnalogTimeSignal::sample_appended,
-		this, &IntegrateChannel::on_sample_appended);
+		this, &IntegrateChannel::on_sample_appended, Qt::DirectConnection);
 }
 
 void IntegrateChannel::on_channel_start_timestamp_changed(double timestamp)
 {
-	// TODO: check if already started?
-	if (last_timestamp_ < 0)
-		last_timestamp_ = timestamp;
+	// The samples are processed in the worker pool, the timestamp is applied
+	// there.
+	pending_start_timestamp_ = timestamp;
+	on_sample_appended();
 }
 
-void IntegrateChannel::on_sample_appended()
+void IntegrateChannel::process_samples()
 {
+	const double start_timestamp = pending_start_timestamp_.exchange(
+		std::numeric_limits<double>::quiet_NaN());
+	// TODO: check if already started?
+	if (!std::isnan(start_timestamp) && last_timestamp_ < 0)
+		last_timestamp_ = start_timestamp;
+
 	// Integrate
 	size_t int_signal_sample_count = int_signal_->sample_count();
 	while (next_int_signal_pos_ < int_signal_sample_count) {
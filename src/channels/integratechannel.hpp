@@ -20,6 +20,7 @@
 #ifndef CHANNELS_INTEGRATECHANNEL_HPP
 #define CHANNELS_INTEGRATECHANNEL_HPP
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <string>
@@ -30,6 +31,7 @@
 #include "src/channels/mathchannel.hpp"
 #include "src/data/datautil.hpp"
 
+using std::atomic;
 using std::set;
 using std::shared_ptr;
 using std::string;
@@ -61,15 +63,23 @@ public:
 		const string &channel_name,
 		double channel_start_timestamp);
 
+protected:
+	void process_samples() override;
+
 private:
 	shared_ptr<data::AnalogTimeSignal> int_signal_;
+	// Only touched within process_samples()
 	size_t next_int_signal_pos_;
 	double last_timestamp_;
 	double last_value_;
+	/**
+	 * The new channel start timestamp, that is applied by the next
+	 * process_samples() call. NaN if there is none.
+	 */
+	atomic<double> pending_start_timestamp_;
 
 private Q_SLOTS:
 	void on_channel_start_timestamp_changed(double timestamp);
-	void on_sample_appended();
 
 };
 
@@ -21,10 +21,15 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QEvent>
 
 #include "mathchannel.hpp"
+#include "src/session.hpp"
+#include "src/workerpool.hpp"
 #include "src/channels/basechannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/basesignal.hpp"
@@ -34,11 +39,42 @@
 using std::set;
 using std::static_pointer_cast;
 using std::string;
+using std::weak_ptr;
 using sv::data::measured_quantity_t;
 
 namespace sv {
 namespace channels {
 
+namespace {
+
+/**
+ * Holds the last reference of a channel, that was removed while it was
+ * processed in the worker pool. Posted events are deleted in the thread of
+ * the receiver, so the channel (a QObject of the GUI thread) is destroyed
+ * there.
+ */
+class ReleaseChannelEvent : public QEvent
+{
+public:
+	explicit ReleaseChannelEvent(shared_ptr<BaseChannel> channel) :
+		QEvent(event_type()),
+		channel_(std::move(channel))
+	{
+	}
+
+	static QEvent::Type event_type()
+	{
+		static const QEvent::Type type =
+			static_cast<QEvent::Type>(QEvent::registerEventType());
+		return type;
+	}
+
+private:
+	shared_ptr<BaseChannel> channel_;
+};
+
+} // namespace
+
 MathChannel::MathChannel(
 		data::Quantity quantity,
 		const set<data::QuantityFlag> &quantity_flags,
@@ -53,7 +89,9 @@ MathChannel::MathChannel(
 	sr_digits_(data::DefaultSRDigits),
 	quantity_(quantity),
 	quantity_flags_(quantity_flags),
-	unit_(unit)
+	unit_(unit),
+	processing_state_(ProcessingIdle),
+	signal_ready_(false)
 {
 	name_ = channel_name;
 	type_ = ChannelType::MathChannel;
@@ -91,6 +129,13 @@ data::Unit MathChannel::unit()
 	return unit_;
 }
 
+void MathChannel::start_processing()
+{
+	assert(actual_signal_);
+	signal_ready_ = true;
+	on_sample_appended();
+}
+
 void MathChannel::push_sample(double sample, double timestamp)
 {
 	auto signal = static_pointer_cast<data::AnalogTimeSignal>(actual_signal_);
@@ -98,5 +143,68 @@ void MathChannel::push_sample(double sample, double timestamp)
 		total_digits_, sr_digits_);
 }
 
+void MathChannel::on_sample_appended()
+{
+	// The source signals are connected directly, so a sample can be appended
+	// before the math signal was added. Those samples are picked up when
+	// start_processing() is called.
+	if (!signal_ready_.load())
+		return;
+
+	if (!Session::worker_pool) {
+		process_samples();
+		return;
+	}
+
+	int state = processing_state_.load();
+	while (true) {
+		if (state == ProcessingRunningDirty)
+			return;
+		if (state == ProcessingRunning) {
+			// The running/queued processing will pick up the new samples.
+			if (processing_state_.compare_exchange_weak(
+					state, ProcessingRunningDirty))
+				return;
+			continue;
+		}
+		if (processing_state_.compare_exchange_weak(state, ProcessingRunning))
+			break;
+	}
+
+	weak_ptr<BaseChannel> weak_channel;
+	try {
+		weak_channel = shared_from_this();
+	}
+	catch (const std::bad_weak_ptr &) {
+		// The channel is still in construction, process the samples with the
+		// next notification.
+		processing_state_ = ProcessingIdle;
+		return;
+	}
+
+	Session::worker_pool->submit([weak_channel]() {
+		auto channel = static_pointer_cast<MathChannel>(weak_channel.lock());
+		if (!channel)
+			return;
+		channel->run_processing();
+		// Don't destroy the channel in the worker thread, if it was removed
+		// in the meantime.
+		if (channel.use_count() == 1 && QCoreApplication::instance()) {
+			QCoreApplication::postEvent(QCoreApplication::instance(),
+				new ReleaseChannelEvent(std::move(channel)));
+		}
+	});
+}
+
+void MathChannel::run_processing()
+{
+	int state;
+	do {
+		processing_state_ = ProcessingRunning;
+		process_samples();
+		state = ProcessingRunning;
+	} while (!processing_state_.compare_exchange_strong(state, ProcessingIdle));
+}
+
 } // namespace channels
 } // namespace sv
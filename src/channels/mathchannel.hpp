@@ -20,6 +20,7 @@
 #ifndef CHANNELS_MATHCHANNEL_HPP
 #define CHANNELS_MATHCHANNEL_HPP
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <string>
@@ -30,6 +31,7 @@
 #include "src/channels/basechannel.hpp"
 #include "src/data/datautil.hpp"
 
+using std::atomic;
 using std::set;
 using std::shared_ptr;
 using std::string;
@@ -79,18 +81,58 @@ public:
 	 */
 	data::Unit unit();
 
+	/**
+	 * Start processing the samples of the source signal(s). This must be
+	 * called after the signal of the math channel was added. Samples that
+	 * were appended to the source signals before, are processed now.
+	 */
+	void start_processing();
+
 protected:
 	/**
 	 * Add a single sample with timestamp to the channel/signal
 	 */
 	void push_sample(double sample, double timestamp);
 
+	/**
+	 * Process all new samples of the source signal(s).
+	 *
+	 * This is called from the session worker pool. It is never called
+	 * concurrently for the same channel, so the samples of the math signal
+	 * are always pushed in order.
+	 */
+	virtual void process_samples() = 0;
+
 	int total_digits_;
 	int sr_digits_;
 	data::Quantity quantity_;
 	set<data::QuantityFlag> quantity_flags_;
 	data::Unit unit_;
 
+private:
+	enum ProcessingState {
+		ProcessingIdle = 0,
+		ProcessingRunning,
+		ProcessingRunningDirty
+	};
+
+	void run_processing();
+
+	atomic<int> processing_state_;
+	/** Set, when the signal of the math channel exists. */
+	atomic<bool> signal_ready_;
+
+protected Q_SLOTS:
+	/**
+	 * Schedule process_samples() on the session worker pool. Notifications
+	 * while the processing is queued or running are coalesced.
+	 *
+	 * Connect the sample_appended() signals of the source signals with
+	 * Qt::DirectConnection to this slot, so the acquisition thread doesn't
+	 * have to go through the GUI event loop.
+	 */
+	void on_sample_appended();
+
 };
 
 } // namespace channels
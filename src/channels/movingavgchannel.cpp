@@ -65,10 +65,10 @@ MovingAvgChannel::MovingAvgChannel(
 		avg_samples_[i] = 0;
 
 	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
-		this, &MovingAvgChannel::on_sample_appended);
+		this, &MovingAvgChannel::on_sample_appended, Qt::DirectConnection);
 }
 
-void MovingAvgChannel::on_sample_appended()
+void MovingAvgChannel::process_samples()
 {
 	size_t signal_sample_count = signal_->sample_count();
 	while (next_signal_pos_ < signal_sample_count) {
@@ -60,10 +60,10 @@ MultiplySFChannel::MultiplySFChannel(
 	sr_digits_ = signal_->sr_digits();
 
 	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
-		this, &MultiplySFChannel::on_sample_appended);
+		this, &MultiplySFChannel::on_sample_appended, Qt::DirectConnection);
 }
 
-void MultiplySFChannel::on_sample_appended()
+void MultiplySFChannel::process_samples()
 {
 	size_t signal_sample_count = signal_->sample_count();
 	while (next_signal_pos_ < signal_sample_count) {
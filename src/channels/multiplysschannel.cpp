@@ -19,9 +19,9 @@
 
 #include <cassert>
 #include <memory>
-#include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <QDebug>
 
@@ -32,11 +32,9 @@
 #include "src/data/datautil.hpp"
 #include "src/devices/basedevice.hpp"
 
-using std::lock_guard;
-using std::make_shared;
-using std::mutex;
 using std::set;
 using std::string;
+using std::vector;
 
 namespace sv {
 namespace channels {
@@ -56,12 +54,15 @@ MultiplySSChannel::MultiplySSChannel(
 		channel_start_timestamp),
 	signal1_(signal1),
 	signal2_(signal2),
-	signal1_pos_(0),
-	signal2_pos_(0)
+	index_(0., false),
+	next_row_(0)
 {
 	assert(signal1_);
 	assert(signal2_);
 
+	index_.add_signal(signal1_);
+	index_.add_signal(signal2_);
+
 	if (signal1_->total_digits() >= signal2_->total_digits())
 		total_digits_ = signal1_->total_digits();
 	else
@@ -74,26 +75,28 @@ MultiplySSChannel::MultiplySSChannel(
 		sr_digits_ = signal2_->sr_digits();
 
 	connect(signal1_.get(), &data::AnalogTimeSignal::sample_appended,
-		this, &MultiplySSChannel::on_sample_appended);
+		this, &MultiplySSChannel::on_sample_appended, Qt::DirectConnection);
 	connect(signal2_.get(), &data::AnalogTimeSignal::sample_appended,
-		this, &MultiplySSChannel::on_sample_appended);
+		this, &MultiplySSChannel::on_sample_appended, Qt::DirectConnection);
 }
 
-void MultiplySSChannel::on_sample_appended()
+void MultiplySSChannel::process_samples()
 {
-	lock_guard<mutex> lock(sample_append_mutex_);
-
-	shared_ptr<vector<double>> time = make_shared<vector<double>>();
-	shared_ptr<vector<double>> signal1_data = make_shared<vector<double>>();
-	shared_ptr<vector<double>> signal2_data = make_shared<vector<double>>();
+	index_.update();
 
-	sv::data::AnalogTimeSignal::combine_signals(
-		signal1_, signal1_pos_,
-		signal2_, signal2_pos_,
-		time, signal1_data, signal2_data);
+	vector<double> values;
+	for (; next_row_ < index_.row_count(); ++next_row_) {
+		const auto interpolation =
+			index_.interpolated_values(next_row_, values);
+		// Wait for the next sample to interpolate the row.
+		if (interpolation ==
+				data::MergedTimestampIndex::Interpolation::NoNextSample)
+			break;
+		// Ignore the first sample(s), before both signals have started.
+		if (interpolation != data::MergedTimestampIndex::Interpolation::Ok)
+			continue;
 
-	for (size_t i=0; i<time->size(); i++) {
-		push_sample(signal1_data->at(i) * signal2_data->at(i), time->at(i));
+		push_sample(values[0] * values[1], index_.row_timestamp(next_row_));
 	}
 }
 
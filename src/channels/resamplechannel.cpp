@@ -0,0 +1,240 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <QDebug>
+
+#include "resamplechannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::set;
+using std::static_pointer_cast;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+namespace {
+
+const double pi = std::acos(-1);
+
+// Number of zero crossings of the sinc kernel on each side.
+const double sinc_lobes = 4;
+
+} // namespace
+
+ResampleChannel::ResampleChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		double samplerate,
+		ResampleInterpolation interpolation,
+		bool anti_alias,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	samplerate_(samplerate),
+	interval_(1. / samplerate),
+	interpolation_(interpolation),
+	anti_alias_(anti_alias),
+	kernel_radius_(0.),
+	cutoff_frequency_(0.),
+	grid_started_(false),
+	grid_start_timestamp_(0.),
+	grid_pos_(0),
+	window_pos_(0)
+{
+	assert(signal_);
+	assert(samplerate_ > 0);
+
+	total_digits_ = signal_->total_digits();
+	sr_digits_ = signal_->sr_digits();
+
+	if (anti_alias_ && interpolation_ != ResampleInterpolation::WindowedSinc)
+		kernel_radius_ = interval_ / 2;
+
+	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
+		this, &ResampleChannel::on_sample_appended, Qt::DirectConnection);
+}
+
+double ResampleChannel::samplerate() const
+{
+	return samplerate_;
+}
+
+ResampleInterpolation ResampleChannel::interpolation() const
+{
+	return interpolation_;
+}
+
+bool ResampleChannel::anti_alias() const
+{
+	return anti_alias_;
+}
+
+bool ResampleChannel::init_sinc_kernel()
+{
+	double input_samplerate = signal_->mean_samplerate();
+	if (input_samplerate <= 0)
+		return false;
+
+	cutoff_frequency_ = input_samplerate / 2;
+	if (anti_alias_ && samplerate_ < input_samplerate)
+		cutoff_frequency_ = samplerate_ / 2;
+	kernel_radius_ = sinc_lobes / (2 * cutoff_frequency_);
+
+	return true;
+}
+
+void ResampleChannel::process_samples()
+{
+	if (interpolation_ == ResampleInterpolation::WindowedSinc &&
+			cutoff_frequency_ <= 0 && !init_sinc_kernel())
+		return;
+
+	size_t count = signal_->sample_count();
+	if (count == 0)
+		return;
+
+	if (!grid_started_) {
+		grid_start_timestamp_ = signal_->get_sample(0, false).first;
+		grid_started_ = true;
+
+		auto resample_signal =
+			static_pointer_cast<data::AnalogTimeSignal>(actual_signal_);
+		if (resample_signal)
+			resample_signal->set_uniform_interval(interval_);
+	}
+
+	double last_timestamp = signal_->get_sample(count - 1, false).first;
+	while (true) {
+		// Calculate the grid timestamps from the start to avoid summing up
+		// rounding errors.
+		double timestamp = grid_start_timestamp_ + grid_pos_ * interval_;
+		// Wait until all samples for this grid point have arrived.
+		if (timestamp + kernel_radius_ > last_timestamp)
+			break;
+
+		window_pos_ = find_pos(timestamp - kernel_radius_, window_pos_);
+
+		bool ok = false;
+		double value = 0.;
+		if (interpolation_ == ResampleInterpolation::WindowedSinc)
+			value = windowed_sinc(timestamp, window_pos_, ok);
+		else if (anti_alias_)
+			value = box_average(timestamp, window_pos_, ok);
+		if (!ok)
+			value = interpolate(timestamp, find_pos(timestamp, window_pos_));
+
+		push_sample(value, timestamp);
+		++grid_pos_;
+	}
+}
+
+size_t ResampleChannel::find_pos(double timestamp, size_t start_pos) const
+{
+	size_t count = signal_->sample_count();
+	size_t pos = start_pos;
+	while (pos + 1 < count &&
+			signal_->get_sample(pos + 1, false).first <= timestamp)
+		++pos;
+	return pos;
+}
+
+double ResampleChannel::interpolate(double timestamp, size_t pos) const
+{
+	auto sample = signal_->get_sample(pos, false);
+	if (interpolation_ == ResampleInterpolation::ZeroOrderHold ||
+			sample.first >= timestamp || pos + 1 >= signal_->sample_count())
+		return sample.second;
+
+	auto next_sample = signal_->get_sample(pos + 1, false);
+	double factor =
+		(timestamp - sample.first) / (next_sample.first - sample.first);
+	return sample.second + (next_sample.second - sample.second) * factor;
+}
+
+double ResampleChannel::box_average(
+	double timestamp, size_t pos, bool &ok) const
+{
+	size_t count = signal_->sample_count();
+	double sum = 0.;
+	size_t sum_count = 0;
+	for (; pos < count; ++pos) {
+		auto sample = signal_->get_sample(pos, false);
+		if (sample.first <= timestamp - kernel_radius_)
+			continue;
+		if (sample.first > timestamp + kernel_radius_)
+			break;
+		sum += sample.second;
+		++sum_count;
+	}
+
+	ok = sum_count > 0;
+	return ok ? sum / sum_count : 0.;
+}
+
+double ResampleChannel::windowed_sinc(
+	double timestamp, size_t pos, bool &ok) const
+{
+	// Normalized sinc reconstruction with a Blackman window. The weights are
+	// normalized by their sum, so the DC gain stays 1 for irregularly
+	// sampled input signals.
+	size_t count = signal_->sample_count();
+	double sum = 0.;
+	double weight_sum = 0.;
+	for (; pos < count; ++pos) {
+		auto sample = signal_->get_sample(pos, false);
+		double dt = sample.first - timestamp;
+		if (dt <= -kernel_radius_)
+			continue;
+		if (dt >= kernel_radius_)
+			break;
+
+		double x = 2 * cutoff_frequency_ * dt;
+		double sinc = x == 0 ? 1. : std::sin(pi * x) / (pi * x);
+		double r = dt / kernel_radius_;
+		double window = 0.42 + 0.5 * std::cos(pi * r) + 0.08 * std::cos(2 * pi * r);
+		double weight = sinc * window;
+		sum += weight * sample.second;
+		weight_sum += weight;
+	}
+
+	ok = std::fabs(weight_sum) > 1e-9;
+	return ok ? sum / weight_sum : 0.;
+}
+
+} // namespace channels
+} // namespace sv
@@ -0,0 +1,124 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CHANNELS_RESAMPLECHANNEL_HPP
+#define CHANNELS_RESAMPLECHANNEL_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include <QObject>
+
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+enum class ResampleInterpolation {
+	ZeroOrderHold,
+	Linear,
+	WindowedSinc
+};
+
+/**
+ * Resample a (irregularly sampled) signal to a uniform time grid. The
+ * resulting signal is marked as uniformly sampled, so timestamp lookups
+ * are simple index calculations.
+ */
+class ResampleChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * Create a new resample channel.
+	 *
+	 * @param[in] samplerate The samplerate of the uniform time grid in Hz.
+	 * @param[in] interpolation The interpolation between the input samples.
+	 * @param[in] anti_alias Low pass filter the input signal to the Nyquist
+	 *                       frequency of the time grid. For zero-order hold
+	 *                       and linear interpolation this is the mean of all
+	 *                       samples within one grid interval.
+	 */
+	ResampleChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		double samplerate,
+		ResampleInterpolation interpolation,
+		bool anti_alias,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+	double samplerate() const;
+	ResampleInterpolation interpolation() const;
+	bool anti_alias() const;
+
+protected:
+	void process_samples() override;
+
+private:
+	/** Init the kernel for the windowed sinc interpolation. */
+	bool init_sinc_kernel();
+	/** Return the position of the last sample at or before the timestamp. */
+	size_t find_pos(double timestamp, size_t start_pos) const;
+	double interpolate(double timestamp, size_t pos) const;
+	double box_average(double timestamp, size_t pos, bool &ok) const;
+	double windowed_sinc(double timestamp, size_t pos, bool &ok) const;
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	const double samplerate_;
+	const double interval_;
+	const ResampleInterpolation interpolation_;
+	const bool anti_alias_;
+	/** The time span before and after a grid point, the filter looks at. */
+	double kernel_radius_;
+	/** The cutoff frequency of the windowed sinc kernel. */
+	double cutoff_frequency_;
+	bool grid_started_;
+	double grid_start_timestamp_;
+	size_t grid_pos_;
+	/** Position of the last sample before the actual filter window. */
+	size_t window_pos_;
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_RESAMPLECHANNEL_HPP
@@ -0,0 +1,329 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QDebug>
+
+#include "spectrumchannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/hardwarechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/fft.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::dynamic_pointer_cast;
+using std::lock_guard;
+using std::make_shared;
+using std::set;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace channels {
+
+SpectrumChannel::SpectrumChannel(
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t fft_size,
+		data::WindowFunction window_function,
+		SpectrumMode mode,
+		double overlap,
+		unsigned int average_count,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	MathChannel(data::Quantity::Frequency, set<data::QuantityFlag>(),
+		data::Unit::Hertz,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	fft_size_(fft_size),
+	window_function_(window_function),
+	mode_(mode),
+	overlap_(overlap),
+	hop_size_(std::max((size_t)1,
+		(size_t)std::lround((double)fft_size * (1. - overlap)))),
+	average_count_(std::max(1u, average_count)),
+	fft_(fft_size),
+	next_signal_pos_(0),
+	window_sum_(0.),
+	averaged_count_(0),
+	last_timestamp_(0.),
+	last_interval_(0.),
+	skip_frame_(false),
+	frame_sample_count_(0),
+	frame_length_(0),
+	device_frames_(false),
+	bin_width_(0.),
+	spectrum_count_(0)
+{
+	assert(signal_);
+	assert(overlap_ >= 0 && overlap_ < 1);
+
+	time_block_.reserve(fft_size_);
+	block_.reserve(fft_size_);
+	fft_in_.resize(fft_size_);
+	power_.resize(fft_.bin_count());
+	power_avg_.resize(fft_.bin_count());
+	spectrum_ = make_shared<const vector<double>>();
+
+	// Digits for the peak frequency
+	total_digits_ = 7;
+	sr_digits_ = 3;
+
+	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
+		this, &SpectrumChannel::on_sample_appended, Qt::DirectConnection);
+
+	auto hw_channel = dynamic_pointer_cast<HardwareChannel>(
+		signal_->parent_channel());
+	if (mode_ == SpectrumMode::Frames && hw_channel) {
+		connect(hw_channel.get(), &HardwareChannel::frame_ended,
+			this, &SpectrumChannel::on_frame_ended, Qt::DirectConnection);
+	}
+}
+
+shared_ptr<data::AnalogTimeSignal> SpectrumChannel::signal() const
+{
+	return signal_;
+}
+
+size_t SpectrumChannel::fft_size() const
+{
+	return fft_size_;
+}
+
+data::WindowFunction SpectrumChannel::window_function() const
+{
+	return window_function_;
+}
+
+SpectrumMode SpectrumChannel::mode() const
+{
+	return mode_;
+}
+
+double SpectrumChannel::overlap() const
+{
+	return overlap_;
+}
+
+unsigned int SpectrumChannel::average_count() const
+{
+	return average_count_;
+}
+
+shared_ptr<const vector<double>> SpectrumChannel::spectrum() const
+{
+	lock_guard<mutex> lock(spectrum_mutex_);
+	return spectrum_;
+}
+
+double SpectrumChannel::bin_width() const
+{
+	lock_guard<mutex> lock(spectrum_mutex_);
+	return bin_width_;
+}
+
+size_t SpectrumChannel::spectrum_count() const
+{
+	return spectrum_count_;
+}
+
+void SpectrumChannel::process_samples()
+{
+	if (mode_ == SpectrumMode::Frames) {
+		lock_guard<mutex> lock(frame_ends_mutex_);
+		if (!frame_ends_.empty()) {
+			device_frames_ = true;
+			next_frame_ends_.insert(next_frame_ends_.end(),
+				frame_ends_.begin(), frame_ends_.end());
+			frame_ends_.clear();
+		}
+	}
+	// The frame end could be signaled after all samples were processed.
+	if (pop_frame_end(next_signal_pos_))
+		end_frame();
+
+	size_t signal_sample_count = signal_->sample_count();
+	for (; next_signal_pos_ < signal_sample_count; ++next_signal_pos_) {
+		auto sample = signal_->get_sample(next_signal_pos_, false);
+
+		if (mode_ == SpectrumMode::Frames && frame_sample_count_ > 0) {
+			// Samples within a frame are equidistant, a new frame starts
+			// with a time gap (or a jump back in time).
+			double interval = sample.first - last_timestamp_;
+			if (interval <= 0 || (last_interval_ > 0 &&
+					std::fabs(interval - last_interval_) > last_interval_ / 2))
+				end_frame();
+			else
+				last_interval_ = interval;
+		}
+		last_timestamp_ = sample.first;
+		++frame_sample_count_;
+
+		if (!skip_frame_) {
+			time_block_.push_back(sample.first);
+			block_.push_back(sample.second);
+			if (block_.size() >= fft_size_) {
+				process_block();
+				if (mode_ == SpectrumMode::Frames) {
+					// Truncate the frame to the FFT size.
+					time_block_.clear();
+					block_.clear();
+					skip_frame_ = true;
+				}
+				else {
+					time_block_.erase(time_block_.begin(),
+						time_block_.begin() + (long)hop_size_);
+					block_.erase(block_.begin(),
+						block_.begin() + (long)hop_size_);
+				}
+			}
+			else if (mode_ == SpectrumMode::Frames && !device_frames_ &&
+					frame_sample_count_ == frame_length_) {
+				// The frame has the expected length, don't wait for the
+				// next frame to start.
+				process_block();
+				time_block_.clear();
+				block_.clear();
+				skip_frame_ = true;
+			}
+		}
+
+		if (pop_frame_end(next_signal_pos_ + 1))
+			end_frame();
+	}
+}
+
+bool SpectrumChannel::pop_frame_end(size_t pos)
+{
+	if (next_frame_ends_.empty() || next_frame_ends_.front() > pos)
+		return false;
+
+	auto it = std::upper_bound(
+		next_frame_ends_.begin(), next_frame_ends_.end(), pos);
+	next_frame_ends_.erase(next_frame_ends_.begin(), it);
+	return true;
+}
+
+void SpectrumChannel::end_frame()
+{
+	if (frame_sample_count_ == 0)
+		return;
+
+	if (!skip_frame_)
+		process_block();
+	time_block_.clear();
+	block_.clear();
+	frame_length_ = frame_sample_count_;
+	frame_sample_count_ = 0;
+	last_interval_ = 0.;
+	skip_frame_ = false;
+}
+
+void SpectrumChannel::on_frame_ended()
+{
+	{
+		lock_guard<mutex> lock(frame_ends_mutex_);
+		frame_ends_.push_back(signal_->sample_count());
+	}
+	on_sample_appended();
+}
+
+void SpectrumChannel::process_block()
+{
+	const size_t length = block_.size();
+	if (length < 2)
+		return;
+	const double interval =
+		(time_block_.back() - time_block_.front()) / (double)(length - 1);
+	if (interval <= 0)
+		return;
+
+	// The window only must be recalculated for frames of different length.
+	if (window_.size() != length) {
+		window_ = data::RealFft::window(window_function_, length);
+		window_sum_ = 0.;
+		for (const double w : window_)
+			window_sum_ += w;
+	}
+
+	for (size_t i=0; i<length; ++i)
+		fft_in_[i] = block_[i] * window_[i];
+	std::fill(fft_in_.begin() + (long)length, fft_in_.end(), 0.);
+
+	fft_.power_spectrum(fft_in_.data(), power_.data());
+
+	// Scale to the squared amplitude of a sine wave before averaging, so
+	// frames of different length can be averaged.
+	const size_t bin_count = power_.size();
+	const double scale = 4. / (window_sum_ * window_sum_);
+	if (averaged_count_ < average_count_)
+		++averaged_count_;
+	for (size_t k=0; k<bin_count; ++k) {
+		double power = power_[k] * scale;
+		if (k == 0 || k == bin_count-1)
+			power /= 4.;
+		power_avg_[k] += (power - power_avg_[k]) / averaged_count_;
+	}
+
+	auto spectrum = make_shared<vector<double>>(bin_count);
+	size_t peak_bin = 1;
+	for (size_t k=0; k<bin_count; ++k) {
+		(*spectrum)[k] = std::sqrt(power_avg_[k]);
+		if (k > 0 && power_avg_[k] > power_avg_[peak_bin])
+			peak_bin = k;
+	}
+
+	const double bin_width = 1. / (interval * (double)fft_size_);
+	{
+		lock_guard<mutex> lock(spectrum_mutex_);
+		spectrum_ = spectrum;
+		bin_width_ = bin_width;
+	}
+	++spectrum_count_;
+
+	// Interpolate the peak frequency with a parabola through the
+	// logarithmic power of the peak bin and its neighbours.
+	double peak_offset = 0.;
+	if (peak_bin > 1 && peak_bin < bin_count-1 &&
+			power_avg_[peak_bin-1] > 0 && power_avg_[peak_bin+1] > 0) {
+		const double a = std::log(power_avg_[peak_bin-1]);
+		const double b = std::log(power_avg_[peak_bin]);
+		const double c = std::log(power_avg_[peak_bin+1]);
+		const double denominator = a - 2*b + c;
+		if (denominator < 0)
+			peak_offset = 0.5 * (a - c) / denominator;
+	}
+	push_sample(((double)peak_bin + peak_offset) * bin_width,
+		time_block_.back());
+}
+
+} // namespace channels
+} // namespace sv
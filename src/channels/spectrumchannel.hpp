@@ -0,0 +1,176 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_SPECTRUMCHANNEL_HPP
+#define CHANNELS_SPECTRUMCHANNEL_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/mathchannel.hpp"
+#include "src/data/fft.hpp"
+
+using std::atomic;
+using std::mutex;
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+enum class SpectrumMode {
+	/** Transform blocks of fft_size samples, that overlap each other. */
+	Blocks,
+	/**
+	 * Transform every frame of the signal (e.g. an oscilloscope frame).
+	 * A frame is transformed when the device signals the frame end. For
+	 * signals without frame ends, a frame ends with a discontinuity of the
+	 * sample timestamps or when it reaches the length of the previous frame.
+	 * Frames are zero padded or truncated to fft_size samples.
+	 */
+	Frames
+};
+
+/**
+ * Calculate the amplitude spectrum of a signal with a windowed real FFT.
+ *
+ * The spectrum of the source signal is not stored in a signal, use
+ * spectrum() to get the latest (averaged) spectrum. The math signal of this
+ * channel contains the frequency of the strongest spectral line for every
+ * calculated spectrum.
+ */
+class SpectrumChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * Create a new spectrum channel.
+	 *
+	 * @param[in] fft_size The size of the FFT, must be a power of two.
+	 * @param[in] overlap The overlap of the blocks in Blocks mode, [0, 1).
+	 * @param[in] average_count The number of spectra that are averaged.
+	 *                          The averaging is linear until average_count
+	 *                          spectra are collected, then exponential.
+	 */
+	SpectrumChannel(
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t fft_size,
+		data::WindowFunction window_function,
+		SpectrumMode mode,
+		double overlap,
+		unsigned int average_count,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+	shared_ptr<data::AnalogTimeSignal> signal() const;
+	size_t fft_size() const;
+	data::WindowFunction window_function() const;
+	SpectrumMode mode() const;
+	double overlap() const;
+	unsigned int average_count() const;
+
+	/**
+	 * Return the latest amplitude spectrum. The bins are spaced by
+	 * bin_width(), starting with the DC bin. Empty as long as no spectrum
+	 * was calculated.
+	 */
+	shared_ptr<const vector<double>> spectrum() const;
+	double bin_width() const;
+	/** Return the number of calculated spectra. */
+	size_t spectrum_count() const;
+
+protected:
+	void process_samples() override;
+
+private Q_SLOTS:
+	/** Called from the acquisition thread at the end of a device frame. */
+	void on_frame_ended();
+
+private:
+	/** Transform the collected block and update the averaged spectrum. */
+	void process_block();
+	/** Transform the actual frame (Frames mode) and start a new one. */
+	void end_frame();
+	/**
+	 * Remove the device frame ends up to the signal position `pos`. Returns
+	 * true, if a frame end was removed.
+	 */
+	bool pop_frame_end(size_t pos);
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	const size_t fft_size_;
+	const data::WindowFunction window_function_;
+	const SpectrumMode mode_;
+	const double overlap_;
+	const size_t hop_size_;
+	const unsigned int average_count_;
+	data::RealFft fft_;
+	size_t next_signal_pos_;
+	vector<double> time_block_;
+	vector<double> block_;
+	vector<double> window_;
+	double window_sum_;
+	vector<double> fft_in_;
+	vector<double> power_;
+	vector<double> power_avg_;
+	unsigned int averaged_count_;
+	double last_timestamp_;
+	double last_interval_;
+	bool skip_frame_;
+	/** The number of samples of the actual frame, including skipped ones. */
+	size_t frame_sample_count_;
+	/** The length of the last frame, 0 if unknown. */
+	size_t frame_length_;
+	/** The signal positions of the frame ends signaled by the device. */
+	vector<size_t> frame_ends_;
+	mutex frame_ends_mutex_;
+	/** The frame ends, that are not yet processed. Only used by the worker. */
+	vector<size_t> next_frame_ends_;
+	bool device_frames_;
+	mutable mutex spectrum_mutex_;
+	shared_ptr<const vector<double>> spectrum_;
+	double bin_width_;
+	atomic<size_t> spectrum_count_;
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_SPECTRUMCHANNEL_HPP
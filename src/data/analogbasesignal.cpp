@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cassert>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -31,8 +32,11 @@
 #include "src/channels/basechannel.hpp"
 #include "src/data/basesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/signalstatistics.hpp"
 
+using std::lock_guard;
 using std::make_shared;
+using std::make_unique;
 using std::set;
 using std::shared_ptr;
 using std::string;
@@ -53,7 +57,10 @@ AnalogBaseSignal::AnalogBaseSignal(
 	sr_digits_(data::DefaultSRDigits),
 	last_value_(0.),
 	min_value_(std::numeric_limits<double>::max()),
-	max_value_(std::numeric_limits<double>::lowest())
+	max_value_(std::numeric_limits<double>::lowest()),
+	generation_(0),
+	statistics_enabled_(false),
+	statistics_pos_(0)
 {
 	qWarning() << "Init analog base signal " << display_name();
 	data_ = make_shared<vector<double>>();
@@ -67,6 +74,61 @@ size_t AnalogBaseSignal::sample_count() const
 	return sample_count;
 }
 
+void AnalogBaseSignal::set_statistics_enabled(bool enabled)
+{
+	lock_guard<mutex> lock(statistics_mutex_);
+	if (enabled == statistics_enabled_)
+		return;
+
+	if (!enabled) {
+		statistics_enabled_ = false;
+		statistics_.reset();
+		return;
+	}
+
+	// Add the already captured samples. Samples that are appended in the
+	// meantime are added by the next update_statistics() call.
+	statistics_ = make_unique<SignalStatistics>();
+	const size_t sample_count = sample_count_;
+	for (statistics_pos_=0; statistics_pos_<sample_count; ++statistics_pos_)
+		statistics_->add((*data_)[statistics_pos_]);
+	statistics_enabled_ = true;
+}
+
+bool AnalogBaseSignal::is_statistics_enabled() const
+{
+	return statistics_enabled_;
+}
+
+SignalStatistics AnalogBaseSignal::statistics() const
+{
+	lock_guard<mutex> lock(statistics_mutex_);
+	if (!statistics_)
+		return SignalStatistics();
+	return *statistics_;
+}
+
+void AnalogBaseSignal::update_statistics()
+{
+	if (!statistics_enabled_)
+		return;
+
+	lock_guard<mutex> lock(statistics_mutex_);
+	if (!statistics_)
+		return;
+	const size_t sample_count = sample_count_;
+	for (; statistics_pos_ < sample_count; ++statistics_pos_)
+		statistics_->add((*data_)[statistics_pos_]);
+}
+
+void AnalogBaseSignal::clear_statistics()
+{
+	lock_guard<mutex> lock(statistics_mutex_);
+	if (statistics_)
+		statistics_->clear();
+	statistics_pos_ = 0;
+}
+
 /*
 analog_time_sample_t AnalogSignal::get_sample(
 	size_t pos, bool relative_time) const
@@ -213,6 +275,11 @@ double AnalogBaseSignal::max_value() const
 	return max_value_;
 }
 
+size_t AnalogBaseSignal::generation() const
+{
+	return generation_;
+}
+
 /*
 void AnalogSignal::combine_signals(
 	shared_ptr<AnalogSignal> signal1, size_t &signal1_pos,
@@ -20,7 +20,9 @@
 #ifndef DATA_ANALOGBASESIGNAL_HPP
 #define DATA_ANALOGBASESIGNAL_HPP
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -30,10 +32,14 @@
 
 #include "src/data/basesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/signalstatistics.hpp"
 
+using std::atomic;
+using std::mutex;
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::unique_ptr;
 using std::vector;
 
 namespace sv {
@@ -98,6 +104,26 @@ public:
 	double min_value() const;
 	double max_value() const;
 
+	/**
+	 * Return the generation of the signal data. The generation is increased,
+	 * every time samples are appended or the signal is cleared. Views can
+	 * compare it with the last seen generation to skip unchanged signals.
+	 */
+	size_t generation() const;
+
+	/**
+	 * Enable or disable the incremental statistics (histogram and quantiles)
+	 * of this signal. When enabled, the already captured samples are added
+	 * once, after that the statistics are updated when samples are appended.
+	 */
+	void set_statistics_enabled(bool enabled);
+	bool is_statistics_enabled() const;
+	/**
+	 * Return a copy of the actual statistics. The statistics are empty, if
+	 * they are not enabled.
+	 */
+	SignalStatistics statistics() const;
+
 	/*
 	static void combine_signals(
 		shared_ptr<AnalogSignal> signal1, size_t &signal1_pos,
@@ -115,6 +141,16 @@ protected:
 	double last_value_;
 	double min_value_;
 	double max_value_;
+	atomic<size_t> generation_;
+
+	/** Add the samples, that were appended since the last call. */
+	void update_statistics();
+	void clear_statistics();
+
+	atomic<bool> statistics_enabled_;
+	unique_ptr<SignalStatistics> statistics_;
+	size_t statistics_pos_;
+	mutable mutex statistics_mutex_;
 
 	static const size_t size_of_float_ = sizeof(float);
 	static const size_t size_of_double_ = sizeof(double);
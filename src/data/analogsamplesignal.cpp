@@ -61,6 +61,8 @@ void AnalogSampleSignal::clear()
 	pos_->clear();
 	data_->clear();
 	sample_count_ = 0;
+	clear_statistics();
+	++generation_;
 
 	Q_EMIT samples_cleared();
 }
@@ -124,6 +126,8 @@ void AnalogSampleSignal::push_sample(void *sample, uint32_t pos,
 	pos_->push_back(pos);
 	data_->push_back(dsample);
 	sample_count_++;
+	update_statistics();
+	++generation_;
 	Q_EMIT sample_appended();
 
 	bool digits_chngd = false;
@@ -19,7 +19,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -32,6 +34,7 @@
 #include "src/data/basesignal.hpp"
 #include "src/data/datautil.hpp"
 
+using std::lock_guard;
 using std::make_pair;
 using std::make_shared;
 using std::set;
@@ -51,7 +54,8 @@ AnalogTimeSignal::AnalogTimeSignal(
 		const string &custom_name) :
 	AnalogBaseSignal(quantity, quantity_flags, unit, parent_channel, custom_name),
 	signal_start_timestamp_(signal_start_timestamp),
-	last_timestamp_(0.)
+	last_timestamp_(0.),
+	uniform_interval_(0.)
 {
 	qWarning() << "Init analog time signal " << display_name()
 		<< ", signal_start_timestamp_ = "
@@ -66,6 +70,12 @@ void AnalogTimeSignal::clear()
 	time_->clear();
 	data_->clear();
 	sample_count_ = 0;
+	clear_statistics();
+	++generation_;
+	{
+		lock_guard<mutex> lock(min_max_mutex_);
+		min_max_pyramid_.clear();
+	}
 
 	Q_EMIT samples_cleared();
 }
@@ -103,32 +113,100 @@ analog_time_sample_t AnalogTimeSignal::get_last_sample(bool relative_time) const
 	return make_pair(timestamp, data_->at(pos));
 }
 
+size_t AnalogTimeSignal::get_lower_pos(
+	double timestamp, bool relative_time) const
+{
+	if (sample_count_ == 0)
+		return 0;
+
+	if (relative_time)
+		timestamp += signal_start_timestamp_;
+	if (timestamp <= time_->front())
+		return 0;
+	if (timestamp > last_timestamp_)
+		return sample_count_;
+
+	if (uniform_interval_ > 0) {
+		size_t pos = std::min(sample_count_ - 1, static_cast<size_t>(
+			std::ceil((timestamp - time_->front()) / uniform_interval_)));
+		// Correct rounding errors of the calculated position
+		while (pos > 0 && (*time_)[pos-1] >= timestamp)
+			--pos;
+		while (pos < sample_count_ && (*time_)[pos] < timestamp)
+			++pos;
+		return pos;
+	}
+
+	auto end = time_->begin() + sample_count_;
+	return std::lower_bound(time_->begin(), end, timestamp) - time_->begin();
+}
+
+bool AnalogTimeSignal::get_min_max(double start_timestamp,
+	double end_timestamp, bool relative_time, double &min, double &max) const
+{
+	size_t from = get_lower_pos(start_timestamp, relative_time);
+	size_t to = get_lower_pos(end_timestamp, relative_time);
+	// Include a sample exactly at the end timestamp.
+	if (to < sample_count_ && get_sample(to, relative_time).first <= end_timestamp)
+		++to;
+	if (from >= to)
+		return false;
+
+	return get_min_max(from, to - 1, min, max);
+}
+
+bool AnalogTimeSignal::get_min_max(size_t from, size_t to,
+	double &min, double &max) const
+{
+	lock_guard<mutex> lock(min_max_mutex_);
+	return min_max_pyramid_.min_max(*data_, from, to, min, max);
+}
+
 bool AnalogTimeSignal::get_value_at_timestamp(
 	double timestamp, double &value, bool relative_time) const
 {
 	if (time_->empty())
 		return false;
-	if (timestamp < time_->at(0))
-		return false;
-	if (timestamp > time_->back())
-		return false;
 
 	if (relative_time)
 		timestamp += signal_start_timestamp_;
 
-	auto lower = std::lower_bound(time_->begin(), time_->end(), timestamp);
+	if (timestamp < time_->front())
+		return false;
+	if (timestamp > time_->back())
+		return false;
 
-	// Check if timestamp and found timestamp match
-	if (timestamp == *lower) {
-		value = *lower;
-		return true;
+	size_t lower_pos;
+	if (uniform_interval_ > 0) {
+		// Uniformly sampled signal: The position is calculated directly.
+		const size_t last_pos = time_->size() - 1;
+		lower_pos = std::min(last_pos, static_cast<size_t>(
+			(timestamp - time_->front()) / uniform_interval_));
+		// Correct rounding errors of the calculated position, so that
+		// time[lower_pos] <= timestamp < time[lower_pos+1]
+		while (lower_pos > 0 && (*time_)[lower_pos] > timestamp)
+			--lower_pos;
+		while (lower_pos < last_pos && (*time_)[lower_pos+1] <= timestamp)
+			++lower_pos;
+		if (timestamp == (*time_)[lower_pos] || lower_pos == last_pos) {
+			value = (*data_)[lower_pos];
+			return true;
+		}
 	}
+	else {
+		auto lower = std::lower_bound(time_->begin(), time_->end(), timestamp);
+		lower_pos = lower - time_->begin();
+
+		// Check if timestamp and found timestamp match
+		if (timestamp == *lower) {
+			value = data_->at(lower_pos);
+			return true;
+		}
 
-	size_t lower_pos = lower - time_->begin();
-
-	// Get the previous timestamp for linear interpolation
-	if (lower_pos > 0)
-		--lower_pos;
+		// Get the previous timestamp for linear interpolation
+		if (lower_pos > 0)
+			--lower_pos;
+	}
 
 	double lower_ts = time_->at(lower_pos);
 	double lower_data = data_->at(lower_pos);
@@ -187,6 +265,12 @@ void AnalogTimeSignal::push_sample(void *sample, double timestamp,
 	time_->push_back(timestamp);
 	data_->push_back(dsample);
 	sample_count_++;
+	{
+		lock_guard<mutex> lock(min_max_mutex_);
+		min_max_pyramid_.update(*data_, sample_count_);
+	}
+	update_statistics();
+	++generation_;
 	Q_EMIT sample_appended();
 
 	bool digits_chngd = false;
@@ -258,6 +342,12 @@ void AnalogTimeSignal::push_samples(void *data,
 
 	last_timestamp_ = timestamp - time_stride;
 	last_value_ = dsample;
+	{
+		lock_guard<mutex> lock(min_max_mutex_);
+		min_max_pyramid_.update(*data_, sample_count_);
+	}
+	update_statistics();
+	++generation_;
 	Q_EMIT sample_appended();
 
 	bool digits_chngd = false;
@@ -300,91 +390,32 @@ double AnalogTimeSignal::last_timestamp(bool relative_time) const
 		return last_timestamp_;
 }
 
-void AnalogTimeSignal::on_channel_start_timestamp_changed(double timestamp)
+double AnalogTimeSignal::mean_samplerate() const
 {
-	signal_start_timestamp_ = timestamp;
-	Q_EMIT signal_start_timestamp_changed(timestamp);
+	if (sample_count_ < 2)
+		return 0.;
+
+	double time_span = last_timestamp_ - time_->front();
+	if (time_span <= 0)
+		return 0.;
+
+	return (double)(sample_count_ - 1) / time_span;
 }
 
-void AnalogTimeSignal::combine_signals(
-	shared_ptr<AnalogTimeSignal> signal1, size_t &signal1_pos,
-	shared_ptr<AnalogTimeSignal> signal2, size_t &signal2_pos,
-	shared_ptr<vector<double>> time_vector,
-	shared_ptr<vector<double>> data1_vector,
-	shared_ptr<vector<double>> data2_vector)
+void AnalogTimeSignal::set_uniform_interval(double interval)
 {
-	if (signal1 == nullptr || signal1->sample_count() == 0)
-		return;
-	if (signal2 == nullptr || signal2->sample_count() == 0)
-		return;
-
-	// Ignore the first sample(s)
-	if (signal1_pos == 0 || signal2_pos == 0) {
-		if (signal1->sample_count() <= signal1_pos ||
-				signal2->sample_count() <= signal2_pos)
-			return;
-
-		double signal1_ts = signal1->get_sample(signal1_pos, false).first;
-		double signal2_ts = signal2->get_sample(signal2_pos, false).first;
-		if (signal1_ts < signal2_ts) {
-			while (signal1_ts < signal2_ts &&
-					signal1->sample_count() > signal1_pos+1)
-				signal1_ts = signal1->get_sample(++signal1_pos, false).first;
-		}
-		else if (signal1_ts > signal2_ts) {
-			while (signal1_ts > signal2_ts &&
-					signal2->sample_count() > signal2_pos+1)
-				signal2_ts = signal2->get_sample(++signal2_pos, false).first;
-		}
-	}
+	uniform_interval_ = interval;
+}
 
-	while (true) {
-		if (signal1->sample_count() <= signal1_pos ||
-				signal2->sample_count() <= signal2_pos)
-			break;
-
-		double time;
-		double value1;
-		double value2;
-
-		auto signal1_sample = signal1->get_sample(signal1_pos, false);
-		auto signal1_ts = signal1_sample.first;
-		auto signal2_sample = signal2->get_sample(signal2_pos, false);
-		auto signal2_ts = signal2_sample.first;
-
-		if (signal1_ts == signal2_ts) {
-			time = signal1_ts;
-			value1 = signal1_sample.second;
-			value2 = signal2_sample.second;
-			++signal1_pos;
-			++signal2_pos;
-		}
-		else if (signal1_ts < signal2_ts &&
-			signal2->sample_count() > signal2_pos) {
-
-			time = signal1_ts;
-			if (!signal2->get_value_at_timestamp(time, value2, false))
-				return;
-			value1 = signal1_sample.second;
-			++signal1_pos;
-		}
-		else if (signal1_ts > signal2_ts &&
-			signal1->sample_count() > signal1_pos) {
-
-			time = signal2_ts;
-			if (!signal1->get_value_at_timestamp(time, value1, false))
-				return;
-			value2 = signal2_sample.second;
-			++signal2_pos;
-		}
-		else {
-			return;
-		}
+double AnalogTimeSignal::uniform_interval() const
+{
+	return uniform_interval_;
+}
 
-		time_vector->push_back(time);
-		data1_vector->push_back(value1);
-		data2_vector->push_back(value2);
-	}
+void AnalogTimeSignal::on_channel_start_timestamp_changed(double timestamp)
+{
+	signal_start_timestamp_ = timestamp;
+	Q_EMIT signal_start_timestamp_changed(timestamp);
 }
 
 } // namespace data
@@ -21,6 +21,7 @@
 #define DATA_ANALOGTIMESIGNAL_HPP
 
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -30,7 +31,9 @@
 
 #include "src/data/analogbasesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/minmaxpyramid.hpp"
 
+using std::mutex;
 using std::pair;
 using std::set;
 using std::shared_ptr;
@@ -70,6 +73,13 @@ public:
 	 */
 	analog_time_sample_t get_last_sample(bool relative_time) const;
 
+	/**
+	 * Return the position of the first sample with a timestamp not less than
+	 * the given timestamp, or sample_count() if all samples are older.
+	 * Uniformly sampled signals are not searched, the position is calculated.
+	 */
+	size_t get_lower_pos(double timestamp, bool relative_time) const;
+
 	/**
 	 * Return the value at the given timestamp in &value. If there is no
 	 * exactty matching timestamp, the value is linearly interpolated. No
@@ -86,6 +96,20 @@ public:
 	bool get_value_at_timestamp(
 		double timestamp, double &value, bool relative_time) const;
 
+	/**
+	 * Get the minimum and maximum value of all samples between the start and
+	 * the end timestamp in O(log n). Returns false, if there are no samples
+	 * in the time range.
+	 */
+	bool get_min_max(double start_timestamp, double end_timestamp,
+		bool relative_time, double &min, double &max) const;
+
+	/**
+	 * Get the minimum and maximum value of the samples [from..to] in
+	 * O(log n). Returns false, if there is no finite value in the range.
+	 */
+	bool get_min_max(size_t from, size_t to, double &min, double &max) const;
+
 	/**
 	 * Push a single sample to the signal.
 	 *
@@ -105,34 +129,34 @@ public:
 	double last_timestamp(bool relative_time) const;
 
 	/**
-	 * Combine two signals with each other.
-	 *
-	 * E.g.:
-	 * | Time | S1 | S2 | combined S1 | combined S2 |
-	 * |------|----|----|-------------|-------------|
-	 * |    1 |  1 |    |             |             |
-	 * |    3 |  2 |    |             |             |
-	 * |    5 |  3 |    |             |             |
-	 * |    6 |    | 10 |         3.5 |          10 |
-	 * |    7 |  4 |    |           4 |         9.5 |
-	 * |    8 |    |  9 |         4.5 |           9 |
-	 * |    9 |  5 |    |           5 |         8.5 |
-	 * |   10 |    |  8 |             |             |
-	 * |   12 |    |  7 |             |             |
+	 * Return the mean samplerate of the signal, calculated from the first
+	 * and the last timestamp. Returns 0 if there are not enough samples.
+	 */
+	double mean_samplerate() const;
+
+	/**
+	 * Mark the signal as uniformly sampled, with a fixed time interval
+	 * between all samples. The position of a timestamp is then calculated
+	 * directly, instead of searching the time vector.
 	 *
-	 * TODO: Use std::deque<double>& instead of shared_ptr<vector<double>>?
+	 * @param interval The time between two samples in seconds or 0 if the
+	 *                 signal is not uniformly sampled.
+	 */
+	void set_uniform_interval(double interval);
+
+	/**
+	 * Return the time between two samples of a uniformly sampled signal or 0,
+	 * if the signal is not uniformly sampled.
 	 */
-	static void combine_signals(
-		shared_ptr<AnalogTimeSignal> signal1, size_t &signal1_pos,
-		shared_ptr<AnalogTimeSignal> signal2, size_t &signal2_pos,
-		shared_ptr<vector<double>> time_vector,
-		shared_ptr<vector<double>> data1_vector,
-		shared_ptr<vector<double>> data2_vector);
+	double uniform_interval() const;
 
 private:
 	shared_ptr<vector<double>> time_;
 	double signal_start_timestamp_;
 	double last_timestamp_;
+	double uniform_interval_;
+	MinMaxPyramid min_max_pyramid_;
+	mutable mutex min_max_mutex_;
 
 public Q_SLOTS:
 	void on_channel_start_timestamp_changed(double timestamp);
@@ -0,0 +1,171 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include "fft.hpp"
+
+using std::complex;
+using std::conj;
+using std::norm;
+using std::polar;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+namespace {
+
+const double pi = std::acos(-1);
+
+} // namespace
+
+RealFft::RealFft(size_t size) :
+	size_(size)
+{
+	if (size_ < 4 || !is_power_of_two(size_))
+		throw std::invalid_argument("RealFft: Size must be a power of two!");
+
+	const size_t half_size = size_ / 2;
+
+	twiddles_.reserve(half_size);
+	for (size_t k=0; k<half_size; ++k)
+		twiddles_.push_back(polar(1., -2 * pi * (double)k / (double)size_));
+
+	size_t bits = 0;
+	while (((size_t)1 << bits) < half_size)
+		++bits;
+	bit_reverse_.resize(half_size);
+	for (size_t i=0; i<half_size; ++i) {
+		size_t r = 0;
+		for (size_t b=0; b<bits; ++b) {
+			if (i & ((size_t)1 << b))
+				r |= (size_t)1 << (bits - 1 - b);
+		}
+		bit_reverse_[i] = r;
+	}
+
+	buffer_.resize(half_size);
+}
+
+size_t RealFft::size() const
+{
+	return size_;
+}
+
+size_t RealFft::bin_count() const
+{
+	return size_ / 2 + 1;
+}
+
+void RealFft::power_spectrum(const double *in, double *out)
+{
+	const size_t half_size = size_ / 2;
+
+	// Pack the even samples into the real part and the odd samples into the
+	// imaginary part. The bit reversal is done while packing.
+	for (size_t i=0; i<half_size; ++i)
+		buffer_[bit_reverse_[i]] = complex<double>(in[2*i], in[2*i + 1]);
+
+	transform();
+
+	// Split the spectrum of the packed signal into the spectra of the even
+	// and odd samples and combine them to the spectrum of the real signal.
+	const complex<double> z0 = buffer_[0];
+	out[0] = (z0.real() + z0.imag()) * (z0.real() + z0.imag());
+	out[half_size] = (z0.real() - z0.imag()) * (z0.real() - z0.imag());
+	for (size_t k=1; k<half_size; ++k) {
+		const complex<double> z_k = buffer_[k];
+		const complex<double> z_mk = conj(buffer_[half_size - k]);
+		const complex<double> even = (z_k + z_mk) * 0.5;
+		const complex<double> odd =
+			(z_k - z_mk) * complex<double>(0., -0.5);
+		out[k] = norm(even + twiddles_[k] * odd);
+	}
+}
+
+void RealFft::transform()
+{
+	// Iterative radix-2 decimation in time on the bit reversed buffer. The
+	// twiddles for a butterfly span of len are every (size/len)th entry of
+	// the twiddle table.
+	const size_t half_size = size_ / 2;
+	for (size_t len=2; len<=half_size; len <<= 1) {
+		const size_t half_len = len / 2;
+		const size_t step = size_ / len;
+		for (size_t i=0; i<half_size; i+=len) {
+			complex<double> *a = &buffer_[i];
+			complex<double> *b = &buffer_[i + half_len];
+			for (size_t j=0; j<half_len; ++j) {
+				const complex<double> t = b[j] * twiddles_[j * step];
+				b[j] = a[j] - t;
+				a[j] += t;
+			}
+		}
+	}
+}
+
+bool RealFft::is_power_of_two(size_t size)
+{
+	return size > 0 && (size & (size - 1)) == 0;
+}
+
+vector<double> RealFft::window(WindowFunction window_function, size_t length)
+{
+	vector<double> coefficients(length, 1.);
+	if (length < 2)
+		return coefficients;
+
+	// Generalized cosine windows: w[n] = sum_k (-1)^k * a_k * cos(2*pi*k*n/N)
+	vector<double> a;
+	switch (window_function) {
+	case WindowFunction::Hann:
+		a = { 0.5, 0.5 };
+		break;
+	case WindowFunction::Blackman:
+		a = { 0.42, 0.5, 0.08 };
+		break;
+	case WindowFunction::FlatTop:
+		a = { 0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368 };
+		break;
+	case WindowFunction::Rectangular:
+	default:
+		return coefficients;
+	}
+
+	for (size_t n=0; n<length; ++n) {
+		const double phi = 2 * pi * (double)n / (double)length;
+		double w = 0.;
+		double sign = 1.;
+		for (size_t k=0; k<a.size(); ++k) {
+			w += sign * a[k] * std::cos((double)k * phi);
+			sign = -sign;
+		}
+		coefficients[n] = w;
+	}
+
+	return coefficients;
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_FFT_HPP
+#define DATA_FFT_HPP
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+using std::complex;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+enum class WindowFunction {
+	Rectangular,
+	Hann,
+	Blackman,
+	FlatTop
+};
+
+/**
+ * A radix-2 FFT for real input data.
+ *
+ * The real input of size N is packed into N/2 complex values, transformed
+ * with an in-place complex FFT and then split into the N/2+1 bins of the
+ * real spectrum. The twiddle factors and the bit reversal table are computed
+ * once in the ctor, so transforming a block doesn't allocate any memory.
+ */
+class RealFft
+{
+
+public:
+	/**
+	 * Create a new FFT.
+	 *
+	 * @param[in] size The number of real input samples. Must be a power of
+	 *                 two and at least 4.
+	 */
+	explicit RealFft(size_t size);
+
+	size_t size() const;
+
+	/** Return the number of bins of the spectrum (size/2 + 1). */
+	size_t bin_count() const;
+
+	/**
+	 * Transform size() real samples and write the squared magnitudes
+	 * |X[k]|^2 of the bin_count() bins to out.
+	 */
+	void power_spectrum(const double *in, double *out);
+
+	/** Return true if size is a power of two. */
+	static bool is_power_of_two(size_t size);
+
+	/**
+	 * Return the coefficients of a periodic window function with the given
+	 * length.
+	 */
+	static vector<double> window(WindowFunction window_function,
+		size_t length);
+
+private:
+	void transform();
+
+	const size_t size_;
+	/** exp(-2*pi*i*k/size) for k in [0, size/2). */
+	vector<complex<double>> twiddles_;
+	vector<size_t> bit_reverse_;
+	vector<complex<double>> buffer_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_FFT_HPP
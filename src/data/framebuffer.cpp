@@ -0,0 +1,243 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "framebuffer.hpp"
+
+using std::lock_guard;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+FrameBuffer::FrameBuffer(size_t frame_count) :
+	frames_(frame_count > 0 ? frame_count : 1),
+	next_frame_(0),
+	stored_frames_(0),
+	in_frame_(false),
+	samplerate_(0),
+	generation_(0),
+	peak_generation_(std::numeric_limits<size_t>::max())
+{
+	for (auto &frame : frames_)
+		frame.size = 0;
+}
+
+void FrameBuffer::set_frame_count(size_t frame_count)
+{
+	lock_guard<mutex> lock(mutex_);
+	frames_.resize(frame_count > 0 ? frame_count : 1);
+	reset();
+}
+
+size_t FrameBuffer::frame_count() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return frames_.size();
+}
+
+void FrameBuffer::clear()
+{
+	lock_guard<mutex> lock(mutex_);
+	reset();
+}
+
+void FrameBuffer::begin_frame()
+{
+	lock_guard<mutex> lock(mutex_);
+	// The slot is removed from the stored frames while it is overwritten.
+	if (!in_frame_ && stored_frames_ == frames_.size()) {
+		--stored_frames_;
+		accumulate(frames_[next_frame_], -1.);
+	}
+	frames_[next_frame_].size = 0;
+	in_frame_ = true;
+}
+
+void FrameBuffer::append(const float *data, size_t count, uint64_t samplerate)
+{
+	lock_guard<mutex> lock(mutex_);
+	if (!in_frame_)
+		return;
+
+	Frame &frame = frames_[next_frame_];
+	if (frame.data.size() < frame.size + count)
+		frame.data.resize(frame.size + count);
+	std::copy(data, data + count, frame.data.begin() + frame.size);
+	frame.size += count;
+	samplerate_ = samplerate;
+}
+
+void FrameBuffer::end_frame()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		if (!in_frame_)
+			return;
+		in_frame_ = false;
+		if (frames_[next_frame_].size == 0)
+			return;
+
+		accumulate(frames_[next_frame_], 1.);
+		next_frame_ = (next_frame_ + 1) % frames_.size();
+		stored_frames_ = std::min(stored_frames_ + 1, frames_.size());
+
+		// Rebuild the sums once per round through the ring, so rounding
+		// errors and non finite values don't accumulate. This is still
+		// O(samples) per frame.
+		if (next_frame_ == 0) {
+			std::fill(sum_.begin(), sum_.end(), 0.);
+			std::fill(count_.begin(), count_.end(), 0.);
+			for (const auto &frame : frames_)
+				accumulate(frame, 1.);
+		}
+	}
+	++generation_;
+}
+
+bool FrameBuffer::in_frame() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return in_frame_;
+}
+
+size_t FrameBuffer::stored_frames() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return stored_frames_;
+}
+
+size_t FrameBuffer::generation() const
+{
+	return generation_;
+}
+
+uint64_t FrameBuffer::samplerate() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return samplerate_;
+}
+
+bool FrameBuffer::frame(size_t age, vector<float> &data) const
+{
+	lock_guard<mutex> lock(mutex_);
+	if (age >= stored_frames_)
+		return false;
+
+	const size_t slot = (next_frame_ + frames_.size() - 1 - age) % frames_.size();
+	const Frame &frame = frames_[slot];
+	data.assign(frame.data.begin(), frame.data.begin() + frame.size);
+	return true;
+}
+
+bool FrameBuffer::average(vector<float> &data) const
+{
+	lock_guard<mutex> lock(mutex_);
+	if (stored_frames_ == 0)
+		return false;
+
+	// The average has the length of the newest frame. Older frames with
+	// another length are only used for the overlapping samples.
+	const size_t size = frames_[newest_slot()].size;
+	data.resize(size);
+	float *average = data.data();
+	const double *sum = sum_.data();
+	const double *count = count_.data();
+	for (size_t i = 0; i < size; ++i)
+		average[i] = (float)(sum[i] / count[i]);
+	return true;
+}
+
+bool FrameBuffer::peak(vector<float> &min, vector<float> &max) const
+{
+	lock_guard<mutex> lock(mutex_);
+	if (stored_frames_ == 0)
+		return false;
+
+	const size_t generation = generation_;
+	if (generation != peak_generation_) {
+		peak_generation_ = generation;
+
+		// The envelope has the length of the newest frame, like the average.
+		const Frame &newest = frames_[newest_slot()];
+		const size_t size = newest.size;
+		min_.assign(newest.data.begin(), newest.data.begin() + size);
+		max_.assign(newest.data.begin(), newest.data.begin() + size);
+		float *min_data = min_.data();
+		float *max_data = max_.data();
+		for (size_t age = 1; age < stored_frames_; ++age) {
+			const size_t slot =
+				(next_frame_ + frames_.size() - 1 - age) % frames_.size();
+			const float *data = frames_[slot].data.data();
+			const size_t n = std::min(frames_[slot].size, size);
+			// Simple loops over the arrays, that can be vectorized.
+			for (size_t i = 0; i < n; ++i) {
+				min_data[i] = data[i] < min_data[i] ? data[i] : min_data[i];
+				max_data[i] = data[i] > max_data[i] ? data[i] : max_data[i];
+			}
+		}
+	}
+
+	min = min_;
+	max = max_;
+	return true;
+}
+
+void FrameBuffer::reset()
+{
+	for (auto &frame : frames_)
+		frame.size = 0;
+	next_frame_ = 0;
+	stored_frames_ = 0;
+	in_frame_ = false;
+	sum_.clear();
+	count_.clear();
+	++generation_;
+}
+
+void FrameBuffer::accumulate(const Frame &frame, double sign)
+{
+	// Only grow, so the vectors keep their memory.
+	const size_t size = frame.size;
+	if (sum_.size() < size) {
+		sum_.resize(size, 0.);
+		count_.resize(size, 0.);
+	}
+
+	const float *data = frame.data.data();
+	double *sum = sum_.data();
+	double *count = count_.data();
+	for (size_t i = 0; i < size; ++i) {
+		sum[i] += sign * data[i];
+		count[i] += sign;
+	}
+}
+
+size_t FrameBuffer::newest_slot() const
+{
+	return (next_frame_ + frames_.size() - 1) % frames_.size();
+}
+
+} // namespace data
+} // namespace sv
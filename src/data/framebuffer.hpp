@@ -0,0 +1,129 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_FRAMEBUFFER_HPP
+#define DATA_FRAMEBUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+using std::atomic;
+using std::mutex;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * A ring buffer for the last frames of an oscilloscope channel. Every frame
+ * is stored as separate waveform, the samples of all frames are index
+ * aligned (sample i of every frame has the same time offset to the trigger).
+ *
+ * The memory of the oldest frame is reused for a new frame, so the buffer
+ * only grows up to the frame count times the longest frame.
+ *
+ * The sums for the average are updated incrementally: A completed frame is
+ * added and the overwritten frame is subtracted. The min/max envelope (peak
+ * detect) is calculated when it is read. The accumulation loops run over
+ * contiguous arrays, so they are vectorized by the compiler.
+ *
+ * Frames are written by the acquisition thread and read by the GUI thread,
+ * all getters copy the data.
+ */
+class FrameBuffer
+{
+
+public:
+	explicit FrameBuffer(size_t frame_count = 16);
+
+	/** Set the number of stored frames. This clears the buffer. */
+	void set_frame_count(size_t frame_count);
+	size_t frame_count() const;
+	void clear();
+
+	/** Start a new frame, overwriting the oldest one if the ring is full. */
+	void begin_frame();
+	/** Append samples to the actual frame. */
+	void append(const float *data, size_t count, uint64_t samplerate);
+	/** Complete the actual frame and update the statistics. */
+	void end_frame();
+	bool in_frame() const;
+
+	/** Return the number of completed frames in the buffer. */
+	size_t stored_frames() const;
+	/** Return a number that is incremented with every completed frame. */
+	size_t generation() const;
+	/** Return the samplerate of the last frame or 0 if unknown. */
+	uint64_t samplerate() const;
+
+	/**
+	 * Copy the completed frame with the given age (0 = newest frame).
+	 * Returns false, if there is no such frame.
+	 */
+	bool frame(size_t age, vector<float> &data) const;
+	/** Copy the average of all stored frames. */
+	bool average(vector<float> &data) const;
+	/**
+	 * Copy the min/max envelope of all stored frames. The envelope is
+	 * calculated once per completed frame.
+	 */
+	bool peak(vector<float> &min, vector<float> &max) const;
+
+private:
+	struct Frame
+	{
+		/** The sample memory, it is never shrunk. */
+		vector<float> data;
+		size_t size;
+	};
+
+	/** Reset the frames and the sums, mutex_ must be locked. */
+	void reset();
+	/** Add (sign = 1) or subtract (sign = -1) a frame to/from the sums. */
+	void accumulate(const Frame &frame, double sign);
+	/** Return the slot of the newest frame, mutex_ must be locked. */
+	size_t newest_slot() const;
+
+	mutable mutex mutex_;
+	vector<Frame> frames_;
+	/** The slot of the frame that is written next. */
+	size_t next_frame_;
+	size_t stored_frames_;
+	bool in_frame_;
+	uint64_t samplerate_;
+	atomic<size_t> generation_;
+
+	/** The sums and counts of all stored frames, per sample. */
+	vector<double> sum_;
+	vector<double> count_;
+
+	/** The envelope is cached for this generation. */
+	mutable size_t peak_generation_;
+	mutable vector<float> min_;
+	mutable vector<float> max_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_FRAMEBUFFER_HPP
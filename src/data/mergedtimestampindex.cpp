@@ -0,0 +1,255 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "mergedtimestampindex.hpp"
+#include "src/data/analogtimesignal.hpp"
+
+using std::bitset;
+using std::pair;
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+const size_t MergedTimestampIndex::checkpoint_rows = 256;
+
+MergedTimestampIndex::MergedTimestampIndex(double time_tolerance,
+		bool relative_time) :
+	time_tolerance_(time_tolerance),
+	relative_time_(relative_time),
+	row_count_(0),
+	last_row_timestamp_(0.)
+{
+}
+
+void MergedTimestampIndex::add_signal(shared_ptr<AnalogTimeSignal> signal)
+{
+	signals_.push_back(signal);
+	clear();
+}
+
+vector<shared_ptr<AnalogTimeSignal>> MergedTimestampIndex::signals() const
+{
+	return signals_;
+}
+
+size_t MergedTimestampIndex::signal_count() const
+{
+	return signals_.size();
+}
+
+shared_ptr<AnalogTimeSignal> MergedTimestampIndex::signal(
+	size_t signal_index) const
+{
+	return signals_[signal_index];
+}
+
+bool MergedTimestampIndex::update()
+{
+	typedef pair<double, size_t> head_t; // pair<timestamp, signal_index>
+	const std::greater<head_t> head_compare;
+
+	const size_t count = signals_.size();
+	// Only merge the samples, that are available now. The signals may grow
+	// while merging.
+	vector<size_t> end_pos(count);
+	// Min heap of the next sample of every signal
+	vector<head_t> heads;
+	for (size_t i=0; i<count; ++i) {
+		end_pos[i] = signals_[i]->sample_count();
+		if (next_pos_[i] < end_pos[i])
+			heads.push_back(head_t(timestamp(i, next_pos_[i]), i));
+	}
+	std::make_heap(heads.begin(), heads.end(), head_compare);
+
+	const bool merged = !heads.empty();
+	vector<size_t> row_signals;
+	while (!heads.empty()) {
+		const double first_timestamp = heads.front().first;
+
+		// Samples are merged into the last row, if they are within the time
+		// tolerance of the last row and their signal has no sample there yet.
+		bool new_row = row_count_ == 0 ||
+			first_timestamp < last_row_timestamp_ ||
+			first_timestamp > last_row_timestamp_ + time_tolerance_;
+		double max_timestamp = (new_row ? first_timestamp : last_row_timestamp_)
+			+ time_tolerance_;
+
+		row_signals.clear();
+		while (!heads.empty() && heads.front().first <= max_timestamp) {
+			const size_t signal_index = heads.front().second;
+			std::pop_heap(heads.begin(), heads.end(), head_compare);
+			heads.pop_back();
+			row_signals.push_back(signal_index);
+			if (!new_row && has_sample(row_count_-1, signal_index)) {
+				new_row = true;
+				max_timestamp = first_timestamp + time_tolerance_;
+			}
+		}
+
+		if (new_row) {
+			add_row();
+			last_row_timestamp_ = first_timestamp;
+		}
+
+		const size_t row = row_count_ - 1;
+		for (const size_t signal_index : row_signals) {
+			row_words_[(row / 64) * count + signal_index] |=
+				(uint64_t)1 << (row % 64);
+			const size_t pos = ++next_pos_[signal_index];
+			if (pos < end_pos[signal_index]) {
+				heads.push_back(
+					head_t(timestamp(signal_index, pos), signal_index));
+				std::push_heap(heads.begin(), heads.end(), head_compare);
+			}
+		}
+	}
+
+	return merged;
+}
+
+void MergedTimestampIndex::clear()
+{
+	row_count_ = 0;
+	row_words_.clear();
+	checkpoints_.clear();
+	next_pos_.assign(signals_.size(), 0);
+	last_row_timestamp_ = 0.;
+}
+
+size_t MergedTimestampIndex::row_count() const
+{
+	return row_count_;
+}
+
+double MergedTimestampIndex::row_timestamp(size_t row) const
+{
+	double row_timestamp = 0.;
+	bool found = false;
+	size_t pos;
+	for (size_t i=0; i<signals_.size(); ++i) {
+		if (!sample_pos(row, i, pos))
+			continue;
+		const double ts = timestamp(i, pos);
+		if (!found || ts < row_timestamp)
+			row_timestamp = ts;
+		found = true;
+	}
+	return row_timestamp;
+}
+
+bool MergedTimestampIndex::sample_pos(size_t row, size_t signal_index,
+	size_t &pos) const
+{
+	if (row >= row_count_ || !has_sample(row, signal_index))
+		return false;
+
+	pos = samples_before(row, signal_index);
+	return true;
+}
+
+MergedTimestampIndex::Interpolation MergedTimestampIndex::interpolated_values(
+	size_t row, vector<double> &values) const
+{
+	values.resize(signals_.size());
+	if (row >= row_count_)
+		return Interpolation::NoNextSample;
+
+	const double row_ts = row_timestamp(row);
+	bool no_next_sample = false;
+	for (size_t i=0; i<signals_.size(); ++i) {
+		const size_t pos = samples_before(row, i);
+		if (has_sample(row, i)) {
+			values[i] = signals_[i]->get_sample(pos, relative_time_).second;
+			continue;
+		}
+		if (pos == 0)
+			return Interpolation::NoPreviousSample;
+		if (pos >= signals_[i]->sample_count()) {
+			no_next_sample = true;
+			continue;
+		}
+
+		const auto sample0 = signals_[i]->get_sample(pos-1, relative_time_);
+		const auto sample1 = signals_[i]->get_sample(pos, relative_time_);
+		if (sample1.first == sample0.first) {
+			values[i] = sample1.second;
+		}
+		else {
+			values[i] = sample0.second + (sample1.second - sample0.second) *
+				(row_ts - sample0.first) / (sample1.first - sample0.first);
+		}
+	}
+
+	if (no_next_sample)
+		return Interpolation::NoNextSample;
+	return Interpolation::Ok;
+}
+
+bool MergedTimestampIndex::has_sample(size_t row, size_t signal_index) const
+{
+	const uint64_t word =
+		row_words_[(row / 64) * signals_.size() + signal_index];
+	return (word >> (row % 64)) & 1;
+}
+
+size_t MergedTimestampIndex::samples_before(size_t row,
+	size_t signal_index) const
+{
+	const size_t count = signals_.size();
+	const size_t checkpoint = row / checkpoint_rows;
+	size_t pos = checkpoints_[checkpoint * count + signal_index];
+
+	const size_t row_word = row / 64;
+	for (size_t w=checkpoint*(checkpoint_rows/64); w<row_word; ++w)
+		pos += bitset<64>(row_words_[w * count + signal_index]).count();
+	const size_t bits = row % 64;
+	if (bits > 0) {
+		const uint64_t mask = ((uint64_t)1 << bits) - 1;
+		pos += bitset<64>(
+			row_words_[row_word * count + signal_index] & mask).count();
+	}
+	return pos;
+}
+
+double MergedTimestampIndex::timestamp(size_t signal_index, size_t pos) const
+{
+	return signals_[signal_index]->get_sample(pos, relative_time_).first;
+}
+
+void MergedTimestampIndex::add_row()
+{
+	if (row_count_ % 64 == 0)
+		row_words_.resize(row_words_.size() + signals_.size(), 0);
+	if (row_count_ % checkpoint_rows == 0)
+		checkpoints_.insert(checkpoints_.end(), next_pos_.begin(), next_pos_.end());
+	++row_count_;
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_MERGEDTIMESTAMPINDEX_HPP
+#define DATA_MERGEDTIMESTAMPINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+class AnalogTimeSignal;
+
+/**
+ * A merged timeline over the samples of multiple signals. Every row of the
+ * timeline is one timestamp, with one sample or no sample per signal. Used
+ * by the data view, the combined CSV export and the math channels, that
+ * combine two signals.
+ *
+ * The index doesn't store timestamps or values, only one bit per row and
+ * signal, that tells if the signal has a sample in this row. The bits are
+ * stored per signal in words of 64 rows, and the sample positions of all
+ * signals are stored at every checkpoint_rows row. So the sample position of
+ * a signal in any row can be calculated with a few popcounts.
+ *
+ * The index is updated incrementally, when new samples are appended to the
+ * signals. Merging n new samples costs O(n * log(N)) for N signals.
+ *
+ * With a time tolerance > 0, samples of different signals are put into the
+ * same row, if they are not more than the tolerance after the first sample
+ * of the row (like the "combination time frame" of the CSV export). Each
+ * signal has max. one sample per row.
+ *
+ * Samples that are older than the last row (because they arrived later than
+ * newer samples of another signal) are appended as a new row, the rows are
+ * never reordered.
+ */
+class MergedTimestampIndex
+{
+
+public:
+	enum class Interpolation {
+		/** The values of all signals are valid. */
+		Ok,
+		/** A signal has no sample before the row, the row can be skipped. */
+		NoPreviousSample,
+		/** A signal has no sample after the row yet. */
+		NoNextSample
+	};
+
+	/**
+	 * @param[in] time_tolerance Max. time distance of the samples in a row.
+	 * @param[in] relative_time Merge the signals by their relative timestamps.
+	 */
+	explicit MergedTimestampIndex(double time_tolerance = 0.,
+		bool relative_time = true);
+
+	/** Add a signal to the index. The index is rebuilt by the next update. */
+	void add_signal(shared_ptr<AnalogTimeSignal> signal);
+	vector<shared_ptr<AnalogTimeSignal>> signals() const;
+	size_t signal_count() const;
+	shared_ptr<AnalogTimeSignal> signal(size_t signal_index) const;
+
+	/**
+	 * Merge the new samples of all signals into the index. Return true, if
+	 * new samples were merged.
+	 */
+	bool update();
+	/** Remove all rows. The index is rebuilt by the next update. */
+	void clear();
+
+	/** Return the number of rows. */
+	size_t row_count() const;
+	/** Return the timestamp of the first sample in the row. */
+	double row_timestamp(size_t row) const;
+	/**
+	 * Get the position of the sample of the signal in the row. Returns false
+	 * if the signal has no sample in this row.
+	 */
+	bool sample_pos(size_t row, size_t signal_index, size_t &pos) const;
+	/**
+	 * Get the values of all signals at the timestamp of the row. Signals
+	 * without a sample in the row are linearly interpolated between their
+	 * previous and next sample.
+	 */
+	Interpolation interpolated_values(size_t row, vector<double> &values) const;
+
+private:
+	bool has_sample(size_t row, size_t signal_index) const;
+	/** Return the number of samples of the signal in the rows before row. */
+	size_t samples_before(size_t row, size_t signal_index) const;
+	double timestamp(size_t signal_index, size_t pos) const;
+	void add_row();
+
+	static const size_t checkpoint_rows;
+
+	const double time_tolerance_;
+	const bool relative_time_;
+	vector<shared_ptr<AnalogTimeSignal>> signals_;
+	size_t row_count_;
+	/** One bit per row and signal, 64 rows per word: [row/64][signal] */
+	vector<uint64_t> row_words_;
+	/** The sample positions of all signals at every checkpoint_rows row. */
+	vector<size_t> checkpoints_;
+	/** The next sample position of each signal. */
+	vector<size_t> next_pos_;
+	double last_row_timestamp_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_MERGEDTIMESTAMPINDEX_HPP
@@ -0,0 +1,152 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "minmaxpyramid.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+MinMaxPyramid::MinMaxPyramid(size_t block_size) :
+	block_size_(block_size > 0 ? block_size : 1),
+	size_(0)
+{
+}
+
+void MinMaxPyramid::update(const vector<double> &data, size_t count)
+{
+	count = std::min(count, data.size());
+	if (count <= size_)
+		return;
+
+	if (levels_.empty())
+		levels_.emplace_back();
+
+	// Lowest level: Add the new values to their blocks.
+	size_t first_changed = size_ / block_size_;
+	vector<Node> &blocks = levels_[0];
+	for (size_t i = size_; i < count; ++i) {
+		const size_t block = i / block_size_;
+		if (block >= blocks.size())
+			blocks.push_back(empty_node());
+		combine(blocks[block], data[i]);
+	}
+	size_ = count;
+
+	// Recalculate the changed nodes of all levels above.
+	for (size_t level = 1; levels_[level-1].size() > 1; ++level) {
+		if (level >= levels_.size())
+			levels_.emplace_back();
+		const vector<Node> &children = levels_[level-1];
+		vector<Node> &nodes = levels_[level];
+		nodes.resize((children.size() + 1) / 2, empty_node());
+
+		first_changed /= 2;
+		for (size_t i = first_changed; i < nodes.size(); ++i) {
+			Node node = children[2*i];
+			if (2*i + 1 < children.size())
+				combine(node, children[2*i + 1]);
+			nodes[i] = node;
+		}
+	}
+}
+
+void MinMaxPyramid::clear()
+{
+	levels_.clear();
+	size_ = 0;
+}
+
+size_t MinMaxPyramid::size() const
+{
+	return size_;
+}
+
+bool MinMaxPyramid::min_max(const vector<double> &data,
+	size_t from, size_t to, double &min, double &max) const
+{
+	Node result = empty_node();
+	size_t begin = from;
+	size_t end = std::min(to + 1, size_);
+	if (begin >= end)
+		return false;
+
+	// Values in front of the first and behind the last complete block.
+	const size_t first_block = (begin + block_size_ - 1) / block_size_;
+	const size_t last_block = end / block_size_;
+	if (first_block >= last_block) {
+		for (size_t i = begin; i < end; ++i)
+			combine(result, data[i]);
+	}
+	else {
+		for (size_t i = begin; i < first_block * block_size_; ++i)
+			combine(result, data[i]);
+		for (size_t i = last_block * block_size_; i < end; ++i)
+			combine(result, data[i]);
+
+		// Walk up the pyramid for the complete blocks, like in an iterative
+		// segment tree.
+		size_t left = first_block;
+		size_t right = last_block;
+		for (size_t level = 0; left < right; ++level) {
+			if (left & 1)
+				combine(result, levels_[level][left++]);
+			if (right & 1)
+				combine(result, levels_[level][--right]);
+			left /= 2;
+			right /= 2;
+		}
+	}
+
+	if (result.min > result.max)
+		return false;
+	min = result.min;
+	max = result.max;
+	return true;
+}
+
+MinMaxPyramid::Node MinMaxPyramid::empty_node()
+{
+	return Node{
+		std::numeric_limits<double>::infinity(),
+		-std::numeric_limits<double>::infinity() };
+}
+
+void MinMaxPyramid::combine(Node &node, const Node &other)
+{
+	node.min = std::min(node.min, other.min);
+	node.max = std::max(node.max, other.max);
+}
+
+void MinMaxPyramid::combine(Node &node, double value)
+{
+	if (!std::isfinite(value))
+		return;
+	node.min = std::min(node.min, value);
+	node.max = std::max(node.max, value);
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_MINMAXPYRAMID_HPP
+#define DATA_MINMAXPYRAMID_HPP
+
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * A min/max pyramid (a segment tree that can be appended to) over the
+ * values of a signal, to query the minimum and maximum of any range of
+ * samples in O(log n).
+ *
+ * The lowest level holds the min/max of blocks of samples, every level above
+ * combines two nodes of the level below. The pyramid doesn't store the
+ * samples itself, the data vector of the signal is passed to update() and
+ * min_max(). Non finite values (inf, NaN) are ignored.
+ */
+class MinMaxPyramid
+{
+
+public:
+	/**
+	 * @param[in] block_size The number of samples per node of the lowest
+	 *                       level. A smaller block size makes queries
+	 *                       faster, but needs more memory.
+	 */
+	explicit MinMaxPyramid(size_t block_size = 32);
+
+	/** Add the values data[size()..count-1] to the pyramid. */
+	void update(const vector<double> &data, size_t count);
+	void clear();
+	/** Return the number of values in the pyramid. */
+	size_t size() const;
+
+	/**
+	 * Get the minimum and maximum of data[from..to]. Returns false, if there
+	 * is no finite value in the range.
+	 */
+	bool min_max(const vector<double> &data, size_t from, size_t to,
+		double &min, double &max) const;
+
+private:
+	struct Node
+	{
+		double min;
+		double max;
+	};
+
+	static Node empty_node();
+	static void combine(Node &node, const Node &other);
+	static void combine(Node &node, double value);
+
+	const size_t block_size_;
+	size_t size_;
+	vector<vector<Node>> levels_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_MINMAXPYRAMID_HPP
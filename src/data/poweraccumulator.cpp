@@ -0,0 +1,238 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "poweraccumulator.hpp"
+#include "src/session.hpp"
+#include "src/workerpool.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/mergedtimestampindex.hpp"
+
+using std::lock_guard;
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+PowerAccumulator::PowerAccumulator(
+		shared_ptr<AnalogTimeSignal> voltage_signal,
+		shared_ptr<AnalogTimeSignal> current_signal) :
+	voltage_signal_(voltage_signal),
+	current_signal_(current_signal),
+	index_(0., false),
+	next_row_(0),
+	has_last_pair_(false),
+	last_timestamp_(0.),
+	last_current_(0.),
+	last_power_(0.),
+	accumulated_reset_count_(0),
+	accumulated_clear_count_(0),
+	reset_count_(0),
+	generation_(0),
+	clear_count_(0),
+	strand_(new WorkerStrand(Session::worker_pool)),
+	accumulation_scheduled_(false)
+{
+	assert(voltage_signal_);
+	assert(current_signal_);
+
+	// Skip the already existing samples.
+	index_.add_signal(voltage_signal_);
+	index_.add_signal(current_signal_);
+	index_.update();
+	next_row_ = index_.row_count();
+
+	connect(voltage_signal_.get(), &AnalogTimeSignal::sample_appended,
+		this, &PowerAccumulator::on_sample_appended, Qt::DirectConnection);
+	connect(current_signal_.get(), &AnalogTimeSignal::sample_appended,
+		this, &PowerAccumulator::on_sample_appended, Qt::DirectConnection);
+	connect(voltage_signal_.get(), &AnalogTimeSignal::samples_cleared,
+		this, &PowerAccumulator::on_samples_cleared, Qt::DirectConnection);
+	connect(current_signal_.get(), &AnalogTimeSignal::samples_cleared,
+		this, &PowerAccumulator::on_samples_cleared, Qt::DirectConnection);
+}
+
+PowerAccumulator::~PowerAccumulator()
+{
+	// Wait for a running accumulation, before the members are destroyed.
+	strand_->close();
+}
+
+PowerStatistics PowerAccumulator::statistics() const
+{
+	lock_guard<mutex> lock(statistics_mutex_);
+	return statistics_;
+}
+
+size_t PowerAccumulator::generation() const
+{
+	return generation_;
+}
+
+void PowerAccumulator::reset()
+{
+	{
+		lock_guard<mutex> lock(statistics_mutex_);
+		statistics_ = PowerStatistics();
+		++reset_count_;
+	}
+	++generation_;
+}
+
+void PowerAccumulator::accumulate()
+{
+	// The samples of a signal were cleared, rebuild the index. The
+	// accumulated values are kept.
+	const size_t clear_count = clear_count_;
+	if (clear_count != accumulated_clear_count_) {
+		accumulated_clear_count_ = clear_count;
+		index_.clear();
+		next_row_ = 0;
+		has_last_pair_ = false;
+	}
+
+	index_.update();
+	if (next_row_ >= index_.row_count())
+		return;
+
+	PowerStatistics statistics;
+	size_t reset_count;
+	{
+		lock_guard<mutex> lock(statistics_mutex_);
+		statistics = statistics_;
+		reset_count = reset_count_;
+	}
+	// Don't integrate across a reset.
+	if (reset_count != accumulated_reset_count_) {
+		accumulated_reset_count_ = reset_count;
+		has_last_pair_ = false;
+	}
+
+	// Values: [0] = voltage, [1] = current
+	vector<double> values;
+	const size_t first_row = next_row_;
+	bool changed = false;
+	for (; next_row_ < index_.row_count(); ++next_row_) {
+		const auto interpolation =
+			index_.interpolated_values(next_row_, values);
+		// Wait for the next sample to interpolate the row.
+		if (interpolation == MergedTimestampIndex::Interpolation::NoNextSample)
+			break;
+		// Ignore the first sample(s), before both signals have started.
+		if (interpolation != MergedTimestampIndex::Interpolation::Ok)
+			continue;
+
+		const double timestamp = index_.row_timestamp(next_row_);
+		const double voltage = values[0];
+		const double current = values[1];
+		const double resistance = current == 0. ?
+			std::numeric_limits<double>::max() : voltage / current;
+		const double power = voltage * current;
+
+		statistics.voltage = voltage;
+		if (statistics.voltage_min > voltage)
+			statistics.voltage_min = voltage;
+		if (statistics.voltage_max < voltage)
+			statistics.voltage_max = voltage;
+		statistics.current = current;
+		if (statistics.current_min > current)
+			statistics.current_min = current;
+		if (statistics.current_max < current)
+			statistics.current_max = current;
+		statistics.resistance = resistance;
+		if (statistics.resistance_min > resistance)
+			statistics.resistance_min = resistance;
+		if (statistics.resistance_max < resistance)
+			statistics.resistance_max = resistance;
+		statistics.power = power;
+		if (statistics.power_min > power)
+			statistics.power_min = power;
+		if (statistics.power_max < power)
+			statistics.power_max = power;
+
+		// Trapezoidal integration between the last and the actual pair
+		if (has_last_pair_ && timestamp > last_timestamp_) {
+			const double elapsed_hours = (timestamp - last_timestamp_) / 3600.;
+			statistics.amp_hours +=
+				(last_current_ + current) / 2. * elapsed_hours;
+			statistics.watt_hours +=
+				(last_power_ + power) / 2. * elapsed_hours;
+		}
+		has_last_pair_ = true;
+		last_timestamp_ = timestamp;
+		last_current_ = current;
+		last_power_ = power;
+
+		++statistics.sample_count;
+		changed = true;
+	}
+	if (!changed)
+		return;
+
+	bool dropped = false;
+	{
+		lock_guard<mutex> lock(statistics_mutex_);
+		// The values were reset or the samples were cleared while
+		// accumulating, drop them. The rows of this batch are accumulated
+		// again, so the rows that arrived after the reset aren't lost.
+		if (reset_count != reset_count_ || clear_count != clear_count_) {
+			next_row_ = first_row;
+			has_last_pair_ = false;
+			dropped = true;
+		}
+		else {
+			statistics_ = statistics;
+		}
+	}
+	if (dropped) {
+		on_sample_appended();
+		return;
+	}
+	++generation_;
+}
+
+void PowerAccumulator::on_sample_appended()
+{
+	// Coalesce the notifications of both signals. The index is only touched
+	// within the strand.
+	if (accumulation_scheduled_.exchange(true))
+		return;
+
+	strand_->post([this]() {
+		accumulation_scheduled_ = false;
+		accumulate();
+	});
+}
+
+void PowerAccumulator::on_samples_cleared()
+{
+	// The index is only touched within the strand, the next accumulation
+	// rebuilds it.
+	++clear_count_;
+	on_sample_appended();
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_POWERACCUMULATOR_HPP
+#define DATA_POWERACCUMULATOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+#include <QObject>
+
+#include "src/data/mergedtimestampindex.hpp"
+
+using std::atomic;
+using std::mutex;
+using std::shared_ptr;
+using std::unique_ptr;
+
+namespace sv {
+
+class WorkerStrand;
+
+namespace data {
+
+class AnalogTimeSignal;
+
+/**
+ * The actual, min and max values and the accumulated charge and energy of a
+ * voltage/current signal pair.
+ */
+struct PowerStatistics
+{
+	/** The number of processed voltage/current sample pairs. */
+	size_t sample_count = 0;
+
+	double voltage = 0.;
+	double voltage_min = std::numeric_limits<double>::max();
+	double voltage_max = std::numeric_limits<double>::lowest();
+	double current = 0.;
+	double current_min = std::numeric_limits<double>::max();
+	double current_max = std::numeric_limits<double>::lowest();
+	double resistance = 0.;
+	double resistance_min = std::numeric_limits<double>::max();
+	double resistance_max = std::numeric_limits<double>::lowest();
+	double power = 0.;
+	double power_min = std::numeric_limits<double>::max();
+	double power_max = std::numeric_limits<double>::lowest();
+
+	double amp_hours = 0.;
+	double watt_hours = 0.;
+};
+
+/**
+ * Accumulates the charge (Ah) and energy (Wh) of a voltage and a current
+ * signal sample by sample.
+ *
+ * The samples of both signals are merged by their timestamps. If a signal
+ * has no sample at a timestamp, its value is interpolated. The current and
+ * the power are integrated with the trapezoidal rule between two
+ * consecutive timestamps, and the min/max values are taken from every
+ * sample pair.
+ *
+ * The accumulation runs on the session worker pool, when new samples are
+ * appended to the signals, so it doesn't depend on the GUI load. Only
+ * samples, that are appended after the accumulator was created (or reset),
+ * are accumulated.
+ */
+class PowerAccumulator : public QObject
+{
+	Q_OBJECT
+
+public:
+	PowerAccumulator(shared_ptr<AnalogTimeSignal> voltage_signal,
+		shared_ptr<AnalogTimeSignal> current_signal);
+	~PowerAccumulator();
+
+	/** Return a snapshot of the accumulated values. */
+	PowerStatistics statistics() const;
+	/** Return a number that changes, every time the statistics change. */
+	size_t generation() const;
+
+	/** Reset all values and restart the accumulation. */
+	void reset();
+
+private:
+	/** Process all new sample pairs. Runs within the strand. */
+	void accumulate();
+
+	shared_ptr<AnalogTimeSignal> voltage_signal_;
+	shared_ptr<AnalogTimeSignal> current_signal_;
+
+	// Only touched within the strand
+	MergedTimestampIndex index_;
+	size_t next_row_;
+	bool has_last_pair_;
+	double last_timestamp_;
+	double last_current_;
+	double last_power_;
+	size_t accumulated_reset_count_;
+	size_t accumulated_clear_count_;
+
+	mutable mutex statistics_mutex_;
+	PowerStatistics statistics_;
+	size_t reset_count_;
+	atomic<size_t> generation_;
+	/** Incremented, when the samples of a signal are cleared. */
+	atomic<size_t> clear_count_;
+
+	unique_ptr<WorkerStrand> strand_;
+	atomic<bool> accumulation_scheduled_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+	void on_samples_cleared();
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_POWERACCUMULATOR_HPP
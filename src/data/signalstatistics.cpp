@@ -0,0 +1,369 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "signalstatistics.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+namespace {
+
+const double pi = std::acos(-1);
+
+} // namespace
+
+SignalStatistics::SignalStatistics(size_t bin_count, double compression) :
+	bin_count_(std::max((size_t)2, bin_count + bin_count % 2)),
+	compression_(std::max(10., compression)),
+	buffer_size_((size_t)(5 * compression_))
+{
+	clear();
+}
+
+void SignalStatistics::add(double value)
+{
+	if (!std::isfinite(value))
+		return;
+
+	// Welford's online algorithm for mean and variance.
+	++count_;
+	const double delta = value - mean_;
+	mean_ += delta / (double)count_;
+	m2_ += delta * (value - mean_);
+	if (value < min_)
+		min_ = value;
+	if (value > max_)
+		max_ = value;
+
+	if (bins_.empty()) {
+		initial_values_.push_back(value);
+		if (initial_values_.size() >= bin_count_)
+			init_histogram();
+	}
+	else {
+		add_to_histogram(value, 1);
+	}
+
+	buffer_.push_back(value);
+	if (buffer_.size() >= buffer_size_)
+		flush_buffer();
+}
+
+void SignalStatistics::merge(const SignalStatistics &other)
+{
+	if (other.count_ == 0)
+		return;
+
+	// Parallel variant of Welford's algorithm.
+	const uint64_t count = count_ + other.count_;
+	const double delta = other.mean_ - mean_;
+	m2_ += other.m2_ + delta * delta *
+		(double)count_ * (double)other.count_ / (double)count;
+	mean_ += delta * (double)other.count_ / (double)count;
+	count_ = count;
+	min_ = std::min(min_, other.min_);
+	max_ = std::max(max_, other.max_);
+
+	if (!other.bins_.empty()) {
+		if (bins_.empty() && initial_values_.empty()) {
+			bins_ = other.bins_;
+			lower_ = other.lower_;
+			bin_width_ = other.bin_width_;
+		}
+		else {
+			if (bins_.empty())
+				init_histogram();
+			// The bins of the other histogram are added at their center.
+			for (size_t i=0; i<other.bins_.size(); ++i) {
+				if (other.bins_[i] == 0)
+					continue;
+				add_to_histogram(other.lower_ +
+					((double)i + 0.5) * other.bin_width_, other.bins_[i]);
+			}
+		}
+	}
+	else {
+		for (const double value : other.initial_values_) {
+			if (bins_.empty()) {
+				initial_values_.push_back(value);
+				if (initial_values_.size() >= bin_count_)
+					init_histogram();
+			}
+			else {
+				add_to_histogram(value, 1);
+			}
+		}
+	}
+
+	vector<Centroid> centroids = merged_centroids();
+	const vector<Centroid> other_centroids = other.merged_centroids();
+	centroids.insert(centroids.end(),
+		other_centroids.begin(), other_centroids.end());
+	centroids_ = compress(centroids);
+	buffer_.clear();
+}
+
+void SignalStatistics::clear()
+{
+	count_ = 0;
+	mean_ = 0.;
+	m2_ = 0.;
+	min_ = std::numeric_limits<double>::max();
+	max_ = std::numeric_limits<double>::lowest();
+
+	initial_values_.clear();
+	initial_values_.reserve(bin_count_);
+	bins_.clear();
+	lower_ = 0.;
+	bin_width_ = 0.;
+
+	centroids_.clear();
+	buffer_.clear();
+	buffer_.reserve(buffer_size_);
+}
+
+uint64_t SignalStatistics::count() const
+{
+	return count_;
+}
+
+double SignalStatistics::mean() const
+{
+	if (count_ == 0)
+		return std::numeric_limits<double>::quiet_NaN();
+	return mean_;
+}
+
+double SignalStatistics::stddev() const
+{
+	if (count_ < 2)
+		return std::numeric_limits<double>::quiet_NaN();
+	return std::sqrt(m2_ / (double)(count_ - 1));
+}
+
+double SignalStatistics::min() const
+{
+	if (count_ == 0)
+		return std::numeric_limits<double>::quiet_NaN();
+	return min_;
+}
+
+double SignalStatistics::max() const
+{
+	if (count_ == 0)
+		return std::numeric_limits<double>::quiet_NaN();
+	return max_;
+}
+
+double SignalStatistics::quantile(double q) const
+{
+	if (count_ == 0)
+		return std::numeric_limits<double>::quiet_NaN();
+	if (q <= 0.)
+		return min_;
+	if (q >= 1.)
+		return max_;
+
+	const vector<Centroid> centroids = merged_centroids();
+	const double rank = q * (double)count_;
+
+	// Interpolate linearly between the centers of the centroids. The
+	// outermost halves are interpolated to the exact min and max values.
+	const Centroid &first = centroids.front();
+	if (rank < first.weight / 2)
+		return min_ + (first.mean - min_) * rank / (first.weight / 2);
+
+	double cumulative_weight = 0.;
+	for (size_t i=0; i<centroids.size()-1; ++i) {
+		const double left = cumulative_weight + centroids[i].weight / 2;
+		const double right = cumulative_weight + centroids[i].weight +
+			centroids[i+1].weight / 2;
+		if (rank < right) {
+			return centroids[i].mean +
+				(centroids[i+1].mean - centroids[i].mean) *
+				(rank - left) / (right - left);
+		}
+		cumulative_weight += centroids[i].weight;
+	}
+
+	const Centroid &last = centroids.back();
+	const double left = (double)count_ - last.weight / 2;
+	return last.mean +
+		(max_ - last.mean) * std::min(1., (rank - left) / (last.weight / 2));
+}
+
+vector<uint64_t> SignalStatistics::histogram() const
+{
+	if (!bins_.empty() || initial_values_.empty())
+		return bins_;
+
+	// Not enough values for the final histogram yet.
+	SignalStatistics statistics(*this);
+	statistics.init_histogram();
+	return statistics.bins_;
+}
+
+double SignalStatistics::histogram_lower() const
+{
+	if (!bins_.empty() || initial_values_.empty())
+		return lower_;
+
+	SignalStatistics statistics(*this);
+	statistics.init_histogram();
+	return statistics.lower_;
+}
+
+double SignalStatistics::histogram_bin_width() const
+{
+	if (!bins_.empty() || initial_values_.empty())
+		return bin_width_;
+
+	SignalStatistics statistics(*this);
+	statistics.init_histogram();
+	return statistics.bin_width_;
+}
+
+void SignalStatistics::add_to_histogram(double value, uint64_t count)
+{
+	if (value < lower_ || value >= lower_ + (double)bin_count_ * bin_width_)
+		expand_histogram(value);
+
+	size_t index = (size_t)((value - lower_) / bin_width_);
+	if (index >= bin_count_)
+		index = bin_count_ - 1;
+	bins_[index] += count;
+}
+
+void SignalStatistics::init_histogram()
+{
+	if (initial_values_.empty())
+		return;
+
+	const auto min_max = std::minmax_element(
+		initial_values_.begin(), initial_values_.end());
+	lower_ = *min_max.first;
+	// The maximum must be inside the last bin.
+	bin_width_ = (*min_max.second - lower_) / (double)(bin_count_ - 1);
+	if (bin_width_ <= 0.)
+		bin_width_ = std::max(std::fabs(lower_), 1.) * 1e-9;
+
+	bins_.assign(bin_count_, 0);
+	for (const double value : initial_values_)
+		add_to_histogram(value, 1);
+	initial_values_.clear();
+	initial_values_.shrink_to_fit();
+}
+
+void SignalStatistics::expand_histogram(double value)
+{
+	const size_t half_count = bin_count_ / 2;
+	vector<uint64_t> merged_bins(bin_count_);
+	while (value < lower_ ||
+			value >= lower_ + (double)bin_count_ * bin_width_) {
+		// The old range becomes the upper or the lower half of the new range.
+		const size_t offset = value < lower_ ? half_count : 0;
+		std::fill(merged_bins.begin(), merged_bins.end(), 0);
+		for (size_t i=0; i<bin_count_; ++i)
+			merged_bins[offset + i/2] += bins_[i];
+		bins_.swap(merged_bins);
+
+		if (offset > 0)
+			lower_ -= (double)bin_count_ * bin_width_;
+		bin_width_ *= 2;
+	}
+}
+
+vector<SignalStatistics::Centroid> SignalStatistics::merged_centroids() const
+{
+	if (buffer_.empty())
+		return centroids_;
+
+	vector<Centroid> input(centroids_);
+	input.reserve(centroids_.size() + buffer_.size());
+	for (const double value : buffer_)
+		input.push_back({ value, 1. });
+	return compress(input);
+}
+
+vector<SignalStatistics::Centroid> SignalStatistics::compress(
+	vector<Centroid> &input) const
+{
+	std::sort(input.begin(), input.end(),
+		[](const Centroid &c1, const Centroid &c2) {
+			return c1.mean < c2.mean;
+		});
+
+	double total_weight = 0.;
+	for (const auto &centroid : input)
+		total_weight += centroid.weight;
+
+	// Merge neighbouring centroids as long as the merged centroid spans at
+	// most one unit of the scale function.
+	vector<Centroid> centroids;
+	Centroid current = input.front();
+	double weight_so_far = 0.;
+	double q_limit = inverse_scale(scale(0.) + 1.);
+	for (size_t i=1; i<input.size(); ++i) {
+		const double q =
+			(weight_so_far + current.weight + input[i].weight) / total_weight;
+		if (q <= q_limit) {
+			current.weight += input[i].weight;
+			current.mean += (input[i].mean - current.mean) *
+				input[i].weight / current.weight;
+		}
+		else {
+			centroids.push_back(current);
+			weight_so_far += current.weight;
+			q_limit = inverse_scale(scale(weight_so_far / total_weight) + 1.);
+			current = input[i];
+		}
+	}
+	centroids.push_back(current);
+
+	return centroids;
+}
+
+void SignalStatistics::flush_buffer()
+{
+	centroids_ = merged_centroids();
+	buffer_.clear();
+}
+
+double SignalStatistics::scale(double q) const
+{
+	return compression_ / (2 * pi) * std::asin(2 * q - 1);
+}
+
+double SignalStatistics::inverse_scale(double k) const
+{
+	if (k >= compression_ / 4)
+		return 1.;
+	return (std::sin(k * 2 * pi / compression_) + 1) / 2;
+}
+
+} // namespace data
+} // namespace sv
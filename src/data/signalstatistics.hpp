@@ -0,0 +1,136 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_SIGNALSTATISTICS_HPP
+#define DATA_SIGNALSTATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * Incremental statistics of a signal: count, mean, standard deviation, an
+ * adaptive histogram and a t-digest quantile sketch.
+ *
+ * The histogram has a fixed number of bins. When a value is outside of the
+ * histogram range, the range is doubled and two neighbouring bins are
+ * merged, so the counts stay exact and no samples must be revisited.
+ *
+ * The quantile sketch is a merging t-digest (Dunning, Ertl: "Computing
+ * Extremely Accurate Quantiles Using t-Digests"). New values are buffered
+ * and merged into a sorted list of weighted centroids. The centroids near
+ * the tails are kept small, so p1/p99 are much more accurate than the
+ * median. The number of centroids is bounded by the compression.
+ *
+ * Both structures are mergeable. This class is not thread safe.
+ */
+class SignalStatistics
+{
+
+public:
+	/**
+	 * @param[in] bin_count The number of histogram bins, must be even.
+	 * @param[in] compression The compression of the t-digest. Higher values
+	 *                        give more accurate quantiles, but more centroids.
+	 */
+	explicit SignalStatistics(size_t bin_count = 64, double compression = 200);
+
+	/** Add a value. Non-finite values (e.g. overflows) are ignored. */
+	void add(double value);
+
+	/** Merge the statistics of another signal into this statistics. */
+	void merge(const SignalStatistics &other);
+
+	void clear();
+
+	/** Return the number of (finite) values. */
+	uint64_t count() const;
+	double mean() const;
+	double stddev() const;
+	double min() const;
+	double max() const;
+
+	/**
+	 * Return the approximated q-quantile (e.g. 0.5 for the median) or NaN
+	 * if there are no values.
+	 */
+	double quantile(double q) const;
+
+	/**
+	 * Return the histogram bins. The lower boundary of bin i is
+	 * histogram_lower() + i*histogram_bin_width().
+	 */
+	vector<uint64_t> histogram() const;
+	double histogram_lower() const;
+	double histogram_bin_width() const;
+
+private:
+	/** Add a value with the given count to the histogram. */
+	void add_to_histogram(double value, uint64_t count);
+	/** Init the histogram range from the buffered first values. */
+	void init_histogram();
+	/** Double the histogram range until it contains the value. */
+	void expand_histogram(double value);
+
+	struct Centroid
+	{
+		double mean;
+		double weight;
+	};
+
+	/** Return the centroids with the buffered values merged in. */
+	vector<Centroid> merged_centroids() const;
+	/** Sort the centroids and merge them as far as the scale permits. */
+	vector<Centroid> compress(vector<Centroid> &input) const;
+	/** Merge the buffered values into the centroids. */
+	void flush_buffer();
+	/** The t-digest scale function k1 and its inverse. */
+	double scale(double q) const;
+	double inverse_scale(double k) const;
+
+	const size_t bin_count_;
+	const double compression_;
+	const size_t buffer_size_;
+
+	uint64_t count_;
+	double mean_;
+	double m2_;
+	double min_;
+	double max_;
+
+	/** The first bin_count values are buffered to find the initial range. */
+	vector<double> initial_values_;
+	vector<uint64_t> bins_;
+	double lower_;
+	double bin_width_;
+
+	vector<Centroid> centroids_;
+	vector<double> buffer_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_SIGNALSTATISTICS_HPP
@@ -0,0 +1,80 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2019-2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <cstddef>
+
+#include "waveform.hpp"
+
+namespace sv {
+namespace data {
+
+namespace {
+
+const double pi = std::acos(-1);
+
+} // namespace
+
+Waveform::Waveform() :
+	Waveform(WaveformType::Sine, 0, 0, 0, 0, 0)
+{
+}
+
+Waveform::Waveform(WaveformType type, double amplitude, double offset,
+		double periode, double interval, double phi) :
+	type_(type),
+	amplitude_(amplitude),
+	offset_(offset),
+	periode_(periode),
+	interval_(interval),
+	phi_(phi),
+	omega_(periode > 0 ? 2 * pi / periode : 0)
+{
+}
+
+size_t Waveform::sample_count() const
+{
+	if (interval_ <= 0 || periode_ <= 0)
+		return 0;
+	return static_cast<size_t>(std::floor(periode_ / interval_));
+}
+
+double Waveform::value(size_t pos) const
+{
+	// NOLINTNEXTLINE(readability-identifier-length)
+	double x = omega_ * (static_cast<double>(pos) * interval_) + phi_;
+	double value;
+	if (type_ == WaveformType::Sine)
+		value = std::sin(x);
+	else if (type_ == WaveformType::Square)
+		value = std::sin(x) < 0 ? -1 : 1;
+	else if (type_ == WaveformType::Triangle)
+		value = (std::asin(std::sin(x))) / (pi/2);
+	else if (type_ == WaveformType::Sawtooth)
+		value = std::fmod(x / pi, 2.0) - 1.0;
+	else if (type_ == WaveformType::SawtoothInv)
+		value = -std::fmod(x / pi, 2.0) + 1.0;
+	else
+		value = 0;
+
+	return (amplitude_ * value) + offset_;
+}
+
+} // namespace data
+} // namespace sv
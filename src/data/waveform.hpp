@@ -0,0 +1,77 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2019-2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_WAVEFORM_HPP
+#define DATA_WAVEFORM_HPP
+
+#include <cstddef>
+
+namespace sv {
+namespace data {
+
+enum class WaveformType {
+	Sine,
+	Square,
+	Triangle,
+	Sawtooth,
+	SawtoothInv,
+};
+
+/**
+ * One periode of a waveform, sampled with a fixed interval. The samples are
+ * calculated on demand from the waveform parameters, so a waveform with a
+ * lot of samples doesn't need any memory.
+ */
+class Waveform
+{
+
+public:
+	Waveform();
+	Waveform(WaveformType type, double amplitude, double offset,
+		double periode, double interval, double phi);
+
+	WaveformType type() const { return type_; }
+	double amplitude() const { return amplitude_; }
+	double offset() const { return offset_; }
+	double periode() const { return periode_; }
+	/** The time between two samples in seconds. */
+	double interval() const { return interval_; }
+	/** The phase offset in rad. */
+	double phi() const { return phi_; }
+
+	/** Return the number of samples in one periode. */
+	size_t sample_count() const;
+	/** Return the value of the sample at `pos`. */
+	double value(size_t pos) const;
+
+private:
+	WaveformType type_;
+	double amplitude_;
+	double offset_;
+	double periode_;
+	double interval_;
+	double phi_;
+	double omega_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_WAVEFORM_HPP
@@ -397,6 +397,7 @@ void BaseDevice::add_math_channel(
 		math_channel->quantity(),
 		math_channel->quantity_flags(),
 		math_channel->unit());
+	math_channel->start_processing();
 }
 
 shared_ptr<channels::UserChannel> BaseDevice::add_user_channel(
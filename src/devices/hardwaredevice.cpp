@@ -44,6 +44,7 @@
 #include "src/devices/configurable.hpp"
 #include "src/devices/deviceutil.hpp"
 
+using std::dynamic_pointer_cast;
 using std::lock_guard;
 using std::make_pair;
 using std::map;
@@ -250,11 +251,27 @@ void HardwareDevice::feed_in_frame_begin()
 	frame_start_timestamp_ =
 		static_cast<double>(QDateTime::currentMSecsSinceEpoch()) / 1000;
 	frame_began_ = true;
+
+	lock_guard<recursive_mutex> lock(data_mutex_);
+	for (const auto &sr_channel_pair : sr_channel_map_) {
+		auto channel = dynamic_pointer_cast<channels::HardwareChannel>(
+			sr_channel_pair.second);
+		if (channel)
+			channel->begin_frame();
+	}
 }
 
 void HardwareDevice::feed_in_frame_end()
 {
 	frame_began_ = false;
+
+	lock_guard<recursive_mutex> lock(data_mutex_);
+	for (const auto &sr_channel_pair : sr_channel_map_) {
+		auto channel = dynamic_pointer_cast<channels::HardwareChannel>(
+			sr_channel_pair.second);
+		if (channel)
+			channel->end_frame();
+	}
 }
 
 void HardwareDevice::feed_in_logic(shared_ptr<sigrok::Logic> sr_logic)
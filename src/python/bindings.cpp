@@ -21,6 +21,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <tuple>
 #include <pybind11/embed.h>
 #include <pybind11/stl.h>
 
@@ -35,6 +36,7 @@
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/basesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/signalstatistics.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/configurable.hpp"
 #include "src/devices/deviceutil.hpp"
@@ -348,6 +350,41 @@ void init_Signal(py::module &module)
 		"    The total number of digits.\n"
 		"decimal_places : int\n"
 		"    The number of decimal places.");
+	py_analog_time_signal.def("set_statistics_enabled", &sv::data::AnalogTimeSignal::set_statistics_enabled,
+		py::arg("enabled"),
+		"Enable or disable the histogram and percentile statistics of the signal. When enabled, the already "
+		"existing samples are added to the statistics.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"enabled : bool\n"
+		"    `True` to enable the statistics.");
+	py_analog_time_signal.def("quantile",
+		[](const sv::data::AnalogTimeSignal &self, double q) {
+			return self.statistics().quantile(q);
+		},
+		py::arg("q"),
+		"Return the estimated quantile of all sample values. The statistics must be enabled with "
+		"`set_statistics_enabled()`.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"q : float\n"
+		"    The quantile between 0.0 and 1.0, e.g. 0.99 for the 99th percentile.\n\n"
+		"Returns\n"
+		"-------\n"
+		"float\n"
+		"    The estimated quantile or NaN if there are no statistics.");
+	py_analog_time_signal.def("histogram",
+		[](const sv::data::AnalogTimeSignal &self) {
+			const sv::data::SignalStatistics statistics = self.statistics();
+			return std::make_tuple(statistics.histogram_lower(),
+				statistics.histogram_bin_width(), statistics.histogram());
+		},
+		"Return the histogram of all sample values. The statistics must be enabled with "
+		"`set_statistics_enabled()`.\n\n"
+		"Returns\n"
+		"-------\n"
+		"Tuple[float, float, List[int]]\n"
+		"    The histogram with 1. the lower edge of the first bin, 2. the bin width and 3. the counts per bin.");
 
 	py::class_<sv::data::AnalogSampleSignal, std::shared_ptr<sv::data::AnalogSampleSignal>> py_analog_sample_signal(module, "AnalogSampleSignal", py_base_signal);
 	py_analog_sample_signal.doc() = "A signal with key-value pairs.";
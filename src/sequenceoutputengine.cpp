@@ -0,0 +1,211 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <QDateTime>
+#include <QVariant>
+
+#include "sequenceoutputengine.hpp"
+#include "src/session.hpp"
+#include "src/workerpool.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/properties/doubleproperty.hpp"
+
+using std::lock_guard;
+using std::make_unique;
+using std::unique_lock;
+using std::chrono::duration;
+using std::chrono::duration_cast;
+
+namespace sv {
+
+const steady_clock::duration SequenceOutputEngine::SpinTime =
+	std::chrono::microseconds(200);
+
+SequenceOutputEngine::SequenceOutputEngine(QObject *parent) :
+	QObject(parent),
+	repeat_count_(0),
+	start_timestamp_(0),
+	stop_(false),
+	running_(false),
+	position_(0),
+	set_scheduled_(false)
+{
+}
+
+SequenceOutputEngine::~SequenceOutputEngine()
+{
+	stop();
+}
+
+void SequenceOutputEngine::start(
+	shared_ptr<data::properties::DoubleProperty> property,
+	vector<SequenceStep> steps, unsigned int repeat_count,
+	shared_ptr<data::AnalogTimeSignal> jitter_signal)
+{
+	stop();
+
+	if (!property || steps.empty())
+		return;
+
+	property_ = property;
+	steps_ = std::move(steps);
+	repeat_count_ = repeat_count;
+	jitter_signal_ = jitter_signal;
+	position_ = 0;
+	set_scheduled_ = false;
+	pending_value_.deadlines.clear();
+	{
+		lock_guard<mutex> lock(stop_mutex_);
+		stop_ = false;
+	}
+	set_strand_ = make_unique<WorkerStrand>(Session::worker_pool);
+
+	start_timestamp_ = QDateTime::currentMSecsSinceEpoch() / (double)1000;
+	start_time_ = steady_clock::now();
+	running_ = true;
+	thread_ = std::thread(&SequenceOutputEngine::run, this);
+}
+
+void SequenceOutputEngine::stop()
+{
+	{
+		lock_guard<mutex> lock(stop_mutex_);
+		stop_ = true;
+	}
+	stop_cv_.notify_all();
+
+	if (thread_.joinable())
+		thread_.join();
+	// Wait for a running set, a value that is still pending is dropped.
+	set_strand_.reset();
+	running_ = false;
+}
+
+bool SequenceOutputEngine::is_running() const
+{
+	return running_;
+}
+
+size_t SequenceOutputEngine::position() const
+{
+	return position_;
+}
+
+void SequenceOutputEngine::run()
+{
+	steady_clock::time_point deadline = start_time_;
+	unsigned int cycle = 0;
+	bool has_steps;
+	do {
+		has_steps = false;
+		for (size_t pos=0; pos<steps_.size(); ++pos) {
+			const steady_clock::duration delay =
+				duration_cast<steady_clock::duration>(
+					duration<double>(steps_[pos].delay));
+			if (delay <= steady_clock::duration::zero())
+				continue;
+
+			if (!wait_until(deadline))
+				return;
+			position_ = pos;
+			post_value(steps_[pos].value, deadline);
+			// Advance the absolute deadline, so the error of this step
+			// doesn't delay the following steps.
+			deadline += delay;
+			has_steps = true;
+		}
+		++cycle;
+	}
+	while (has_steps && (repeat_count_ == 0 || cycle < repeat_count_));
+
+	// Hold the last value for its delay.
+	if (has_steps && !wait_until(deadline))
+		return;
+
+	running_ = false;
+	Q_EMIT finished();
+}
+
+bool SequenceOutputEngine::wait_until(steady_clock::time_point deadline)
+{
+	{
+		// Sleep until shortly before the deadline and spin for the rest, the
+		// wake up latency of the scheduler is too high for short steps.
+		unique_lock<mutex> lock(stop_mutex_);
+		if (stop_cv_.wait_until(lock, deadline - SpinTime,
+				[this] { return stop_; }))
+			return false;
+	}
+	while (steady_clock::now() < deadline)
+		std::this_thread::yield();
+
+	return true;
+}
+
+void SequenceOutputEngine::post_value(
+	double value, steady_clock::time_point deadline)
+{
+	{
+		lock_guard<mutex> lock(pending_mutex_);
+		pending_value_.value = value;
+		pending_value_.deadlines.push_back(deadline);
+	}
+	// Only one set is queued at a time. If the device is slower than the
+	// sequence, the queued set picks up the newest value.
+	if (set_scheduled_.exchange(true))
+		return;
+	set_strand_->post([this]() { set_pending_value(); });
+}
+
+void SequenceOutputEngine::set_pending_value()
+{
+	PendingValue pending_value;
+	{
+		lock_guard<mutex> lock(pending_mutex_);
+		pending_value.value = pending_value_.value;
+		pending_value.deadlines.swap(pending_value_.deadlines);
+		set_scheduled_ = false;
+	}
+
+	const steady_clock::time_point set_time = steady_clock::now();
+	property_->change_value(QVariant(pending_value.value));
+
+	if (!jitter_signal_)
+		return;
+
+	// The jitter is the time between the deadline of the step and the start
+	// of the set command. Steps, that were skipped because the device was
+	// too slow, get the time until their value was replaced, so there is a
+	// sample for every step. The samples are stamped with the deadlines.
+	for (const auto &deadline : pending_value.deadlines) {
+		double jitter = duration<double>(set_time - deadline).count();
+		const double timestamp = start_timestamp_ +
+			duration<double>(deadline - start_time_).count();
+		jitter_signal_->push_sample(&jitter, timestamp, sizeof(double), 7, 6);
+	}
+}
+
+} // namespace sv
@@ -0,0 +1,142 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SEQUENCEOUTPUTENGINE_HPP
+#define SEQUENCEOUTPUTENGINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QObject>
+
+using std::atomic;
+using std::chrono::steady_clock;
+using std::condition_variable;
+using std::mutex;
+using std::shared_ptr;
+using std::unique_ptr;
+using std::vector;
+
+namespace sv {
+
+class WorkerStrand;
+
+namespace data {
+class AnalogTimeSignal;
+namespace properties {
+class DoubleProperty;
+}
+}
+
+/** One step of an output sequence. */
+struct SequenceStep
+{
+	double value;
+	/** Time in seconds until the next step is set. */
+	double delay;
+};
+
+/**
+ * The SequenceOutputEngine sets the values of a sequence to a property on
+ * its own thread. The steps are scheduled with absolute deadlines on the
+ * steady clock, so the timing errors of the single steps don't add up over
+ * the sequence.
+ *
+ * The values are set on a WorkerStrand, so a slow device doesn't delay the
+ * scheduler. If the device can't keep up, only the newest value is set. The
+ * set time error of every step can be recorded into a signal, a skipped step
+ * is recorded with the time until the value, that replaced it, was set.
+ */
+class SequenceOutputEngine : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit SequenceOutputEngine(QObject *parent = nullptr);
+	~SequenceOutputEngine();
+
+	/**
+	 * Start to output the sequence. A running sequence is stopped first.
+	 *
+	 * @param[in] property The property the values are set to.
+	 * @param[in] steps The sequence. Steps without a delay are skipped.
+	 * @param[in] repeat_count How often the sequence is run, 0 = infinite.
+	 * @param[in] jitter_signal The signal for the set time errors. Must be
+	 *                          created in the GUI thread, can be nullptr.
+	 */
+	void start(shared_ptr<data::properties::DoubleProperty> property,
+		vector<SequenceStep> steps, unsigned int repeat_count,
+		shared_ptr<data::AnalogTimeSignal> jitter_signal);
+	/** Stop the sequence and wait until the engine thread has finished. */
+	void stop();
+	bool is_running() const;
+	/** Return the index of the step, that was scheduled last. */
+	size_t position() const;
+
+private:
+	/** The time before a deadline, that is spent spinning instead sleeping. */
+	static const steady_clock::duration SpinTime;
+
+	struct PendingValue
+	{
+		double value;
+		/** The deadlines of all steps since the last set. */
+		vector<steady_clock::time_point> deadlines;
+	};
+
+	void run();
+	/** Sleep until the deadline. Return false, if the engine was stopped. */
+	bool wait_until(steady_clock::time_point deadline);
+	void post_value(double value, steady_clock::time_point deadline);
+	void set_pending_value();
+
+	shared_ptr<data::properties::DoubleProperty> property_;
+	shared_ptr<data::AnalogTimeSignal> jitter_signal_;
+	vector<SequenceStep> steps_;
+	unsigned int repeat_count_;
+	/** Relates the steady clock to the epoch timestamps of the channels. */
+	steady_clock::time_point start_time_;
+	double start_timestamp_;
+
+	std::thread thread_;
+	mutex stop_mutex_;
+	condition_variable stop_cv_;
+	bool stop_;
+	atomic<bool> running_;
+	atomic<size_t> position_;
+
+	unique_ptr<WorkerStrand> set_strand_;
+	mutex pending_mutex_;
+	PendingValue pending_value_;
+	atomic<bool> set_scheduled_;
+
+Q_SIGNALS:
+	/** Emitted from the engine thread, when the sequence has ended. */
+	void finished();
+
+};
+
+} // namespace sv
+
+#endif // SEQUENCEOUTPUTENGINE_HPP
@@ -31,10 +31,12 @@
 #include "config.h"
 #include "src/devicemanager.hpp"
 #include "src/util.hpp"
+#include "src/workerpool.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/hardwaredevice.hpp"
 #include "src/devices/userdevice.hpp"
 #include "src/python/smuscriptrunner.hpp"
+#include "src/ui/widgets/plot/plotrefreshscheduler.hpp"
 
 using std::list;
 using std::make_pair;
@@ -52,11 +54,16 @@ namespace sv {
 
 shared_ptr<sigrok::Context> Session::sr_context;
 double Session::session_start_timestamp = .0;
+shared_ptr<WorkerPool> Session::worker_pool;
 
 Session::Session(DeviceManager &device_manager) :
 	device_manager_(device_manager)
 {
+	worker_pool = make_shared<WorkerPool>();
+
 	smu_script_runner_ = make_shared<python::SmuScriptRunner>(*this);
+	plot_refresh_scheduler_ =
+		make_shared<ui::widgets::plot::PlotRefreshScheduler>();
 	connect(smu_script_runner_.get(), &python::SmuScriptRunner::script_error,
 		this, &Session::error_handler);
 
@@ -70,6 +77,9 @@ Session::~Session()
 {
 	for (auto &device_pair_ : device_map_)
 		device_pair_.second->close();
+
+	// The pool itself is destroyed, when the last strand is gone.
+	worker_pool.reset();
 }
 
 DeviceManager &Session::device_manager()
@@ -158,6 +168,12 @@ shared_ptr<python::SmuScriptRunner> Session::smu_script_runner()
 	return smu_script_runner_;
 }
 
+shared_ptr<ui::widgets::plot::PlotRefreshScheduler>
+	Session::plot_refresh_scheduler()
+{
+	return plot_refresh_scheduler_;
+}
+
 void Session::run_smu_script(const string &script_file)
 {
 	smu_script_runner_->run(script_file);
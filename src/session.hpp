@@ -41,6 +41,7 @@ namespace sv {
 
 class DeviceManager;
 class MainWindow;
+class WorkerPool;
 
 namespace devices {
 class BaseDevice;
@@ -51,6 +52,13 @@ class UserDevice;
 namespace python {
 class SmuScriptRunner;
 }
+namespace ui {
+namespace widgets {
+namespace plot {
+class PlotRefreshScheduler;
+}
+}
+}
 
 class Session : public QObject
 {
@@ -60,6 +68,11 @@ public:
 	static shared_ptr<sigrok::Context> sr_context;
 	// TODO: use std::chrono / std::time
 	static double session_start_timestamp;
+	/**
+	 * The session wide worker pool for the processing of derived signals
+	 * (math channels, XY curves, ...).
+	 */
+	static shared_ptr<WorkerPool> worker_pool;
 
 public:
 	explicit Session(DeviceManager &device_manager);
@@ -76,6 +89,8 @@ public:
 	void remove_device(shared_ptr<devices::BaseDevice> device);
 
 	shared_ptr<python::SmuScriptRunner> smu_script_runner();
+	/** Return the refresh scheduler, that is shared by all plots. */
+	shared_ptr<ui::widgets::plot::PlotRefreshScheduler> plot_refresh_scheduler();
 	void run_smu_script(const string &script_file);
 
 	void set_main_window(MainWindow *main_window);
@@ -86,6 +101,7 @@ private:
 	map<string, shared_ptr<devices::BaseDevice>> device_map_;
 	MainWindow *main_window_;
 	shared_ptr<python::SmuScriptRunner> smu_script_runner_;
+	shared_ptr<ui::widgets::plot::PlotRefreshScheduler> plot_refresh_scheduler_;
 
 	void free_unused_memory();
 
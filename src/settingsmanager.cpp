@@ -18,8 +18,11 @@
  */
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <QDebug>
 #include <QSettings>
@@ -33,12 +36,81 @@
 #include "src/devices/configurable.hpp"
 #include "src/devices/deviceutil.hpp"
 
+using std::lock_guard;
+using std::mutex;
 using std::shared_ptr;
 using std::string;
+using std::unordered_map;
+using std::weak_ptr;
 using sv::devices::DeviceType;
 
 namespace sv {
 
+namespace {
+
+/*
+ * Hash index for the restored configurables, channels and signals. When a
+ * big layout is restored, the same objects are looked up many times and
+ * every lookup in the maps of the devices and channels would copy the map.
+ *
+ * The objects are only referenced weakly, an expired or changed entry is
+ * looked up again. Expired entries are erased on a miss and every time the
+ * index has doubled its size, so the index doesn't grow with every device
+ * that was ever restored.
+ */
+template<typename T>
+struct RestoreIndex
+{
+	unordered_map<string, weak_ptr<T>> map;
+	size_t prune_size = 64;
+};
+
+mutex restore_index_mutex;
+RestoreIndex<devices::Configurable> configurable_index;
+RestoreIndex<channels::BaseChannel> channel_index;
+RestoreIndex<data::BaseSignal> signal_index;
+
+template<typename T>
+shared_ptr<T> find_in_index(RestoreIndex<T> &index, const string &key)
+{
+	lock_guard<mutex> lock(restore_index_mutex);
+	const auto it = index.map.find(key);
+	if (it == index.map.end())
+		return nullptr;
+	auto object = it->second.lock();
+	if (!object)
+		index.map.erase(it);
+	return object;
+}
+
+template<typename T>
+void add_to_index(RestoreIndex<T> &index, const string &key,
+	const shared_ptr<T> &object)
+{
+	lock_guard<mutex> lock(restore_index_mutex);
+	index.map[key] = object;
+	if (index.map.size() < index.prune_size)
+		return;
+
+	for (auto it = index.map.begin(); it != index.map.end();) {
+		if (it->second.expired())
+			it = index.map.erase(it);
+		else
+			++it;
+	}
+	index.prune_size = std::max<size_t>(64, 2 * index.map.size());
+}
+
+string device_index_key(const shared_ptr<devices::BaseDevice> &device)
+{
+	// The address separates devices with the same id (e.g. a reconnected
+	// device), the id separates a new device at the address of a deleted one.
+	return std::to_string(reinterpret_cast<uintptr_t>(device.get())) + "|" +
+		device->id();
+}
+
+} // namespace
+
 bool SettingsManager::restore_settings_ = true;
 
 SettingsManager::SettingsManager()
@@ -154,10 +226,12 @@ std::shared_ptr< sv::devices::BaseDevice > sv::SettingsManager::restore_device(
 	// If a device (key) is stored in the settings, it means, that this device
 	// differs from the device (origin_device) this tab belongs to.
 	string device_id = settings.value(device_key).toString().toStdString();
-	if (session.device_map().count(device_id) == 0)
+	const auto device_map = session.device_map();
+	const auto it = device_map.find(device_id);
+	if (it == device_map.end())
 		return nullptr;
 
-	return session.device_map()[device_id];
+	return it->second;
 }
 
 shared_ptr<devices::Configurable> SettingsManager::restore_configurable(
@@ -176,10 +250,19 @@ shared_ptr<devices::Configurable> SettingsManager::restore_configurable(
 		return nullptr;
 
 	string conf_id = settings.value(configurable_key).toString().toStdString();
-	if (device->configurable_map().count(conf_id) == 0)
+	const string index_key = device_index_key(device) + "|" + conf_id;
+	auto configurable = find_in_index(configurable_index, index_key);
+	if (configurable &&
+			configurable->device_settings_id() == device->settings_id())
+		return configurable;
+
+	const auto configurable_map = device->configurable_map();
+	const auto it = configurable_map.find(conf_id);
+	if (it == configurable_map.end())
 		return nullptr;
 
-	return device->configurable_map()[conf_id];
+	add_to_index(configurable_index, index_key, it->second);
+	return it->second;
 }
 
 shared_ptr<data::properties::BaseProperty> SettingsManager::restore_property(
@@ -201,10 +284,12 @@ shared_ptr<data::properties::BaseProperty> SettingsManager::restore_property(
 	//auto sr_type = settings.value(property_key+"_sr_type").value<int>(); // TODO
 	auto sr_ck = settings.value(property_key+"_sr_ck").value<uint32_t>();
 	auto ck = devices::deviceutil::get_config_key(sr_ck);
-	if (configurable->property_map().count(ck) == 0)
+	const auto property_map = configurable->property_map();
+	const auto it = property_map.find(ck);
+	if (it == property_map.end())
 		return nullptr;
 
-	return configurable->property_map()[ck];
+	return it->second;
 }
 
 shared_ptr<channels::BaseChannel> SettingsManager::restore_channel(
@@ -223,10 +308,18 @@ shared_ptr<channels::BaseChannel> SettingsManager::restore_channel(
 		return nullptr;
 
 	string channel_id = settings.value(channel_key).toString().toStdString();
-	if (device->channel_map().count(channel_id) == 0)
+	const string index_key = device_index_key(device) + "|" + channel_id;
+	auto channel = find_in_index(channel_index, index_key);
+	if (channel && channel->parent_device() == device)
+		return channel;
+
+	const auto channel_map = device->channel_map();
+	const auto it = channel_map.find(channel_id);
+	if (it == channel_map.end())
 		return nullptr;
 
-	return device->channel_map()[channel_id];
+	add_to_index(channel_index, index_key, it->second);
+	return it->second;
 }
 
 shared_ptr<data::BaseSignal> SettingsManager::restore_signal(
@@ -247,13 +340,23 @@ shared_ptr<data::BaseSignal> SettingsManager::restore_signal(
 
 	auto sr_q = settings.value(signal_key+"_sr_q").value<uint32_t>();
 	auto sr_qf = settings.value(signal_key+"_sr_qf").value<uint64_t>();
+	const string index_key = std::to_string(
+		reinterpret_cast<uintptr_t>(channel.get())) + "|" +
+		std::to_string(sr_q) + "|" + std::to_string(sr_qf);
+	auto signal = find_in_index(signal_index, index_key);
+	if (signal && signal->parent_channel() == channel)
+		return signal;
+
 	auto mq = make_pair(
 		data::datautil::get_quantity(sr_q),
 		data::datautil::get_quantity_flags(sr_qf));
-	if (channel->signal_map().count(mq) == 0)
+	const auto signal_map = channel->signal_map();
+	const auto it = signal_map.find(mq);
+	if (it == signal_map.end() || it->second.empty())
 		return nullptr;
 
-	return channel->signal_map()[mq][0];
+	add_to_index(signal_index, index_key, it->second[0]);
+	return it->second[0];
 }
 
 } // namespace sv
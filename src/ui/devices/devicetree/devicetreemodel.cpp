@@ -17,12 +17,16 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <QDebug>
+#include <QModelIndex>
 #include <QStandardItem>
 #include <QStandardItemModel>
 #include <QString>
@@ -40,6 +44,8 @@
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::unordered_map;
+using std::vector;
 
 Q_DECLARE_SMART_POINTER_METATYPE(std::shared_ptr)
 
@@ -48,6 +54,31 @@ namespace ui {
 namespace devices {
 namespace devicetree {
 
+namespace {
+
+/**
+ * Compare the sort role data of two items the same way as
+ * QStandardItem::operator<() does it, so inserting an item at its sorted
+ * position results in the same order as sortChildren().
+ */
+bool is_sort_less(const QStandardItem *left, const QStandardItem *right)
+{
+	const QVariant l = left->data(DeviceTreeModel::SortRole);
+	const QVariant r = right->data(DeviceTreeModel::SortRole);
+	switch (l.userType()) {
+	case QMetaType::UnknownType:
+		return r.isValid();
+	case QMetaType::Int:
+		return l.toInt() < r.toInt();
+	case QMetaType::UInt:
+		return l.toUInt() < r.toUInt();
+	default:
+		return l.toString().compare(r.toString(), Qt::CaseSensitive) < 0;
+	}
+}
+
+} // namespace
+
 DeviceTreeModel::DeviceTreeModel(const Session &session,
 		bool is_device_checkable, bool is_channel_group_checkable,
 		bool is_channel_checkable, bool is_signal_checkable,
@@ -82,8 +113,133 @@ void DeviceTreeModel::setup_model()
 		shared_ptr<sv::devices::BaseDevice> device = device_pair.second;
 		add_device(device);
 	}
+}
+
+void DeviceTreeModel::insert_item(QStandardItem *parent_item, TreeItem *item,
+	const void *object)
+{
+	// Binary search for the first child, that is sorted after the new item.
+	// insertRow() notifies the views, so there is no need to sort (and
+	// relayout) all children afterwards.
+	int first = 0;
+	int count = parent_item->rowCount();
+	while (count > 0) {
+		int step = count / 2;
+		if (!is_sort_less(item, parent_item->child(first + step))) {
+			first += step + 1;
+			count -= step + 1;
+		}
+		else {
+			count = step;
+		}
+	}
+	parent_item->insertRow(first, item);
+
+	if (object) {
+		item->set_object(object);
+		object_items_[object].push_back(item);
+	}
+}
+
+void DeviceTreeModel::unregister_item(QStandardItem *item)
+{
+	for (int i=0; i<item->rowCount(); ++i)
+		unregister_item(item->child(i));
+
+	if (item->type() < (int)TreeItemType::DeviceItem ||
+			item->type() > (int)TreeItemType::PropertyItem)
+		return;
+
+	auto *tree_item = static_cast<TreeItem *>(item);
+	const auto it = object_items_.find(tree_item->object());
+	if (it == object_items_.end())
+		return;
+	auto &object_items = it->second;
+	object_items.erase(
+		std::remove(object_items.begin(), object_items.end(), tree_item),
+		object_items.end());
+	if (object_items.empty())
+		object_items_.erase(it);
+}
+
+const vector<TreeItem *> &DeviceTreeModel::items(const void *object) const
+{
+	static const vector<TreeItem *> no_items;
+
+	const auto it = object_items_.find(object);
+	if (it == object_items_.end())
+		return no_items;
+	return it->second;
+}
+
+TreeItem *DeviceTreeModel::unpopulated_device_item(
+	const QModelIndex &parent) const
+{
+	if (!parent.isValid())
+		return nullptr;
+
+	auto *item = itemFromIndex(parent);
+	if (!item || item->type() != (int)TreeItemType::DeviceItem)
+		return nullptr;
+
+	auto *device_item = static_cast<TreeItem *>(item);
+	if (device_item->is_populated())
+		return nullptr;
+	return device_item;
+}
+
+bool DeviceTreeModel::hasChildren(const QModelIndex &parent) const
+{
+	// Show the expand indicator for devices, that are not populated yet
+	TreeItem *device_item = unpopulated_device_item(parent);
+	if (device_item) {
+		auto device = device_item->data(DeviceTreeModel::DataRole).
+			value<shared_ptr<sv::devices::BaseDevice>>();
+		return !device->channel_map().empty() ||
+			(show_configurable_ && !device->configurable_map().empty());
+	}
 
-	invisibleRootItem()->sortChildren(0);
+	return QStandardItemModel::hasChildren(parent);
+}
+
+bool DeviceTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+	if (unpopulated_device_item(parent))
+		return true;
+
+	return QStandardItemModel::canFetchMore(parent);
+}
+
+void DeviceTreeModel::fetchMore(const QModelIndex &parent)
+{
+	TreeItem *device_item = unpopulated_device_item(parent);
+	if (device_item) {
+		populate_device(device_item);
+		return;
+	}
+
+	QStandardItemModel::fetchMore(parent);
+}
+
+void DeviceTreeModel::populate_device(TreeItem *device_item)
+{
+	std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+	device_item->set_populated(true);
+
+	auto device = device_item->data(DeviceTreeModel::DataRole).
+		value<shared_ptr<sv::devices::BaseDevice>>();
+
+	// Channels and ChannelGroups
+	for (const auto &channel_pair : device->channel_map()) {
+		add_channel(channel_pair.second,
+			channel_pair.second->channel_group_names(), device_item);
+	}
+
+	// Configurables and ConfigKeys
+	for (const auto &configurable_pair : device->configurable_map()) {
+		add_configurable(configurable_pair.second, device_item);
+	}
 }
 
 void DeviceTreeModel::add_device(shared_ptr<sv::devices::BaseDevice> device)
@@ -97,33 +253,23 @@ void DeviceTreeModel::add_device(shared_ptr<sv::devices::BaseDevice> device)
 	// Look for existing device
 	TreeItem *device_item = find_device(device);
 	if (!device_item) {
-		beginInsertRows(invisibleRootItem()->index(),
-			invisibleRootItem()->rowCount(), invisibleRootItem()->rowCount()+1);
 		device_item = new TreeItem(TreeItemType::DeviceItem);
 		device_item->setText(device->full_name());
 		device_item->setData(QVariant::fromValue(device), DeviceTreeModel::DataRole);
 		device_item->setData(device->full_name(), DeviceTreeModel::SortRole);
 		device_item->setCheckable(is_device_checkable_);
 		device_item->setEditable(false);
-		invisibleRootItem()->appendRow(device_item);
-		endInsertRows();
-
-		invisibleRootItem()->sortChildren(0);
+		// The channels, signals and configurables are added on demand
+		device_item->set_populated(false);
+		insert_item(invisibleRootItem(), device_item, device.get());
 
 		connect(device.get(), &sv::devices::BaseDevice::channel_added,
-			this, &DeviceTreeModel::on_channel_added);
-	}
-
-	// Channels and ChannelGroups
-	for (const auto &channel_pair : device->channel_map()) {
-		add_channel(channel_pair.second,
-			channel_pair.second->channel_group_names(), device_item);
+			this, &DeviceTreeModel::on_channel_added, Qt::UniqueConnection);
+		return;
 	}
 
-	// Configurables and ConfigKeys
-	for (const auto &configurable_pair : device->configurable_map()) {
-		add_configurable(configurable_pair.second, device_item);
-	}
+	if (device_item->is_populated())
+		populate_device(device_item);
 }
 
 TreeItem *DeviceTreeModel::add_channel_group(const string &channel_group_name,
@@ -140,18 +286,13 @@ TreeItem *DeviceTreeModel::add_channel_group(const string &channel_group_name,
 	std::lock_guard<std::recursive_mutex> lock(mutex_);
 
 	QString chg_name_qstr = QString::fromStdString(channel_group_name);
-	beginInsertRows(device_item->index(),
-		device_item->rowCount(), device_item->rowCount()+1);
 	chg_item = new TreeItem(TreeItemType::ChannelGroupItem);
 	chg_item->setText(chg_name_qstr);
 	chg_item->setData(chg_name_qstr, DeviceTreeModel::DataRole);
 	chg_item->setData(chg_name_qstr, DeviceTreeModel::SortRole);
 	chg_item->setCheckable(is_channel_group_checkable_);
 	chg_item->setEditable(false);
-	device_item->appendRow(chg_item);
-	endInsertRows();
-
-	device_item->sortChildren(0);
+	insert_item(device_item, chg_item, nullptr);
 
 	return chg_item;
 }
@@ -161,12 +302,8 @@ void DeviceTreeModel::add_channel(shared_ptr<channels::BaseChannel> channel,
 {
 	std::lock_guard<std::recursive_mutex> lock(mutex_);
 
-	// Find existing channel in all channel groups
-	// NOLINTNEXTLINE(readability-implicit-bool-conversion)
-	if (!find_channel(channel, channel->channel_group_names(), parent_item)) {
-		connect(channel.get(), &channels::BaseChannel::signal_added,
-			this, &DeviceTreeModel::on_signal_added);
-	}
+	connect(channel.get(), &channels::BaseChannel::signal_added,
+		this, &DeviceTreeModel::on_signal_added, Qt::UniqueConnection);
 
 	for (const auto &chg_name : channel_group_names) {
 		TreeItem *new_parent_item = add_channel_group(chg_name, parent_item);
@@ -175,18 +312,13 @@ void DeviceTreeModel::add_channel(shared_ptr<channels::BaseChannel> channel,
 		set<string> chg_names { chg_name };
 		TreeItem *channel_item = find_channel(channel, chg_names, parent_item);
 		if (!channel_item) {
-			beginInsertRows(new_parent_item->index(),
-				new_parent_item->rowCount(), new_parent_item->rowCount()+1);
 			channel_item = new TreeItem(TreeItemType::ChannelItem);
 			channel_item->setText(QString::fromStdString(channel->name()));
 			channel_item->setData(QVariant::fromValue(channel), DeviceTreeModel::DataRole);
 			channel_item->setData(channel->index(), DeviceTreeModel::SortRole);
 			channel_item->setCheckable(is_channel_checkable_);
 			channel_item->setEditable(false);
-			new_parent_item->appendRow(channel_item);
-			endInsertRows();
-
-			new_parent_item->sortChildren(0);
+			insert_item(new_parent_item, channel_item, channel.get());
 		}
 
 		// Signals
@@ -206,18 +338,13 @@ void DeviceTreeModel::add_signal(shared_ptr<sv::data::BaseSignal> signal,
 	// Look for existing signal
 	TreeItem *signal_item = find_signal(signal, parent_item);
 	if (!signal_item) {
-		beginInsertRows(parent_item->index(),
-			parent_item->rowCount(), parent_item->rowCount()+1);
 		signal_item = new TreeItem(TreeItemType::SignalItem);
 		signal_item->setText(signal->display_name());
 		signal_item->setData(QVariant::fromValue(signal), DeviceTreeModel::DataRole);
 		signal_item->setData(signal->display_name(), DeviceTreeModel::SortRole); // TODO: signal->index()
 		signal_item->setCheckable(is_signal_checkable_);
 		signal_item->setEditable(false);
-		parent_item->appendRow(signal_item);
-		endInsertRows();
-
-		parent_item->sortChildren(0);
+		insert_item(parent_item, signal_item, signal.get());
 	}
 }
 
@@ -236,18 +363,13 @@ void DeviceTreeModel::add_configurable(
 			configurable->name(), device_item);
 
 		// Add configurable item
-		beginInsertRows(new_parent_item->index(),
-			new_parent_item->rowCount(), new_parent_item->rowCount()+1);
 		conf_item = new TreeItem(TreeItemType::ConfigurableItem);
 		conf_item->setText(configurable->display_name());
 		conf_item->setData(QVariant::fromValue(configurable), DeviceTreeModel::DataRole);
 		conf_item->setData(configurable->index(), DeviceTreeModel::SortRole);
 		conf_item->setCheckable(false);
 		conf_item->setEditable(false);
-		new_parent_item->appendRow(conf_item);
-		endInsertRows();
-
-		new_parent_item->sortChildren(0);
+		insert_item(new_parent_item, conf_item, configurable.get());
 	}
 
 	// ConfigKeys
@@ -268,45 +390,59 @@ void DeviceTreeModel::add_property(
 	// Look for existing property
 	TreeItem *property_item = find_property(property, configurable_item);
 	if (!property_item) {
-		beginInsertRows(configurable_item->index(),
-			configurable_item->rowCount(), configurable_item->rowCount()+1);
 		property_item = new TreeItem(TreeItemType::PropertyItem);
 		property_item->setText(property->display_name());
 		property_item->setData(QVariant::fromValue(property), DeviceTreeModel::DataRole);
 		property_item->setData(property->display_name(), DeviceTreeModel::SortRole);
 		property_item->setCheckable(is_signal_checkable_);
 		property_item->setEditable(false);
-		configurable_item->appendRow(property_item);
-		endInsertRows();
-
-		configurable_item->sortChildren(0);
+		insert_item(configurable_item, property_item, property.get());
 	}
 }
 
 TreeItem *DeviceTreeModel::find_device(
 	shared_ptr<sv::devices::BaseDevice> device) const
 {
-	for (int i=0; i<invisibleRootItem()->rowCount(); ++i) {
-		auto *child = invisibleRootItem()->child(i);
-		if (child->type() != (int)TreeItemType::DeviceItem)
-			continue;
+	const auto &device_items = items(device.get());
+	if (device_items.empty())
+		return nullptr;
+	return device_items.front();
+}
 
-		if (device.get() == child->data(DeviceTreeModel::DataRole).
-				value<shared_ptr<sv::devices::BaseDevice>>().get())
-			return static_cast<TreeItem *>(child);
+vector<TreeItem *> DeviceTreeModel::find_channel_items(
+	shared_ptr<sv::channels::BaseChannel> channel)
+{
+	TreeItem *device_item = find_device(channel->parent_device());
+	if (device_item && !device_item->is_populated())
+		populate_device(device_item);
+
+	return items(channel.get());
+}
+
+vector<TreeItem *> DeviceTreeModel::find_signal_items(
+	shared_ptr<sv::data::BaseSignal> signal)
+{
+	auto channel = signal->parent_channel();
+	if (channel) {
+		TreeItem *device_item = find_device(channel->parent_device());
+		if (device_item && !device_item->is_populated())
+			populate_device(device_item);
 	}
-	return nullptr;
+
+	return items(signal.get());
 }
 
 TreeItem *DeviceTreeModel::find_channel_group(const string &channel_group_name,
 	TreeItem *parent_item) const
 {
+	// There are only a few channel groups per device, so a linear search
+	// is sufficient.
+	QString chg_name_qstr = QString::fromStdString(channel_group_name);
 	for (int i=0; i<parent_item->rowCount(); ++i) {
 		auto *child = parent_item->child(i);
 		if (child->type() != (int)TreeItemType::ChannelGroupItem)
 			continue;
 
-		QString chg_name_qstr = QString::fromStdString(channel_group_name);
 		if (chg_name_qstr == child->data(DeviceTreeModel::DataRole).toString())
 			return static_cast<TreeItem *>(child);
 	}
@@ -317,24 +453,17 @@ TreeItem *DeviceTreeModel::find_channel(
 	shared_ptr<sv::channels::BaseChannel> channel,
 	const set<string> &channel_group_names, TreeItem *parent_item) const
 {
-	TreeItem *new_parent_item;
 	for (const auto &chg_name : channel_group_names) {
+		QStandardItem *new_parent_item = parent_item;
 		if (!chg_name.empty()) {
 			new_parent_item = find_channel_group(chg_name, parent_item);
 			if (!new_parent_item)
 				continue;
 		}
-		else
-			new_parent_item = parent_item;
 
-		for (int i=0; i<new_parent_item->rowCount(); ++i) {
-			auto *child = new_parent_item->child(i);
-			if (child->type() != (int)TreeItemType::ChannelItem)
-				continue;
-
-			if (channel.get() == child->data(DeviceTreeModel::DataRole).
-					value<shared_ptr<sv::channels::BaseChannel>>().get())
-				return static_cast<TreeItem *>(child);
+		for (auto *item : items(channel.get())) {
+			if (item->parent() == new_parent_item)
+				return item;
 		}
 	}
 	return nullptr;
@@ -343,14 +472,9 @@ TreeItem *DeviceTreeModel::find_channel(
 TreeItem *DeviceTreeModel::find_signal (
 	shared_ptr<sv::data::BaseSignal> signal, TreeItem *parent_item) const
 {
-	for (int i=0; i<parent_item->rowCount(); ++i) {
-		auto *child = parent_item->child(i);
-		if (child->type() != (int)TreeItemType::SignalItem)
-			continue;
-
-		if (signal.get() == child->data(DeviceTreeModel::DataRole).
-				value<shared_ptr<sv::data::BaseSignal>>().get())
-			return static_cast<TreeItem *>(child);
+	for (auto *item : items(signal.get())) {
+		if (item->parent() == parent_item)
+			return item;
 	}
 	return nullptr;
 }
@@ -359,7 +483,7 @@ TreeItem *DeviceTreeModel::find_configurable(
 	shared_ptr<sv::devices::Configurable> configurable,
 	TreeItem *device_item) const
 {
-	TreeItem *new_parent_item;
+	QStandardItem *new_parent_item;
 	if (!configurable->name().empty()) {
 		new_parent_item = find_channel_group(configurable->name(), device_item);
 		if (!new_parent_item)
@@ -369,14 +493,9 @@ TreeItem *DeviceTreeModel::find_configurable(
 		new_parent_item = device_item;
 	}
 
-	for (int i=0; i<new_parent_item->rowCount(); ++i) {
-		auto *child = new_parent_item->child(i);
-		if (child->type() != (int)TreeItemType::ConfigurableItem)
-			continue;
-
-		if (configurable.get() == child->data(DeviceTreeModel::DataRole).
-				value<shared_ptr<sv::devices::Configurable>>().get())
-			return static_cast<TreeItem *>(child);
+	for (auto *item : items(configurable.get())) {
+		if (item->parent() == new_parent_item)
+			return item;
 	}
 	return nullptr;
 }
@@ -385,14 +504,9 @@ TreeItem *DeviceTreeModel::find_property(
 	shared_ptr<sv::data::properties::BaseProperty> property,
 	TreeItem *configurable_item) const
 {
-	for (int i=0; i<configurable_item->rowCount(); ++i) {
-		auto *child = configurable_item->child(i);
-		if (child->type() != (int)TreeItemType::PropertyItem)
-			continue;
-
-		if (property.get() == child->data(DeviceTreeModel::DataRole).
-				value<shared_ptr<sv::data::properties::BaseProperty>>().get())
-			return static_cast<TreeItem *>(child);
+	for (auto *item : items(property.get())) {
+		if (item->parent() == configurable_item)
+			return item;
 	}
 	return nullptr;
 }
@@ -410,6 +524,7 @@ void DeviceTreeModel::on_device_removed(
 
 	TreeItem *item = find_device(device);
 	if (item) {
+		unregister_item(item);
 		removeRow(item->row(), invisibleRootItem()->index());
 	}
 }
@@ -420,6 +535,8 @@ void DeviceTreeModel::on_channel_added(
 	shared_ptr<sv::devices::BaseDevice> device = channel->parent_device();
 	// Device must exist
 	TreeItem *device_item = find_device(device);
+	if (!device_item || !device_item->is_populated())
+		return;
 	add_channel(channel, channel->channel_group_names(), device_item);
 }
 
@@ -432,8 +549,14 @@ void DeviceTreeModel::on_channel_removed(
 
 void DeviceTreeModel::on_signal_added(shared_ptr<sv::data::BaseSignal> signal)
 {
+	std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+	// Add the signal to all items of the channel. When the channel has no
+	// items yet, the device isn't populated and the signal is added later.
 	shared_ptr<sv::channels::BaseChannel> channel = signal->parent_channel();
-	on_channel_added(channel);
+	const vector<TreeItem *> channel_items = items(channel.get());
+	for (auto *channel_item : channel_items)
+		add_signal(signal, channel_item);
 }
 
 void DeviceTreeModel::on_signal_removed(shared_ptr<sv::data::BaseSignal> signal)
@@ -24,14 +24,17 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <QModelIndex>
 #include <QStandardItem>
 #include <QStandardItemModel>
 
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::unordered_map;
 using std::vector;
 
 namespace sv {
@@ -58,6 +61,14 @@ namespace devicetree {
 
 class TreeItem;
 
+/**
+ * The device tree model is updated incrementally: Items are inserted at
+ * their sorted position when devices, channels or signals are added, and
+ * all items can be looked up by their object in O(1).
+ *
+ * The children of a device item are only added to the model, when the device
+ * item is expanded (see fetchMore()) or when they are looked up.
+ */
 class DeviceTreeModel : public QStandardItemModel
 {
 	Q_OBJECT
@@ -70,6 +81,22 @@ public:
 		bool show_configurable, QObject *parent = nullptr);
 
 	TreeItem *find_device(shared_ptr<sv::devices::BaseDevice> device) const;
+	/**
+	 * Return all items of the channel (one per channel group). The parent
+	 * device item is populated if necessary.
+	 */
+	vector<TreeItem *> find_channel_items(
+		shared_ptr<sv::channels::BaseChannel> channel);
+	/**
+	 * Return all items of the signal. The parent device item is populated if
+	 * necessary.
+	 */
+	vector<TreeItem *> find_signal_items(
+		shared_ptr<sv::data::BaseSignal> signal);
+
+	bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+	bool canFetchMore(const QModelIndex &parent) const override;
+	void fetchMore(const QModelIndex &parent) override;
 
 	const static int DataRole = Qt::UserRole + 1;
 	const static int SortRole = Qt::UserRole + 2;
@@ -77,6 +104,15 @@ public:
 private:
 	void setup_model();
 
+	/** Insert the item at its sorted position and register its object. */
+	void insert_item(QStandardItem *parent_item, TreeItem *item,
+		const void *object);
+	/** Unregister the objects of the item and all its children. */
+	void unregister_item(QStandardItem *item);
+	const vector<TreeItem *> &items(const void *object) const;
+	TreeItem *unpopulated_device_item(const QModelIndex &parent) const;
+	void populate_device(TreeItem *device_item);
+
 	void add_device(shared_ptr<sv::devices::BaseDevice> device);
 	TreeItem *add_channel_group(
 		const string &channel_group_name, TreeItem *device_item);
@@ -110,6 +146,8 @@ private:
 	bool is_configurable_checkable_;
 	bool is_config_key_checkable_;
 	bool show_configurable_;
+	/** All items of an object (device, channel, signal, ...). */
+	unordered_map<const void *, vector<TreeItem *>> object_items_;
 	std::recursive_mutex mutex_;
 
 private Q_SLOTS:
@@ -94,26 +94,14 @@ void DeviceTreeView::check_channels(
 	if (!is_channel_checkable_)
 		return;
 
-	const QList<QStandardItem *> all_items =
-		tree_model_->findItems("", Qt::MatchContains | Qt::MatchRecursive);
-
 	// First uncheck all channels
-	for (const auto &item : all_items) {
-		if (item->type() == (int)TreeItemType::ChannelItem) {
-			item->setCheckState(Qt::Unchecked);
-		}
-	}
+	for (auto *item : checked_items(TreeItemType::ChannelItem))
+		item->setCheckState(Qt::Unchecked);
 
 	// Now check all channels that are in the channels vector
-	for (const auto &item : all_items) {
-		if (item->type() == (int)TreeItemType::ChannelItem) {
-			auto item_data =
-				item->data().value<shared_ptr<sv::channels::BaseChannel>>();
-			for (const auto &channel :channels) {
-				if (item_data.get() == channel.get())
-					item->setCheckState(Qt::Checked);
-			}
-		}
+	for (const auto &channel : channels) {
+		for (auto *item : tree_model_->find_channel_items(channel))
+			item->setCheckState(Qt::Checked);
 	}
 }
 
@@ -125,14 +113,9 @@ vector<shared_ptr<sv::channels::BaseChannel>>
 	if (!is_channel_checkable_)
 		return channels;
 
-	const QList<QStandardItem *> all_items =
-		tree_model_->findItems("", Qt::MatchContains | Qt::MatchRecursive);
-	for (const auto &item : all_items) {
-		if (item->checkState() > 0 &&
-				item->type() == (int)TreeItemType::ChannelItem) {
-			channels.push_back(
-				item->data().value<shared_ptr<sv::channels::BaseChannel>>());
-		}
+	for (const auto *item : checked_items(TreeItemType::ChannelItem)) {
+		channels.push_back(
+			item->data().value<shared_ptr<sv::channels::BaseChannel>>());
 	}
 	return channels;
 }
@@ -143,26 +126,14 @@ void DeviceTreeView::check_signals(
 	if (!is_signal_checkable_)
 		return;
 
-	const QList<QStandardItem *> all_items =
-		tree_model_->findItems("", Qt::MatchContains | Qt::MatchRecursive);
-
 	// First uncheck all signals
-	for (const auto &item : all_items) {
-		if (item->type() == (int)TreeItemType::SignalItem) {
-			item->setCheckState(Qt::Unchecked);
-		}
-	}
+	for (auto *item : checked_items(TreeItemType::SignalItem))
+		item->setCheckState(Qt::Unchecked);
 
 	// Now check all signals that are in the signals vector
-	for (const auto &item : all_items) {
-		if (item->type() == (int)TreeItemType::SignalItem) {
-			auto item_data =
-				item->data().value<shared_ptr<sv::data::BaseSignal>>();
-			for (const auto &signal : signals) {
-				if (item_data.get() == signal.get())
-					item->setCheckState(Qt::Checked);
-			}
-		}
+	for (const auto &signal : signals) {
+		for (auto *item : tree_model_->find_signal_items(signal))
+			item->setCheckState(Qt::Checked);
 	}
 }
 
@@ -174,18 +145,36 @@ vector<shared_ptr<sv::data::BaseSignal>>
 	if (!is_signal_checkable_)
 		return signals;
 
-	const QList<QStandardItem *> all_items =
-		tree_model_->findItems("", Qt::MatchContains | Qt::MatchRecursive);
-	for (const auto &item : all_items) {
-		if (item->checkState() > 0 &&
-				item->type() == (int)TreeItemType::SignalItem) {
-			signals.push_back(
-				item->data().value<shared_ptr<sv::data::BaseSignal>>());
-		}
+	for (const auto *item : checked_items(TreeItemType::SignalItem)) {
+		signals.push_back(
+			item->data().value<shared_ptr<sv::data::BaseSignal>>());
 	}
 	return signals;
 }
 
+vector<QStandardItem *> DeviceTreeView::checked_items(TreeItemType type) const
+{
+	vector<QStandardItem *> items;
+	collect_checked_items(tree_model_->invisibleRootItem(), type, items);
+	return items;
+}
+
+void DeviceTreeView::collect_checked_items(QStandardItem *item,
+	TreeItemType type, vector<QStandardItem *> &items) const
+{
+	// Walk the tree in display order. Items below the requested type (and
+	// devices, that are not populated yet) have no children to visit.
+	for (int i=0; i<item->rowCount(); ++i) {
+		auto *child = item->child(i);
+		if (child->type() == (int)type) {
+			if (child->checkState() > 0)
+				items.push_back(child);
+			continue;
+		}
+		collect_checked_items(child, type, items);
+	}
+}
+
 void DeviceTreeView::expand_device(shared_ptr<sv::devices::BaseDevice> device)
 {
 	TreeItem *item = tree_model_->find_device(device);
@@ -220,7 +209,12 @@ void DeviceTreeView::expand_recursive(QStandardItem *item)
 	if (item->type() == (int)TreeItemType::ConfigurableItem)
 		return;
 
-	this->expand(tree_model_->indexFromItem(item));
+	// Populate the device items first, so the children can be expanded.
+	const QModelIndex index = tree_model_->indexFromItem(item);
+	if (tree_model_->canFetchMore(index))
+		tree_model_->fetchMore(index);
+
+	this->expand(index);
 	for (int i=0; i<item->rowCount(); ++i) {
 		expand_recursive(item->child(i));
 	}
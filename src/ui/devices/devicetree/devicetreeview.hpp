@@ -27,6 +27,8 @@
 #include <QStandardItem>
 #include <QTreeView>
 
+#include "src/ui/devices/devicetree/treeitem.hpp"
+
 using std::shared_ptr;
 using std::vector;
 
@@ -49,7 +51,6 @@ namespace devices {
 namespace devicetree {
 
 class DeviceTreeModel;
-class TreeItem;
 
 class DeviceTreeView : public QTreeView
 {
@@ -77,6 +78,10 @@ public:
 private:
 	void setup_ui();
 	void expand_recursive(QStandardItem *item);
+	/** Return all checked items of the given type in tree order. */
+	vector<QStandardItem *> checked_items(TreeItemType type) const;
+	void collect_checked_items(QStandardItem *item, TreeItemType type,
+		vector<QStandardItem *> &items) const;
 
 	const Session &session_;
 	bool is_device_checkable_;
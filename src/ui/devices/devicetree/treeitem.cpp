@@ -29,7 +29,9 @@ namespace devicetree {
 
 TreeItem::TreeItem(TreeItemType type) :
 	QStandardItem(),
-	type_(type)
+	type_(type),
+	object_(nullptr),
+	populated_(true)
 {
 	if (type == TreeItemType::DeviceItem) {
 		setIcon(QIcon(":/icons/smuview.png"));
@@ -61,6 +63,26 @@ int TreeItem::type() const
 	return (int)type_;
 }
 
+const void *TreeItem::object() const
+{
+	return object_;
+}
+
+void TreeItem::set_object(const void *object)
+{
+	object_ = object;
+}
+
+bool TreeItem::is_populated() const
+{
+	return populated_;
+}
+
+void TreeItem::set_populated(bool populated)
+{
+	populated_ = populated;
+}
+
 } // namespace devicetree
 } // namespace devices
 } // namespace ui
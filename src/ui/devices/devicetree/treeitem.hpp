@@ -45,8 +45,24 @@ public:
 
 	int type() const override;
 
+	/**
+	 * The object (device, channel, signal, ...) this item stands for. Used
+	 * as key for the item lookup in the DeviceTreeModel.
+	 */
+	const void *object() const;
+	void set_object(const void *object);
+
+	/**
+	 * Return false, when the children of this item haven't been added to the
+	 * model yet. They are added lazily, when the item is expanded.
+	 */
+	bool is_populated() const;
+	void set_populated(bool populated);
+
 protected:
 	TreeItemType type_;
+	const void *object_;
+	bool populated_;
 
 };
 
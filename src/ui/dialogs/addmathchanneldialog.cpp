@@ -21,13 +21,17 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
+#include <QCheckBox>
 #include <QComboBox>
 #include <QDebug>
+#include <QDoubleSpinBox>
 #include <QFormLayout>
 #include <QGroupBox>
 #include <QHBoxLayout>
 #include <QMessageBox>
+#include <QRegExp>
 #include <QSizePolicy>
 #include <QSpinBox>
 #include <QString>
@@ -37,14 +41,19 @@
 #include "addmathchanneldialog.hpp"
 #include "src/channels/addscchannel.hpp"
 #include "src/channels/basechannel.hpp"
+#include "src/channels/biquadfilterchannel.hpp"
 #include "src/channels/dividechannel.hpp"
+#include "src/channels/firfilterchannel.hpp"
 #include "src/channels/integratechannel.hpp"
 #include "src/channels/mathchannel.hpp"
 #include "src/channels/movingavgchannel.hpp"
 #include "src/channels/multiplysfchannel.hpp"
 #include "src/channels/multiplysschannel.hpp"
+#include "src/channels/resamplechannel.hpp"
+#include "src/channels/spectrumchannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/fft.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/data/quantitycombobox.hpp"
 #include "src/ui/data/quantityflagslist.hpp"
@@ -57,8 +66,13 @@ using std::make_shared;
 using std::set;
 using std::static_pointer_cast;
 using std::string;
+using std::vector;
 
 Q_DECLARE_SMART_POINTER_METATYPE(std::shared_ptr)
+Q_DECLARE_METATYPE(sv::channels::BiquadFilterType)
+Q_DECLARE_METATYPE(sv::channels::ResampleInterpolation)
+Q_DECLARE_METATYPE(sv::channels::SpectrumMode)
+Q_DECLARE_METATYPE(sv::data::WindowFunction)
 
 namespace sv {
 namespace ui {
@@ -127,6 +141,10 @@ void AddMathChannelDialog::setup_ui()
 	this->setup_ui_add_signal_tab();
 	this->setup_ui_integrate_signal_tab();
 	this->setup_ui_movingavg_signal_tab();
+	this->setup_ui_iir_filter_tab();
+	this->setup_ui_fir_filter_tab();
+	this->setup_ui_resample_tab();
+	this->setup_ui_spectrum_tab();
 	tab_widget_->setCurrentIndex(0);
 	main_layout->addWidget(tab_widget_);
 
@@ -288,6 +306,182 @@ void AddMathChannelDialog::setup_ui_movingavg_signal_tab()
 	tab_widget_->addTab(widget, title);
 }
 
+void AddMathChannelDialog::setup_ui_iir_filter_tab()
+{
+	QString title(tr("IIR Filter"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	iir_signal_ = new ui::devices::SelectSignalWidget(session_);
+	iir_signal_->select_device(device_);
+	s_layout->addWidget(iir_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *f_layout = new QFormLayout();
+	iir_type_box_ = new QComboBox();
+	iir_type_box_->addItem(tr("Low pass"),
+		QVariant::fromValue(channels::BiquadFilterType::LowPass));
+	iir_type_box_->addItem(tr("High pass"),
+		QVariant::fromValue(channels::BiquadFilterType::HighPass));
+	iir_type_box_->addItem(tr("Band pass"),
+		QVariant::fromValue(channels::BiquadFilterType::BandPass));
+	iir_type_box_->addItem(tr("Notch"),
+		QVariant::fromValue(channels::BiquadFilterType::Notch));
+	f_layout->addRow(tr("Type"), iir_type_box_);
+	iir_frequency_box_ = new QDoubleSpinBox();
+	iir_frequency_box_->setDecimals(4);
+	iir_frequency_box_->setRange(0.0001, 1000000000);
+	iir_frequency_box_->setValue(1);
+	iir_frequency_box_->setSuffix(" Hz");
+	f_layout->addRow(tr("Cutoff/Center frequency"), iir_frequency_box_);
+	iir_q_box_ = new QDoubleSpinBox();
+	iir_q_box_->setDecimals(4);
+	iir_q_box_->setRange(0.01, 1000);
+	iir_q_box_->setSingleStep(0.1);
+	iir_q_box_->setValue(0.7071);
+	f_layout->addRow(tr("Q"), iir_q_box_);
+	iir_section_count_box_ = new QSpinBox();
+	iir_section_count_box_->setRange(1, 16);
+	iir_section_count_box_->setValue(1);
+	f_layout->addRow(tr("Sections"), iir_section_count_box_);
+	iir_samplerate_box_ = new QDoubleSpinBox();
+	iir_samplerate_box_->setDecimals(4);
+	iir_samplerate_box_->setRange(0, 1000000000);
+	iir_samplerate_box_->setValue(0);
+	iir_samplerate_box_->setSuffix(" Hz");
+	iir_samplerate_box_->setSpecialValueText(tr("Auto"));
+	f_layout->addRow(tr("Samplerate"), iir_samplerate_box_);
+	layout->addLayout(f_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_fir_filter_tab()
+{
+	QString title(tr("FIR Filter"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	fir_signal_ = new ui::devices::SelectSignalWidget(session_);
+	fir_signal_->select_device(device_);
+	s_layout->addWidget(fir_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *t_layout = new QFormLayout();
+	fir_taps_edit_ = new QLineEdit();
+	fir_taps_edit_->setPlaceholderText(tr("e.g. 0.25, 0.5, 0.25"));
+	t_layout->addRow(tr("Taps"), fir_taps_edit_);
+	layout->addLayout(t_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_resample_tab()
+{
+	QString title(tr("Resample"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	rs_signal_ = new ui::devices::SelectSignalWidget(session_);
+	rs_signal_->select_device(device_);
+	s_layout->addWidget(rs_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *r_layout = new QFormLayout();
+	rs_samplerate_box_ = new QDoubleSpinBox();
+	rs_samplerate_box_->setDecimals(4);
+	rs_samplerate_box_->setRange(0.0001, 1000000000);
+	rs_samplerate_box_->setValue(1);
+	rs_samplerate_box_->setSuffix(" Hz");
+	r_layout->addRow(tr("Samplerate"), rs_samplerate_box_);
+	rs_interpolation_box_ = new QComboBox();
+	rs_interpolation_box_->addItem(tr("Zero-order hold"),
+		QVariant::fromValue(channels::ResampleInterpolation::ZeroOrderHold));
+	rs_interpolation_box_->addItem(tr("Linear"),
+		QVariant::fromValue(channels::ResampleInterpolation::Linear));
+	rs_interpolation_box_->addItem(tr("Windowed sinc"),
+		QVariant::fromValue(channels::ResampleInterpolation::WindowedSinc));
+	rs_interpolation_box_->setCurrentIndex(1);
+	r_layout->addRow(tr("Interpolation"), rs_interpolation_box_);
+	rs_anti_alias_box_ = new QCheckBox(tr("Anti-alias filter"));
+	rs_anti_alias_box_->setChecked(true);
+	r_layout->addRow("", rs_anti_alias_box_);
+	layout->addLayout(r_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_spectrum_tab()
+{
+	QString title(tr("Spectrum"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	sp_signal_ = new ui::devices::SelectSignalWidget(session_);
+	sp_signal_->select_device(device_);
+	s_layout->addWidget(sp_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *f_layout = new QFormLayout();
+	sp_fft_size_box_ = new QComboBox();
+	for (int fft_size=256; fft_size<=65536; fft_size*=2)
+		sp_fft_size_box_->addItem(QString::number(fft_size), fft_size);
+	sp_fft_size_box_->setCurrentIndex(2);
+	f_layout->addRow(tr("FFT size"), sp_fft_size_box_);
+	sp_window_box_ = new QComboBox();
+	sp_window_box_->addItem(tr("Rectangular"),
+		QVariant::fromValue(sv::data::WindowFunction::Rectangular));
+	sp_window_box_->addItem(tr("Hann"),
+		QVariant::fromValue(sv::data::WindowFunction::Hann));
+	sp_window_box_->addItem(tr("Blackman"),
+		QVariant::fromValue(sv::data::WindowFunction::Blackman));
+	sp_window_box_->addItem(tr("Flat top"),
+		QVariant::fromValue(sv::data::WindowFunction::FlatTop));
+	sp_window_box_->setCurrentIndex(1);
+	f_layout->addRow(tr("Window"), sp_window_box_);
+	sp_mode_box_ = new QComboBox();
+	sp_mode_box_->addItem(tr("Blocks"),
+		QVariant::fromValue(channels::SpectrumMode::Blocks));
+	sp_mode_box_->addItem(tr("Frames"),
+		QVariant::fromValue(channels::SpectrumMode::Frames));
+	f_layout->addRow(tr("Mode"), sp_mode_box_);
+	sp_overlap_box_ = new QDoubleSpinBox();
+	sp_overlap_box_->setDecimals(1);
+	sp_overlap_box_->setRange(0, 87.5);
+	sp_overlap_box_->setSingleStep(12.5);
+	sp_overlap_box_->setValue(50);
+	sp_overlap_box_->setSuffix(" %");
+	sp_overlap_box_->setToolTip(tr("Only used in blocks mode"));
+	f_layout->addRow(tr("Overlap"), sp_overlap_box_);
+	sp_average_count_box_ = new QSpinBox();
+	sp_average_count_box_->setRange(1, 1000);
+	sp_average_count_box_->setValue(1);
+	f_layout->addRow(tr("Averaging"), sp_average_count_box_);
+	layout->addLayout(f_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
 shared_ptr<channels::MathChannel> AddMathChannelDialog::channel() const
 {
 	return channel_;
@@ -491,6 +685,121 @@ void AddMathChannelDialog::accept()
 				signal->signal_start_timestamp());
 		}
 		break;
+	case 6: {
+			if (iir_signal_->selected_signal() == nullptr) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the IIR filter."),
+					QMessageBox::Ok);
+				return;
+			}
+			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+				iir_signal_->selected_signal());
+
+			double samplerate = iir_samplerate_box_->value();
+			double frequency = iir_frequency_box_->value();
+			if (samplerate > 0 && frequency >= samplerate / 2) {
+				QMessageBox::warning(this,
+					tr("Frequency too high"),
+					tr("The filter frequency must be lower than half of the samplerate."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			channel_ = make_shared<channels::BiquadFilterChannel>(
+				quantity, quantity_flags, unit,
+				signal,
+				iir_type_box_->currentData().value<channels::BiquadFilterType>(),
+				frequency, iir_q_box_->value(),
+				iir_section_count_box_->value(), samplerate,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 7: {
+			if (fir_signal_->selected_signal() == nullptr) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the FIR filter."),
+					QMessageBox::Ok);
+				return;
+			}
+			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+				fir_signal_->selected_signal());
+
+			vector<double> taps;
+			const auto tap_strs = fir_taps_edit_->text().split(
+				QRegExp("[,;\\s]+"), QString::SkipEmptyParts);
+			for (const auto &tap_str : tap_strs) {
+				bool ok;
+				double tap = tap_str.toDouble(&ok);
+				if (!ok) {
+					QMessageBox::warning(this,
+						tr("Tap not a number"),
+						tr("Please enter only numbers as taps for the FIR filter."),
+						QMessageBox::Ok);
+					return;
+				}
+				taps.push_back(tap);
+			}
+			if (taps.empty()) {
+				QMessageBox::warning(this,
+					tr("Taps missing"),
+					tr("Please enter the taps for the FIR filter."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			channel_ = make_shared<channels::FirFilterChannel>(
+				quantity, quantity_flags, unit,
+				signal, taps,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 8: {
+			if (rs_signal_->selected_signal() == nullptr) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the resampling."),
+					QMessageBox::Ok);
+				return;
+			}
+			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+				rs_signal_->selected_signal());
+
+			channel_ = make_shared<channels::ResampleChannel>(
+				quantity, quantity_flags, unit,
+				signal, rs_samplerate_box_->value(),
+				rs_interpolation_box_->currentData().
+					value<channels::ResampleInterpolation>(),
+				rs_anti_alias_box_->isChecked(),
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 9: {
+			if (sp_signal_->selected_signal() == nullptr) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the spectrum."),
+					QMessageBox::Ok);
+				return;
+			}
+			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+				sp_signal_->selected_signal());
+
+			// The spectrum channel has its own quantity (peak frequency).
+			channel_ = make_shared<channels::SpectrumChannel>(
+				signal, sp_fft_size_box_->currentData().toUInt(),
+				sp_window_box_->currentData().value<sv::data::WindowFunction>(),
+				sp_mode_box_->currentData().value<channels::SpectrumMode>(),
+				sp_overlap_box_->value() / 100.,
+				(unsigned int)sp_average_count_box_->value(),
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
 	default:
 		break;
 	}
@@ -22,8 +22,11 @@
 
 #include <memory>
 
+#include <QCheckBox>
+#include <QComboBox>
 #include <QDialog>
 #include <QDialogButtonBox>
+#include <QDoubleSpinBox>
 #include <QLineEdit>
 #include <QSpinBox>
 #include <QTabWidget>
@@ -77,6 +80,10 @@ private:
 	void setup_ui_add_signal_tab();
 	void setup_ui_integrate_signal_tab();
 	void setup_ui_movingavg_signal_tab();
+	void setup_ui_iir_filter_tab();
+	void setup_ui_fir_filter_tab();
+	void setup_ui_resample_tab();
+	void setup_ui_spectrum_tab();
 
 	const Session &session_;
 	shared_ptr<sv::devices::BaseDevice> device_;
@@ -100,6 +107,24 @@ private:
 	ui::devices::SelectSignalWidget *i_s_signal_;
 	ui::devices::SelectSignalWidget *ma_signal_;
 	QSpinBox *ma_num_samples_box_;
+	ui::devices::SelectSignalWidget *iir_signal_;
+	QComboBox *iir_type_box_;
+	QDoubleSpinBox *iir_frequency_box_;
+	QDoubleSpinBox *iir_q_box_;
+	QSpinBox *iir_section_count_box_;
+	QDoubleSpinBox *iir_samplerate_box_;
+	ui::devices::SelectSignalWidget *fir_signal_;
+	QLineEdit *fir_taps_edit_;
+	ui::devices::SelectSignalWidget *rs_signal_;
+	QDoubleSpinBox *rs_samplerate_box_;
+	QComboBox *rs_interpolation_box_;
+	QCheckBox *rs_anti_alias_box_;
+	ui::devices::SelectSignalWidget *sp_signal_;
+	QComboBox *sp_fft_size_box_;
+	QComboBox *sp_window_box_;
+	QComboBox *sp_mode_box_;
+	QDoubleSpinBox *sp_overlap_box_;
+	QSpinBox *sp_average_count_box_;
 	QDialogButtonBox *button_box_;
 
 public Q_SLOTS:
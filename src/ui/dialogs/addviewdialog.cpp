@@ -29,6 +29,8 @@
 
 #include "addviewdialog.hpp"
 #include "src/channels/basechannel.hpp"
+#include "src/channels/hardwarechannel.hpp"
+#include "src/channels/spectrumchannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/properties/baseproperty.hpp"
 #include "src/data/properties/doubleproperty.hpp"
@@ -41,13 +43,17 @@
 #include "src/ui/devices/devicetree/devicetreeview.hpp"
 #include "src/ui/views/baseview.hpp"
 #include "src/ui/views/dataview.hpp"
+#include "src/ui/views/histogramview.hpp"
 #include "src/ui/views/powerpanelview.hpp"
+#include "src/ui/views/scopeplotview.hpp"
 #include "src/ui/views/sequenceoutputview.hpp"
+#include "src/ui/views/spectrumplotview.hpp"
 #include "src/ui/views/timeplotview.hpp"
 #include "src/ui/views/valuepanelview.hpp"
 #include "src/ui/views/viewhelper.hpp"
 #include "src/ui/views/xyplotview.hpp"
 
+using std::dynamic_pointer_cast;
 using std::set;
 using std::static_pointer_cast;
 
@@ -88,6 +94,9 @@ void AddViewDialog::setup_ui()
 	this->setup_ui_xy_plot_tab();
 	this->setup_ui_data_table_tab();
 	this->setup_ui_power_panel_tab();
+	this->setup_ui_spectrum_plot_tab();
+	this->setup_ui_histogram_tab();
+	this->setup_ui_scope_plot_tab();
 	tab_widget_->setCurrentIndex(selected_tab_);
 	main_layout->addWidget(tab_widget_);
 
@@ -231,6 +240,54 @@ void AddViewDialog::setup_ui_power_panel_tab()
 	tab_widget_->addTab(pp_widget, title);
 }
 
+void AddViewDialog::setup_ui_spectrum_plot_tab()
+{
+	QString title(tr("Spectrum Plot"));
+	QWidget *plot_widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+	plot_widget->setLayout(layout);
+
+	spectrum_plot_channel_tree_ = new ui::devices::devicetree::DeviceTreeView(
+		session_, false, false, true, false, false, false, false, false);
+	spectrum_plot_channel_tree_->expand_device(device_);
+
+	layout->addWidget(spectrum_plot_channel_tree_);
+
+	tab_widget_->addTab(plot_widget, title);
+}
+
+void AddViewDialog::setup_ui_scope_plot_tab()
+{
+	QString title(tr("Scope Plot"));
+	QWidget *plot_widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+	plot_widget->setLayout(layout);
+
+	scope_plot_channel_tree_ = new ui::devices::devicetree::DeviceTreeView(
+		session_, false, false, true, false, false, false, false, false);
+	scope_plot_channel_tree_->expand_device(device_);
+
+	layout->addWidget(scope_plot_channel_tree_);
+
+	tab_widget_->addTab(plot_widget, title);
+}
+
+void AddViewDialog::setup_ui_histogram_tab()
+{
+	QString title(tr("Histogram"));
+	QWidget *histogram_widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+	histogram_widget->setLayout(layout);
+
+	histogram_signal_tree_ = new ui::devices::devicetree::DeviceTreeView(
+		session_, false, false, false, true, false, false, false, false);
+	histogram_signal_tree_->expand_device(device_);
+
+	layout->addWidget(histogram_signal_tree_);
+
+	tab_widget_->addTab(histogram_widget, title);
+}
+
 vector<ui::views::BaseView *> AddViewDialog::views()
 {
 	return views_;
@@ -326,6 +383,50 @@ void AddViewDialog::accept()
 			}
 		}
 		break;
+	case 7:
+		// Add spectrum plot view for all checked spectrum channels
+		{
+			ui::views::SpectrumPlotView *view = nullptr;
+			for (const auto &channel :
+					spectrum_plot_channel_tree_->checked_channels()) {
+				auto spectrum_channel =
+					dynamic_pointer_cast<channels::SpectrumChannel>(channel);
+				if (!spectrum_channel)
+					continue;
+				if (!view)
+					view = new ui::views::SpectrumPlotView(session_);
+				view->add_channel(spectrum_channel);
+			}
+			if (view)
+				views_.push_back(view);
+		}
+		break;
+	case 8:
+		// Add histogram view for all checked signals
+		for (const auto &signal : histogram_signal_tree_->checked_signals()) {
+			auto *view = new ui::views::HistogramView(session_);
+			view->set_signal(static_pointer_cast<data::AnalogTimeSignal>(signal));
+			views_.push_back(view);
+		}
+		break;
+	case 9:
+		// Add one scope plot view for all checked hardware channels
+		{
+			ui::views::ScopePlotView *view = nullptr;
+			for (const auto &channel :
+					scope_plot_channel_tree_->checked_channels()) {
+				auto hw_channel =
+					dynamic_pointer_cast<channels::HardwareChannel>(channel);
+				if (!hw_channel)
+					continue;
+				if (!view)
+					view = new ui::views::ScopePlotView(session_);
+				view->add_channel(hw_channel);
+			}
+			if (view)
+				views_.push_back(view);
+		}
+		break;
 	default:
 		break;
 	}
@@ -19,7 +19,6 @@
 
 #include <cmath>
 #include <memory>
-#include <vector>
 
 #include <QChar>
 #include <QComboBox>
@@ -36,11 +35,12 @@
 #include "generatewaveformdialog.hpp"
 #include "src/data/properties/doubleproperty.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/waveform.hpp"
 
 using std::shared_ptr;
-using std::vector;
+using sv::data::WaveformType;
 
-Q_DECLARE_METATYPE(sv::ui::dialogs::WaveformType)
+Q_DECLARE_METATYPE(sv::data::WaveformType)
 
 namespace sv {
 namespace ui {
@@ -253,14 +253,9 @@ void GenerateWaveformDialog::setup_ui()
 	this->setLayout(layout);
 }
 
-vector<double> GenerateWaveformDialog::sequence_values() const
+sv::data::Waveform GenerateWaveformDialog::waveform() const
 {
-	return sequence_values_;
-}
-
-vector<double> GenerateWaveformDialog::sequence_delays() const
-{
-	return sequence_delays_;
+	return waveform_;
 }
 
 void GenerateWaveformDialog::accept()
@@ -269,46 +264,18 @@ void GenerateWaveformDialog::accept()
 	double offset = offset_box_->value();
 	double interval = interval_box_->value();
 	double periode;
-	double frequency;
-	// Get the most precise values for periode and frequency, because
-	// the values from the spin boxes are truncated!
-	if (frequency_box_->value() > 1) {
-		frequency = frequency_box_->value();
-		periode = 1 / frequency;
-	}
-	else {
+	// Get the most precise value for the periode, because the values from
+	// the spin boxes are truncated!
+	if (frequency_box_->value() > 1)
+		periode = 1 / frequency_box_->value();
+	else
 		periode = periode_box_->value();
-		frequency = 1 / periode;
-	}
 	double phi = phi_rad_box_->value();
-	double omega = 2 * pi * frequency;
 
+	// The samples are calculated when they are needed.
 	WaveformType w_type = waveform_box_->currentData().value<WaveformType>();
-	// NOTE: We must not rely on floating point types for loop termination.
-	//       Resolves clang-analyzer-security.FloatLoopCounter warnings.
-	double time = .0;
-	size_t const count = std::floor(periode / interval);
-	for (size_t i = 0; i < count; ++i) {
-		double x = omega * time + phi; // NOLINT(readability-identifier-length)
-		time += interval;
-		double value;
-		if (w_type == WaveformType::Sine)
-			value = std::sin(x);
-		else if (w_type == WaveformType::Square)
-			value = std::sin(x) < 0 ? -1 : 1;
-		else if (w_type == WaveformType::Triangle)
-			value = (std::asin(std::sin(x))) / (pi/2);
-		else if (w_type == WaveformType::Sawtooth)
-			value = std::fmod(x / pi, 2.0) - 1.0;
-		else if (w_type == WaveformType::SawtoothInv)
-			value = -std::fmod(x / pi, 2.0) + 1.0;
-		else
-			value = 0;
-
-		value = (amplitude * value) + offset;
-		sequence_values_.push_back(value);
-		sequence_delays_.push_back(interval);
-	}
+	waveform_ = sv::data::Waveform(
+		w_type, amplitude, offset, periode, interval, phi);
 
 	QDialog::accept();
 }
@@ -22,7 +22,6 @@
 
 #include <cmath>
 #include <memory>
-#include <vector>
 
 #include <QComboBox>
 #include <QDialog>
@@ -30,8 +29,9 @@
 #include <QDoubleSpinBox>
 #include <QSpinBox>
 
+#include "src/data/waveform.hpp"
+
 using std::shared_ptr;
-using std::vector;
 
 namespace sv {
 
@@ -44,14 +44,6 @@ class DoubleProperty;
 namespace ui {
 namespace dialogs {
 
-enum class WaveformType {
-	Sine,
-	Square,
-	Triangle,
-	Sawtooth,
-	SawtoothInv,
-};
-
 class GenerateWaveformDialog : public QDialog
 {
 	Q_OBJECT
@@ -63,8 +55,8 @@ public:
 		shared_ptr<sv::data::properties::DoubleProperty> property,
 		QWidget *parent = nullptr);
 
-	vector<double> sequence_values() const;
-	vector<double> sequence_delays() const;
+	/** Return the waveform, that was configured in this dialog. */
+	sv::data::Waveform waveform() const;
 
 private:
 	void setup_ui();
@@ -76,8 +68,7 @@ private:
 	double step_;
 	int decimals_;
 	QString unit_;
-	vector<double> sequence_values_;
-	vector<double> sequence_delays_;
+	sv::data::Waveform waveform_;
 	QComboBox *waveform_box_;
 	QDoubleSpinBox *min_value_box_;
 	QDoubleSpinBox *max_value_box_;
@@ -35,6 +35,7 @@
 
 #include "plotcurveconfigdialog.hpp"
 #include "src/ui/widgets/plot/curve.hpp"
+#include "src/ui/widgets/plot/decimatingplotcurve.hpp"
 #include "src/ui/widgets/plot/plot.hpp"
 #include "src/ui/widgets/colorbutton.hpp"
 
@@ -107,6 +108,17 @@ void PlotCurveConfigDialog::setup_ui()
 	}
 	main_layout->addRow(tr("Symbol type"), symbol_type_box_);
 
+	render_mode_box_ = new QComboBox();
+	render_mode_box_->addItem(tr("Lines"),
+		(int)widgets::plot::CurveRenderMode::Lines);
+	render_mode_box_->addItem(tr("Density"),
+		(int)widgets::plot::CurveRenderMode::Density);
+	render_mode_box_->setCurrentIndex(
+		render_mode_box_->findData((int)curve_->render_mode()));
+	render_mode_box_->setToolTip(
+		tr("Draw the point density instead of lines, for huge curves"));
+	main_layout->addRow(tr("Render mode"), render_mode_box_);
+
 	button_box_ = new QDialogButtonBox(
 		QDialogButtonBox::Ok | QDialogButtonBox::Cancel, Qt::Horizontal);
 	QPushButton *remove_button = new QPushButton(
@@ -131,6 +143,8 @@ void PlotCurveConfigDialog::accept()
 	curve_->set_color(color_button_->color());
 	curve_->set_style(line_type_box_->currentData().value<Qt::PenStyle>());
 	curve_->set_symbol(symbol_type_box_->currentData().value<QwtSymbol::Style>());
+	curve_->set_render_mode((widgets::plot::CurveRenderMode)
+		render_mode_box_->currentData().toInt());
 
 	QDialog::accept();
 }
@@ -58,6 +58,7 @@ private:
 	widgets::ColorButton *color_button_;
 	QComboBox *line_type_box_;
 	QComboBox *symbol_type_box_;
+	QComboBox *render_mode_box_;
 	QDialogButtonBox *button_box_;
 
 public Q_SLOTS:
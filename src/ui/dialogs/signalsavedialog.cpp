@@ -42,6 +42,7 @@
 #include "src/channels/basechannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/basesignal.hpp"
+#include "src/data/mergedtimestampindex.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/hardwaredevice.hpp"
 #include "src/ui/devices/devicetree/devicetreeview.hpp"
@@ -212,9 +213,13 @@ void SignalSaveDialog::save(const QString &file_name)
 
 	// Data
 	// TODO: we asume here, that the vector size is the same for all vectors....
+	// The values are formatted into a reused buffer, so no temporary strings
+	// are allocated for every sample.
+	char buffer[util::FormatBufferSize];
+	string line;
 	for (size_t index = 0; index < max_sample_count; index++) {
 		start_sep = "";
-		QString line("");
+		line.clear();
 		int sample_count_index = 0;
 		for (const auto &signal : signals) {
 			// Only handle AnalogSignals
@@ -223,28 +228,29 @@ void SignalSaveDialog::save(const QString &file_name)
 			if (!analog_signal)
 				continue;
 
-			QString time("");
-			QString value("");
-
+			line += start_sep;
 			size_t sample_count = sample_counts[sample_count_index];
 			if (index < sample_count-1) {
 				// More samples for this signal
 				auto sample = analog_signal->get_sample(index, relative_time);
-				value = QString("%1").arg(sample.second);
 				if (relative_time)
-					time = QString("%1").arg(sample.first, 0, 'f', 4);
+					line.append(buffer, util::format_double_fixed(
+						buffer, sizeof(buffer), sample.first, 4));
 				else
-					time = util::format_time_date(sample.first);
+					line.append(buffer, util::format_time_date(
+						buffer, sizeof(buffer), sample.first));
+				line += sep;
+				line.append(buffer, util::format_double_general(
+					buffer, sizeof(buffer), sample.second));
+			}
+			else {
+				line += sep;
 			}
-
-			line.append(QString("%1%2%3%4").arg(
-				QString::fromStdString(start_sep), time,
-				QString::fromStdString(sep), value));
 			start_sep = sep;
 
 			++sample_count_index;
 		}
-		output_file << line.toStdString() << std::endl;
+		output_file << line << '\n';
 	}
 
 	output_file.close();
@@ -254,8 +260,6 @@ void SignalSaveDialog::save_combined(const QString &file_name)
 {
 	ofstream output_file;
 	string str_file_name = file_name.toStdString();
-	vector<size_t> sample_counts;
-	vector<size_t> sample_pos;
 
 	output_file.open(str_file_name);
 
@@ -267,6 +271,7 @@ void SignalSaveDialog::save_combined(const QString &file_name)
 	auto signals = device_tree_->checked_signals();
 	bool relative_time = !time_absolut_->isChecked();
 	string sep = separator_edit_->text().toStdString();
+	sv::data::MergedTimestampIndex index(combined_timeframe, relative_time);
 
 	// Header
 	string device_header_line("Time"); // Time
@@ -283,8 +288,7 @@ void SignalSaveDialog::save_combined(const QString &file_name)
 		shared_ptr<sv::channels::BaseChannel> parent_channel =
 			analog_signal->parent_channel();
 
-		sample_counts.push_back(analog_signal->sample_count());
-		sample_pos.push_back(0);
+		index.add_signal(analog_signal);
 
 		string chg_names;
 		string chg_sep;
@@ -313,59 +317,32 @@ void SignalSaveDialog::save_combined(const QString &file_name)
 	output_file << signal_name_header_line << std::endl;
 
 	// Data
-	while (true) {
-		double next_timestamp = -1;
-		int index = 0;
-		for (const auto &signal : signals) {
-			// Only handle AnalogSignals
-			auto analog_signal =
-				dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal);
-			if (!analog_signal)
-				continue;
-
-			if (sample_pos[index] >= sample_counts[index]-1)
-				continue;
-
-			double timestamp =
-				analog_signal->get_sample(sample_pos[index], relative_time).first;
-			if (next_timestamp < 0 || timestamp < next_timestamp)
-				next_timestamp = timestamp;
-
-			++index;
-		}
-
-		if (next_timestamp < 0)
-			break;
-
+	index.update();
+	size_t pos;
+	char buffer[util::FormatBufferSize];
+	string line;
+	for (size_t row=0; row<index.row_count(); ++row) {
 		// Timestamp
-		QString line;
+		const double timestamp = index.row_timestamp(row);
+		line.clear();
 		if (relative_time)
-			line = QString("%1").arg(next_timestamp, 0, 'f', 4);
+			line.append(buffer, util::format_double_fixed(
+				buffer, sizeof(buffer), timestamp, 4));
 		else
-			line = util::format_time_date(next_timestamp);
+			line.append(buffer, util::format_time_date(
+				buffer, sizeof(buffer), timestamp));
 
 		// Values
-		index = 0;
-		for (const auto &signal : signals) {
-			// Only handle AnalogSignals
-			auto analog_signal =
-				dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal);
-			if (!analog_signal)
-				continue;
-
-			line.append(QString::fromStdString(sep));
-
-			auto sample =
-				analog_signal->get_sample(sample_pos[index], relative_time);
-			double timestamp = sample.first;
-			if (timestamp + combined_timeframe >= next_timestamp) {
-				line.append(QString("%1").arg(sample.second, 0, 'g', -1));
-				++sample_pos[index];
+		for (size_t i=0; i<index.signal_count(); ++i) {
+			line += sep;
+			if (index.sample_pos(row, i, pos)) {
+				const double value =
+					index.signal(i)->get_sample(pos, relative_time).second;
+				line.append(buffer, util::format_double_general(
+					buffer, sizeof(buffer), value));
 			}
-
-			++index;
 		}
-		output_file << line.toStdString() << std::endl;
+		output_file << line << '\n';
 	}
 
 	output_file.close();
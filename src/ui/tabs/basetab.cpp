@@ -26,6 +26,7 @@
 #include "basetab.hpp"
 #include "src/session.hpp"
 #include "src/ui/tabs/tabdockwidget.hpp"
+#include "src/ui/views/placeholderview.hpp"
 
 namespace sv {
 namespace ui {
@@ -62,7 +63,11 @@ string BaseTab::id() const
 
 views::BaseView *BaseTab::get_view_from_view_id(const string &id)
 {
-	return view_id_map_[id];
+	auto *view = view_id_map_[id];
+	auto *placeholder = qobject_cast<views::PlaceholderView *>(view);
+	if (placeholder)
+		return replace_placeholder(placeholder);
+	return view;
 }
 
 TabDockWidget *BaseTab::create_dock_widget(views::BaseView *view,
@@ -85,9 +90,47 @@ TabDockWidget *BaseTab::create_dock_widget(views::BaseView *view,
 
 	connect(dock, &TabDockWidget::closed, this, &BaseTab::remove_view);
 
+	auto *placeholder = qobject_cast<views::PlaceholderView *>(view);
+	if (placeholder) {
+		// Replace the placeholder outside of its show event.
+		connect(placeholder, &views::PlaceholderView::create_view_requested,
+			this, [this, placeholder]() { replace_placeholder(placeholder); },
+			Qt::QueuedConnection);
+	}
+
 	return dock;
 }
 
+views::BaseView *BaseTab::replace_placeholder(
+	views::PlaceholderView *placeholder)
+{
+	// The placeholder may have been replaced already by
+	// get_view_from_view_id() or closed in the meantime.
+	const auto dock_it = view_docks_map_.find(placeholder);
+	if (dock_it == view_docks_map_.end())
+		return nullptr;
+
+	TabDockWidget *dock = dock_it->second;
+	views::BaseView *view = placeholder->create_view();
+	if (!view) {
+		// The view can't be restored (e.g. the signals are missing), like
+		// views that are restored immediately, it is dropped.
+		dock->close();
+		return nullptr;
+	}
+
+	view_docks_map_.erase(dock_it);
+	view_docks_map_[view] = dock;
+	view_id_map_[view->id()] = view;
+
+	dock->set_view(view);
+	placeholder->hide();
+	placeholder->deleteLater();
+	view->show();
+
+	return view;
+}
+
 void BaseTab::closeEvent(QCloseEvent *event)
 {
 	save_settings();
@@ -40,6 +40,11 @@ namespace sv {
 class Session;
 
 namespace ui {
+
+namespace views {
+class PlaceholderView;
+}
+
 namespace tabs {
 
 class TabDockWidget;
@@ -66,12 +71,18 @@ public:
 
 	string id() const;
 	virtual QString title() = 0;
+	/**
+	 * Return the view with the given id. A placeholder for a restored view
+	 * is replaced with the real view first.
+	 */
 	views::BaseView *get_view_from_view_id(const string &id);
 	virtual bool request_close() = 0;
 
 private:
 	TabDockWidget *create_dock_widget(views::BaseView *view,
 		QDockWidget::DockWidgetFeatures features);
+	/** Replace the placeholder with the real view. */
+	views::BaseView *replace_placeholder(views::PlaceholderView *placeholder);
 
 	/** This event is handling the saving of the settings. */
 	void closeEvent(QCloseEvent *event) override;
@@ -40,7 +40,7 @@
 #include "src/ui/dialogs/signalsavedialog.hpp"
 #include "src/ui/tabs/basetab.hpp"
 #include "src/ui/tabs/tabdockwidget.hpp"
-#include "src/ui/views/viewhelper.hpp"
+#include "src/ui/views/placeholderview.hpp"
 
 using std::shared_ptr;
 using std::string;
@@ -183,10 +183,11 @@ void DeviceTab::restore_settings()
 	const QStringList view_keys = settings.childGroups();
 	for (const auto &view_key : view_keys) {
 		settings.beginGroup(view_key);
-		auto *view = views::viewhelper::get_view_from_settings(
-			session_, settings, device_);
-		if (view)
+		// The views are created when they are shown for the first time.
+		if (settings.contains("id")) {
+			auto *view = new views::PlaceholderView(session_, settings, device_);
 			add_view(view, Qt::DockWidgetArea::TopDockWidgetArea);
+		}
 		settings.endGroup();
 	}
 
@@ -41,6 +41,20 @@ TabDockWidget::TabDockWidget(const QString &title, views::BaseView *view,
 		this, &TabDockWidget::on_view_title_changed);
 }
 
+void TabDockWidget::set_view(views::BaseView *view)
+{
+	auto *old_view = qobject_cast<views::BaseView *>(widget());
+	if (old_view) {
+		disconnect(old_view, &views::BaseView::title_changed,
+			this, &TabDockWidget::on_view_title_changed);
+	}
+
+	setWidget(view);
+	connect(view, &views::BaseView::title_changed,
+		this, &TabDockWidget::on_view_title_changed);
+	setWindowTitle(view->title());
+}
+
 void TabDockWidget::closeEvent(QCloseEvent *event)
 {
 	string view_id = qobject_cast<views::BaseView *>(widget())->id();
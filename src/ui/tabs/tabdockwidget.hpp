@@ -43,6 +43,9 @@ public:
 	TabDockWidget(const QString &title, views::BaseView *view,
 		QWidget *parent = nullptr);
 
+	/** Replace the view of this dock widget. */
+	void set_view(views::BaseView *view);
+
 private:
 	void closeEvent(QCloseEvent *event) override;
 
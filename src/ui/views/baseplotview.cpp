@@ -70,6 +70,8 @@ void BasePlotView::setup_ui()
 	plot_ = new widgets::plot::Plot(session_);
 	plot_->set_update_mode(widgets::plot::PlotUpdateMode::Additive);
 	plot_->set_plot_interval(200); // 200ms
+	// The view is suspended until it is shown.
+	plot_->set_suspended(true);
 
 	layout->addWidget(plot_);
 
@@ -180,6 +182,19 @@ bool BasePlotView::set_curve_name(const string &curve_id, const QString &name)
 }
 
 
+void BasePlotView::suspend()
+{
+	// The PlotRefreshScheduler skips hidden plots, only the curves must be
+	// suspended.
+	plot_->set_suspended(true);
+}
+
+void BasePlotView::resume()
+{
+	// The curves catch up here, the plot is redrawn in Plot::showEvent().
+	plot_->set_suspended(false);
+}
+
 bool BasePlotView::set_curve_color(const string &curve_id, const QColor &color)
 {
 	if (plot_->curve_map().count(curve_id) == 0)
@@ -65,6 +65,8 @@ namespace views {
 enum class PlotType {
 	TimePlot,
 	XYPlot,
+	SpectrumPlot,
+	ScopePlot,
 };
 
 class BasePlotView : public BaseView
@@ -79,12 +81,17 @@ public:
 	bool set_curve_name(const string &curve_id, const QString &name);
 	/** Helper function to change a curve color. */
 	bool set_curve_color(const string &curve_id, const QColor &color);
+	/** Return the plot widget of this view. */
+	widgets::plot::Plot *plot() const { return plot_; }
 	void save_settings(QSettings &settings,
 		shared_ptr<sv::devices::BaseDevice> origin_device = nullptr) const override;
 	void restore_settings(QSettings &settings,
 		shared_ptr<sv::devices::BaseDevice> origin_device = nullptr) override;
 
 protected:
+	void suspend() override;
+	void resume() override;
+
 	PlotType plot_type_;
 	widgets::plot::Plot *plot_;
 
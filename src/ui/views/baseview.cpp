@@ -20,7 +20,9 @@
 #include <memory>
 #include <string>
 
+#include <QHideEvent>
 #include <QSettings>
+#include <QShowEvent>
 #include <QSize>
 #include <QString>
 #include <QUuid>
@@ -40,7 +42,8 @@ namespace views {
 BaseView::BaseView(Session &session, QUuid uuid, QWidget *parent) :
 	QMainWindow(parent),
 	session_(session),
-	size_(QSize(-1, -1))
+	size_(QSize(-1, -1)),
+	suspended_(true)
 {
 	// Every view gets its own unique id
 	uuid_ = uuid.isNull() ? QUuid::createUuid() : uuid;
@@ -81,6 +84,8 @@ void BaseView::save_settings(QSettings &settings,
 
 	settings.setValue("uuid", QVariant(uuid()));
 	settings.setValue("id", QVariant(QString::fromStdString(id())));
+	// The title is shown by the placeholder, until the view is restored.
+	settings.setValue("title", QVariant(title()));
 	// NOTE: The size must be saved together with the geometry (saveGeometry())
 	//       of all dock widgets, see DeviceTab::save_settings().
 	settings.setValue("size", size());
@@ -104,6 +109,41 @@ QSize BaseView::sizeHint() const
 	return QMainWindow::sizeHint();
 }
 
+bool BaseView::is_suspended() const
+{
+	return suspended_;
+}
+
+void BaseView::showEvent(QShowEvent *event)
+{
+	QMainWindow::showEvent(event);
+
+	// Spontaneous events come from the window system (e.g. minimizing the
+	// main window), the view itself stays visible.
+	if (event->spontaneous() || !suspended_)
+		return;
+	suspended_ = false;
+	resume();
+}
+
+void BaseView::hideEvent(QHideEvent *event)
+{
+	QMainWindow::hideEvent(event);
+
+	if (event->spontaneous() || suspended_)
+		return;
+	suspended_ = true;
+	suspend();
+}
+
+void BaseView::suspend()
+{
+}
+
+void BaseView::resume()
+{
+}
+
 } // namespace views
 } // namespace ui
 } // namespace sv
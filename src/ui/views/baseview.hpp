@@ -23,8 +23,10 @@
 #include <memory>
 #include <string>
 
+#include <QHideEvent>
 #include <QMainWindow>
 #include <QSettings>
+#include <QShowEvent>
 #include <QSize>
 #include <QString>
 #include <QUuid>
@@ -78,7 +80,25 @@ public:
 	/** Return a size hint for restoring the correct view size from QSettings. */
 	QSize sizeHint() const override;
 
+	/**
+	 * Return true, if the view isn't visible (e.g. in a background tab or
+	 * in a collapsed dock) and its per-sample work is suspended.
+	 */
+	bool is_suspended() const;
+
 protected:
+	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
+	/**
+	 * Called when the view was hidden. Stop all per-sample work here.
+	 */
+	virtual void suspend();
+	/**
+	 * Called when the view is shown for the first time or was hidden
+	 * before. Catch up with the data in one batch here.
+	 */
+	virtual void resume();
+
 	Session &session_;
 	QWidget *central_widget_;
 	QUuid uuid_;
@@ -86,6 +106,10 @@ protected:
 	/** The size for sizeHint(). */
 	QSize size_;
 
+private:
+	/** A view is suspended until it is shown. */
+	bool suspended_;
+
 Q_SIGNALS:
 	void title_changed();
 
@@ -18,17 +18,14 @@
  */
 
 #include <memory>
-#include <mutex>
 #include <set>
 #include <string>
 
 #include <QAction>
 #include <QDebug>
-#include <QList>
+#include <QHeaderView>
 #include <QSettings>
-#include <QScrollBar>
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QTableView>
 #include <QToolBar>
 #include <QUuid>
 #include <QVBoxLayout>
@@ -38,13 +35,12 @@
 #include "src/settingsmanager.hpp"
 #include "src/util.hpp"
 #include "src/channels/basechannel.hpp"
-#include "src/data/analogbasesignal.hpp"
 #include "src/data/analogtimesignal.hpp"
-#include "src/data/datautil.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/dialogs/selectsignaldialog.hpp"
 #include "src/ui/views/baseview.hpp"
 #include "src/ui/views/viewhelper.hpp"
+#include "src/ui/widgets/datatablemodel.hpp"
 
 using std::shared_ptr;
 using std::dynamic_pointer_cast;
@@ -68,8 +64,9 @@ DataView::DataView(Session &session, QUuid uuid, QWidget *parent) :
 QString DataView::title() const
 {
 	QString title = tr("Data");
-	if (!signals_.empty())
-		title = title.append(" ").append(signals_.at(0)->display_name());
+	const auto signals = data_model_->signals();
+	if (!signals.empty())
+		title = title.append(" ").append(signals.at(0)->display_name());
 	return title;
 }
 
@@ -77,12 +74,19 @@ void DataView::setup_ui()
 {
 	QVBoxLayout *layout = new QVBoxLayout();
 
-	data_table_ = new QTableWidget();
-	data_table_->setColumnCount(1);
-	QTableWidgetItem *time_header_item = new QTableWidgetItem(tr("Time [s]"));
-	time_header_item->setTextAlignment(Qt::AlignVCenter);
-	data_table_->setHorizontalHeaderItem(0, time_header_item);
+	data_model_ = new widgets::DataTableModel(this);
+	// The view is suspended until it is shown.
+	data_model_->set_suspended(true);
+	connect(data_model_, &widgets::DataTableModel::rowsInserted,
+		this, &DataView::on_rows_inserted);
+
+	data_table_ = new QTableView();
+	data_table_->setModel(data_model_);
+	data_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
 	data_table_->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+	// All rows have the same height, so the view doesn't have to measure
+	// the rows.
+	data_table_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
 	layout->addWidget(data_table_);
 
 	this->central_widget_->setLayout(layout);
@@ -119,7 +123,7 @@ void DataView::save_settings(QSettings &settings,
 	BaseView::save_settings(settings, origin_device);
 
 	size_t index = 0;
-	for (const auto &signal : signals_) {
+	for (const auto &signal : data_model_->signals()) {
 		settings.beginGroup(QString("signal%1").arg(index++));
 		SettingsManager::save_signal(signal, settings, origin_device);
 		settings.endGroup();
@@ -148,89 +152,26 @@ void DataView::restore_settings(QSettings &settings,
 
 void DataView::add_signal(shared_ptr<sv::data::AnalogTimeSignal> signal)
 {
-	signals_.push_back(signal);
-	next_signal_pos_.push_back(0);
-	last_timestamp_.push_back(nullptr);
-	int pos = static_cast<int>(signals_.size());
-
-	QTableWidgetItem *value_header_item = new QTableWidgetItem(
-		signal->display_name());
-	value_header_item->setTextAlignment(Qt::AlignVCenter);
-	data_table_->insertColumn(pos);
-	data_table_->setHorizontalHeaderItem(pos, value_header_item);
-
-	this->populate_table();
-	connect(signal.get(), &data::AnalogBaseSignal::sample_appended,
-		this, &DataView::populate_table);
+	data_model_->add_signal(signal);
+	if (auto_scroll_)
+		data_table_->scrollToBottom();
 
 	Q_EMIT title_changed();
 }
 
-void DataView::populate_table()
+void DataView::suspend()
 {
-	std::unique_lock<std::mutex> lock(populate_mutex_, std::try_to_lock);
-	if (!lock.owns_lock())
-		return;
-
-	for (size_t i=0; i<signals_.size(); ++i) {
-		size_t signal_size = signals_[i]->sample_count();
-		while (next_signal_pos_[i] < signal_size) {
-			auto sample = signals_[i]->get_sample(next_signal_pos_[i], true);
-			int row_count  = data_table_->rowCount();
-
-			int last_row  = -1;
-			if (last_timestamp_[i])
-				last_row = data_table_->row(last_timestamp_[i]);
-
-			bool new_row = false;
-			if (row_count <= last_row+1) {
-				data_table_->insertRow(last_row+1);
-				new_row = true;
-			}
-			else {
-				// Find position of new sample
-				while (last_row+1 < row_count) {
-					auto *item = data_table_->item(last_row+1, 0);
-					double timestamp = item->data(0).toDouble();
-					if (timestamp > sample.first) {
-						data_table_->insertRow(last_row+1);
-						new_row = true;
-						break;
-					}
-					if (timestamp == sample.first) {
-						last_timestamp_[i] = item;
-						new_row = false;
-						break;
-					}
-					if (row_count == last_row+2) {
-						++last_row;
-						data_table_->insertRow(last_row+1);
-						new_row = true;
-						break;
-					}
-					last_row++;
-				}
-			}
+	data_model_->set_suspended(true);
+}
 
-			if (new_row) {
-				QTableWidgetItem *time_item = new QTableWidgetItem(
-					QString::number(sample.first, 'f', 3));
-				time_item->setData(0, QVariant(sample.first));
-				data_table_->setItem(last_row+1, 0, time_item);
-				last_timestamp_[i] = time_item;
-			}
-			int prefix = util::prefix_from_value(
-				sample.second, signals_[i]->sr_digits());
-			int decimal_places = util::decimal_places_from_prefix(
-				prefix, signals_[i]->sr_digits());
-			QTableWidgetItem *value_item = new QTableWidgetItem(
-				QString::number(sample.second, 'f', decimal_places));
-			value_item->setData(0, QVariant(sample.second));
-			data_table_->setItem(last_row+1, (int)i+1, value_item);
+void DataView::resume()
+{
+	// Inserts all rows, that were missed while hidden.
+	data_model_->set_suspended(false);
+}
 
-			++next_signal_pos_[i];
-		}
-	}
+void DataView::on_rows_inserted()
+{
 	if (auto_scroll_)
 		data_table_->scrollToBottom();
 }
@@ -244,8 +185,9 @@ void DataView::on_action_auto_scroll_triggered()
 void DataView::on_action_add_signal_triggered()
 {
 	shared_ptr<sv::devices::BaseDevice> selected_device;
-	if (signals_[0])
-		selected_device = signals_[0]->parent_channel()->parent_device();
+	const auto signals = data_model_->signals();
+	if (!signals.empty())
+		selected_device = signals[0]->parent_channel()->parent_device();
 
 	ui::dialogs::SelectSignalDialog dlg(session(), selected_device);
 	if (!dlg.exec())
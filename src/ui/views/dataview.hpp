@@ -21,12 +21,11 @@
 #define UI_VIEWS_DATAVIEW_HPP
 
 #include <memory>
-#include <mutex>
 #include <vector>
 
 #include <QAction>
 #include <QSettings>
-#include <QTableWidget>
+#include <QTableView>
 #include <QToolBar>
 #include <QUuid>
 
@@ -47,6 +46,11 @@ class BaseDevice;
 }
 
 namespace ui {
+
+namespace widgets {
+class DataTableModel;
+}
+
 namespace views {
 
 class DataView : public BaseView
@@ -65,23 +69,24 @@ public:
 	void restore_settings(QSettings &settings,
 		shared_ptr<sv::devices::BaseDevice> origin_device = nullptr) override;
 
+protected:
+	void suspend() override;
+	void resume() override;
+
 private:
-	vector<shared_ptr<sv::data::AnalogTimeSignal>> signals_;
-	vector<size_t> next_signal_pos_;
-	vector<QTableWidgetItem *> last_timestamp_;
 	bool auto_scroll_;
-	std::mutex populate_mutex_;
 
 	QAction *const action_auto_scroll_;
 	QAction *const action_add_signal_;
 	QToolBar *toolbar_;
-	QTableWidget *data_table_;
+	widgets::DataTableModel *data_model_;
+	QTableView *data_table_;
 
 	void setup_ui();
 	void setup_toolbar();
 
 private Q_SLOTS:
-	void populate_table();
+	void on_rows_inserted();
 	void on_action_auto_scroll_triggered();
 	void on_action_add_signal_triggered();
 
@@ -0,0 +1,219 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <QGridLayout>
+#include <QSettings>
+#include <QTimer>
+#include <QUuid>
+#include <QVector>
+#include <QVBoxLayout>
+#include <qwt_interval.h>
+#include <qwt_plot.h>
+#include <qwt_plot_grid.h>
+#include <qwt_plot_histogram.h>
+#include <qwt_samples.h>
+
+#include "histogramview.hpp"
+#include "src/session.hpp"
+#include "src/settingsmanager.hpp"
+#include "src/util.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/signalstatistics.hpp"
+#include "src/devices/basedevice.hpp"
+#include "src/ui/views/baseview.hpp"
+#include "src/ui/widgets/monofontdisplay.hpp"
+
+using std::dynamic_pointer_cast;
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace views {
+
+HistogramView::HistogramView(Session &session, QUuid uuid, QWidget *parent) :
+	BaseView(session, uuid, parent),
+	signal_(nullptr)
+{
+	id_ = "histogram:" + util::format_uuid(uuid_);
+
+	setup_ui();
+
+	// The timer is started, when the view is shown.
+	timer_ = new QTimer(this);
+	timer_->setInterval(500);
+	connect(timer_, &QTimer::timeout, this, &HistogramView::on_update);
+}
+
+HistogramView::~HistogramView()
+{
+	timer_->stop();
+}
+
+QString HistogramView::title() const
+{
+	QString title = tr("Histogram");
+	if (signal_)
+		title = title.append(" ").append(signal_->display_name());
+	return title;
+}
+
+void HistogramView::set_signal(shared_ptr<sv::data::AnalogTimeSignal> signal)
+{
+	assert(signal);
+
+	signal_ = signal;
+	signal_->set_statistics_enabled(true);
+	init_displays();
+	on_update();
+
+	Q_EMIT title_changed();
+}
+
+void HistogramView::setup_ui()
+{
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	plot_ = new QwtPlot();
+	plot_->setMinimumSize(250, 150);
+	plot_->setAxisTitle(QwtPlot::yLeft, tr("Count"));
+	QwtPlotGrid *grid = new QwtPlotGrid();
+	grid->setPen(Qt::gray, 0.0, Qt::DotLine);
+	grid->attach(plot_);
+	histogram_ = new QwtPlotHistogram();
+	histogram_->setStyle(QwtPlotHistogram::Columns);
+	histogram_->attach(plot_);
+	layout->addWidget(plot_, 1);
+
+	QGridLayout *panel_layout = new QGridLayout();
+	p1_display_ = new widgets::MonoFontDisplay(
+		widgets::MonoFontDisplayType::AutoRange, "", "", "P1", true);
+	p50_display_ = new widgets::MonoFontDisplay(
+		widgets::MonoFontDisplayType::AutoRange, "", "", "P50", true);
+	p99_display_ = new widgets::MonoFontDisplay(
+		widgets::MonoFontDisplayType::AutoRange, "", "", "P99", true);
+	mean_display_ = new widgets::MonoFontDisplay(
+		widgets::MonoFontDisplayType::AutoRange, "", "",
+		data::datautil::format_quantity_flag(data::QuantityFlag::Avg), true);
+	stddev_display_ = new widgets::MonoFontDisplay(
+		widgets::MonoFontDisplayType::AutoRange, "", "", QString::fromUtf8("σ"),
+		true);
+	panel_layout->addWidget(p1_display_, 0, 0, 1, 1, Qt::AlignHCenter);
+	panel_layout->addWidget(p50_display_, 0, 1, 1, 1, Qt::AlignHCenter);
+	panel_layout->addWidget(p99_display_, 0, 2, 1, 1, Qt::AlignHCenter);
+	panel_layout->addWidget(mean_display_, 1, 0, 1, 1, Qt::AlignHCenter);
+	panel_layout->addWidget(stddev_display_, 1, 1, 1, 1, Qt::AlignHCenter);
+	layout->addLayout(panel_layout);
+
+	this->central_widget_->setLayout(layout);
+}
+
+void HistogramView::init_displays()
+{
+	QString unit = signal_->unit_name();
+	for (auto *display : { p1_display_, p50_display_, p99_display_,
+			mean_display_, stddev_display_ }) {
+		display->set_unit(unit);
+		display->set_decimal_places(
+			sv::data::DefaultTotalDigits, sv::data::DefaultDecimalPlaces);
+		display->reset_value();
+	}
+
+	plot_->setAxisTitle(QwtPlot::xBottom, QString("%1 [%2]").
+		arg(data::datautil::format_quantity(signal_->quantity()), unit));
+}
+
+void HistogramView::save_settings(QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device) const
+{
+	BaseView::save_settings(settings, origin_device);
+
+	if (signal_)
+		SettingsManager::save_signal(signal_, settings, origin_device);
+}
+
+void HistogramView::restore_settings(QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device)
+{
+	BaseView::restore_settings(settings, origin_device);
+
+	auto signal = SettingsManager::restore_signal(
+		session_, settings, origin_device);
+	if (signal)
+		set_signal(dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal));
+}
+
+void HistogramView::suspend()
+{
+	timer_->stop();
+}
+
+void HistogramView::resume()
+{
+	on_update();
+	timer_->start();
+}
+
+void HistogramView::on_update()
+{
+	if (!signal_)
+		return;
+
+	const sv::data::SignalStatistics statistics = signal_->statistics();
+	if (statistics.count() == 0)
+		return;
+
+	p1_display_->set_value(statistics.quantile(0.01));
+	p50_display_->set_value(statistics.quantile(0.5));
+	p99_display_->set_value(statistics.quantile(0.99));
+	mean_display_->set_value(statistics.mean());
+	if (statistics.count() > 1)
+		stddev_display_->set_value(statistics.stddev());
+
+	// Only show the used range of the histogram.
+	const vector<uint64_t> bins = statistics.histogram();
+	const double lower = statistics.histogram_lower();
+	const double bin_width = statistics.histogram_bin_width();
+	size_t first = 0;
+	while (first < bins.size() && bins[first] == 0)
+		++first;
+	size_t last = bins.size();
+	while (last > first && bins[last-1] == 0)
+		--last;
+
+	QVector<QwtIntervalSample> samples;
+	samples.reserve((int)(last - first));
+	for (size_t i=first; i<last; ++i) {
+		const double bin_lower = lower + (double)i * bin_width;
+		samples.append(QwtIntervalSample((double)bins[i],
+			QwtInterval(bin_lower, bin_lower + bin_width)));
+	}
+	histogram_->setSamples(samples);
+	plot_->replot();
+}
+
+} // namespace views
+} // namespace ui
+} // namespace sv
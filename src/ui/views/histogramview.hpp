@@ -0,0 +1,106 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_VIEWS_HISTOGRAMVIEW_HPP
+#define UI_VIEWS_HISTOGRAMVIEW_HPP
+
+#include <memory>
+
+#include <QSettings>
+#include <QString>
+#include <QTimer>
+#include <QUuid>
+
+#include <qwt_plot.h>
+#include <qwt_plot_histogram.h>
+
+#include "src/ui/views/baseview.hpp"
+
+using std::shared_ptr;
+
+namespace sv {
+
+class Session;
+
+namespace data {
+class AnalogTimeSignal;
+}
+namespace devices {
+class BaseDevice;
+}
+
+namespace ui {
+
+namespace widgets {
+class MonoFontDisplay;
+}
+
+namespace views {
+
+/**
+ * Show the histogram and the percentiles of a signal. The statistics of the
+ * signal are updated incrementally, so this view is cheap, even for signals
+ * with millions of samples.
+ */
+class HistogramView : public BaseView
+{
+	Q_OBJECT
+
+public:
+	explicit HistogramView(Session& session, QUuid uuid = QUuid(),
+		QWidget* parent = nullptr);
+
+	~HistogramView();
+
+	QString title() const override;
+	void set_signal(shared_ptr<sv::data::AnalogTimeSignal> signal);
+
+	void save_settings(QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device = nullptr) const override;
+	void restore_settings(QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device = nullptr) override;
+
+protected:
+	void suspend() override;
+	void resume() override;
+
+private:
+	void setup_ui();
+	void init_displays();
+
+	shared_ptr<sv::data::AnalogTimeSignal> signal_;
+	QTimer *timer_;
+	QwtPlot *plot_;
+	QwtPlotHistogram *histogram_;
+	widgets::MonoFontDisplay *p1_display_;
+	widgets::MonoFontDisplay *p50_display_;
+	widgets::MonoFontDisplay *p99_display_;
+	widgets::MonoFontDisplay *mean_display_;
+	widgets::MonoFontDisplay *stddev_display_;
+
+private Q_SLOTS:
+	void on_update();
+
+};
+
+} // namespace views
+} // namespace ui
+} // namespace sv
+
+#endif // UI_VIEWS_HISTOGRAMVIEW_HPP
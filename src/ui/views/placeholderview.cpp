@@ -0,0 +1,96 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+
+#include <QSettings>
+#include <QString>
+#include <QStringList>
+#include <QUuid>
+#include <QVariant>
+#include <QVariantMap>
+
+#include "placeholderview.hpp"
+#include "src/session.hpp"
+#include "src/devices/basedevice.hpp"
+#include "src/ui/views/baseview.hpp"
+#include "src/ui/views/viewhelper.hpp"
+
+using std::shared_ptr;
+
+namespace sv {
+namespace ui {
+namespace views {
+
+PlaceholderView::PlaceholderView(Session &session, QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device, QWidget *parent) :
+	BaseView(session, settings.value("uuid").toUuid(), parent),
+	origin_device_(origin_device),
+	settings_group_(settings.group())
+{
+	// The id must be the id of the real view, because the dock widget state
+	// is restored by the object name, see BaseTab::create_dock_widget().
+	id_ = settings.value("id").toString().toStdString();
+	title_ = settings.value("title", QVariant(tr("View"))).toString();
+
+	const QStringList keys = settings.allKeys();
+	for (const auto &key : keys)
+		settings_.insert(key, settings.value(key));
+
+	BaseView::restore_settings(settings, origin_device);
+}
+
+QString PlaceholderView::title() const
+{
+	return title_;
+}
+
+BaseView *PlaceholderView::create_view() const
+{
+	// The view is restored from the group, where the placeholder was
+	// restored from or saved to the last time.
+	QSettings settings;
+	settings.beginGroup(settings_group_);
+	auto *view = viewhelper::get_view_from_settings(
+		session_, settings, origin_device_);
+	settings.endGroup();
+	return view;
+}
+
+void PlaceholderView::save_settings(QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device) const
+{
+	for (auto it = settings_.constBegin(); it != settings_.constEnd(); ++it)
+		settings.setValue(it.key(), it.value());
+	// The group changes, when the views of the tab are saved in a different
+	// order.
+	settings_group_ = settings.group();
+
+	// Update the size.
+	BaseView::save_settings(settings, origin_device);
+}
+
+void PlaceholderView::resume()
+{
+	Q_EMIT create_view_requested();
+}
+
+} // namespace views
+} // namespace ui
+} // namespace sv
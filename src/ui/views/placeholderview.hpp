@@ -0,0 +1,100 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_VIEWS_PLACEHOLDERVIEW_HPP
+#define UI_VIEWS_PLACEHOLDERVIEW_HPP
+
+#include <memory>
+
+#include <QSettings>
+#include <QString>
+#include <QVariantMap>
+#include <QWidget>
+
+#include "src/ui/views/baseview.hpp"
+
+using std::shared_ptr;
+
+namespace sv {
+
+class Session;
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace ui {
+namespace views {
+
+/**
+ * A lightweight stand-in for a view, that was saved in the settings. The
+ * real view (with its plots, curves, tables, ...) is only created, when the
+ * placeholder is shown for the first time.
+ *
+ * The placeholder keeps a copy of the view settings and saves them again
+ * unchanged, so a view that was never shown isn't lost. The real view is
+ * created from the settings group, the placeholder was saved to last.
+ */
+class PlaceholderView : public BaseView
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * Create a placeholder from the settings group of a view.
+	 */
+	PlaceholderView(Session &session, QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device,
+		QWidget *parent = nullptr);
+
+	QString title() const override;
+
+	/**
+	 * Create the real view from the stored settings. Returns nullptr, if the
+	 * view couldn't be created.
+	 */
+	BaseView *create_view() const;
+
+	void save_settings(QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device = nullptr) const override;
+
+protected:
+	void resume() override;
+
+private:
+	QVariantMap settings_;
+	shared_ptr<sv::devices::BaseDevice> origin_device_;
+	/** The application settings group of the view. */
+	mutable QString settings_group_;
+	QString title_;
+
+Q_SIGNALS:
+	/**
+	 * Emitted, when the placeholder is shown. The tab must replace the
+	 * placeholder with the view from create_view().
+	 */
+	void create_view_requested();
+
+};
+
+} // namespace views
+} // namespace ui
+} // namespace sv
+
+#endif // UI_VIEWS_PLACEHOLDERVIEW_HPP
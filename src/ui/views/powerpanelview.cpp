@@ -17,15 +17,14 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
 
 #include <QApplication>
-#include <QDateTime>
 #include <QDebug>
 #include <QSettings>
-#include <QTimer>
 #include <QUuid>
 #include <QVBoxLayout>
 
@@ -37,12 +36,15 @@
 #include "src/data/analogbasesignal.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/poweraccumulator.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/views/baseview.hpp"
 #include "src/ui/views/viewhelper.hpp"
 #include "src/ui/widgets/monofontdisplay.hpp"
+#include "src/ui/widgets/plot/plotrefreshscheduler.hpp"
 
 using std::dynamic_pointer_cast;
+using std::make_shared;
 using std::set;
 using std::shared_ptr;
 using sv::data::QuantityFlag;
@@ -55,16 +57,8 @@ PowerPanelView::PowerPanelView(Session &session, QUuid uuid, QWidget *parent) :
 	BaseView(session, uuid, parent),
 	voltage_signal_(nullptr),
 	current_signal_(nullptr),
-	voltage_min_(std::numeric_limits<double>::max()),
-	voltage_max_(std::numeric_limits<double>::lowest()),
-	current_min_(std::numeric_limits<double>::max()),
-	current_max_(std::numeric_limits<double>::lowest()),
-	resistance_min_(std::numeric_limits<double>::max()),
-	resistance_max_(std::numeric_limits<double>::lowest()),
-	power_min_(std::numeric_limits<double>::max()),
-	power_max_(std::numeric_limits<double>::lowest()),
-	actual_amp_hours_(0),
-	actual_watt_hours_(0),
+	accumulator_(nullptr),
+	shown_generation_(std::numeric_limits<size_t>::max()),
 	action_reset_displays_(new QAction(this))
 {
 	id_ = "powerpanel:" + util::format_uuid(uuid_);
@@ -74,13 +68,12 @@ PowerPanelView::PowerPanelView(Session &session, QUuid uuid, QWidget *parent) :
 	connect_signals();
 	reset_displays();
 
-	timer_ = new QTimer(this);
-	init_timer();
+	session_.plot_refresh_scheduler()->add_panel(this, [this]() { refresh(); });
 }
 
 PowerPanelView::~PowerPanelView()
 {
-	stop_timer();
+	session_.plot_refresh_scheduler()->remove_panel(this);
 }
 
 QString PowerPanelView::title() const
@@ -114,10 +107,11 @@ void PowerPanelView::set_signals(
 	assert(current_signal);
 
 	disconnect_signals();
-	stop_timer();
 	voltage_signal_ = voltage_signal;
 	current_signal_ = current_signal;
-	init_timer();
+	accumulator_ = make_shared<sv::data::PowerAccumulator>(
+		voltage_signal_, current_signal_);
+	reset_displays();
 	init_displays();
 	connect_signals();
 
@@ -371,6 +365,10 @@ void PowerPanelView::restore_settings(QSettings &settings,
 
 void PowerPanelView::reset_displays()
 {
+	if (accumulator_)
+		accumulator_->reset();
+	shown_generation_ = std::numeric_limits<size_t>::max();
+
 	voltage_display_->reset_value();
 	voltage_min_display_->reset_value();
 	voltage_max_display_->reset_value();
@@ -391,99 +389,43 @@ void PowerPanelView::reset_displays()
 	watt_hour_display_->reset_value();
 }
 
-void PowerPanelView::init_timer()
+void PowerPanelView::refresh()
 {
-	start_time_ = QDateTime::currentMSecsSinceEpoch();
-	last_time_ = start_time_;
-
-	voltage_min_ = std::numeric_limits<double>::max();
-	voltage_max_ = std::numeric_limits<double>::lowest();
-	current_min_ = std::numeric_limits<double>::max();
-	current_max_ = std::numeric_limits<double>::lowest();
-	resistance_min_ = std::numeric_limits<double>::max();
-	resistance_max_ = std::numeric_limits<double>::lowest();
-	power_min_ = std::numeric_limits<double>::max();
-	power_max_ = std::numeric_limits<double>::lowest();
-	actual_amp_hours_ = 0;
-	actual_watt_hours_ = 0;
-
-	connect(timer_, &QTimer::timeout, this, &PowerPanelView::on_update);
-	timer_->start(250);
-}
+	if (!accumulator_)
+		return;
 
-void PowerPanelView::stop_timer()
-{
-	if (!timer_->isActive())
+	const size_t generation = accumulator_->generation();
+	if (generation == shown_generation_)
 		return;
 
-	timer_->stop();
-	disconnect(timer_, &QTimer::timeout, this, &PowerPanelView::on_update);
+	const auto statistics = accumulator_->statistics();
+	if (statistics.sample_count == 0)
+		return;
+	shown_generation_ = generation;
 
-	reset_displays();
-}
+	voltage_display_->set_value(statistics.voltage);
+	voltage_min_display_->set_value(statistics.voltage_min);
+	voltage_max_display_->set_value(statistics.voltage_max);
 
-void PowerPanelView::on_update()
-{
-	if (!voltage_signal_ || voltage_signal_->sample_count() == 0 ||
-			!current_signal_ || current_signal_->sample_count() == 0)
-		return;
+	current_display_->set_value(statistics.current);
+	current_min_display_->set_value(statistics.current_min);
+	current_max_display_->set_value(statistics.current_max);
 
-	qint64 now = QDateTime::currentMSecsSinceEpoch();
-	double elapsed_time = (double)(now - last_time_) / (double)3600000; // / 1h
-	last_time_ = now;
-
-	double voltage = voltage_signal_->last_value();
-	if (voltage_min_ > voltage)
-		voltage_min_ = voltage;
-	if (voltage_max_ < voltage)
-		voltage_max_ = voltage;
-
-	double current = current_signal_->last_value();
-	if (current_min_ > current)
-		current_min_ = current;
-	if (current_max_ < current)
-		current_max_ = current;
-
-	double resistance = current == 0. ?
-		std::numeric_limits<double>::max() : voltage / current;
-	if (resistance_min_ > resistance)
-		resistance_min_ = resistance;
-	if (resistance_max_ < resistance)
-		resistance_max_ = resistance;
-
-	double power = voltage * current;
-	if (power_min_ > power)
-		power_min_ = power;
-	if (power_max_ < power)
-		power_max_ = power;
-
-	actual_amp_hours_ = actual_amp_hours_ + (current * elapsed_time);
-	actual_watt_hours_ = actual_watt_hours_ + (power * elapsed_time);
-
-	voltage_display_->set_value(voltage);
-	voltage_min_display_->set_value(voltage_min_);
-	voltage_max_display_->set_value(voltage_max_);
-
-	current_display_->set_value(current);
-	current_min_display_->set_value(current_min_);
-	current_max_display_->set_value(current_max_);
-
-	resistance_display_->set_value(resistance);
-	resistance_min_display_->set_value(resistance_min_);
-	resistance_max_display_->set_value(resistance_max_);
-
-	power_display_->set_value(power);
-	power_min_display_->set_value(power_min_);
-	power_max_display_->set_value(power_max_);
-
-	amp_hour_display_->set_value(actual_amp_hours_);
-	watt_hour_display_->set_value(actual_watt_hours_);
+	resistance_display_->set_value(statistics.resistance);
+	resistance_min_display_->set_value(statistics.resistance_min);
+	resistance_max_display_->set_value(statistics.resistance_max);
+
+	power_display_->set_value(statistics.power);
+	power_min_display_->set_value(statistics.power_min);
+	power_max_display_->set_value(statistics.power_max);
+
+	amp_hour_display_->set_value(statistics.amp_hours);
+	watt_hour_display_->set_value(statistics.watt_hours);
 }
 
 void PowerPanelView::on_action_reset_displays_triggered()
 {
-	stop_timer();
-	init_timer();
+	reset_displays();
 }
 
 void PowerPanelView::on_digits_changed()
@@ -24,7 +24,6 @@
 
 #include <QAction>
 #include <QSettings>
-#include <QTimer>
 #include <QToolBar>
 #include <QUuid>
 
@@ -38,6 +37,7 @@ class Session;
 
 namespace data {
 class AnalogTimeSignal;
+class PowerAccumulator;
 }
 namespace devices {
 class BaseDevice;
@@ -73,21 +73,11 @@ private:
 	shared_ptr<sv::data::AnalogTimeSignal> voltage_signal_;
 	shared_ptr<sv::data::AnalogTimeSignal> current_signal_;
 
-	QTimer *timer_;
-	qint64 start_time_;
-	qint64 last_time_;
-
-	// Min/max/actual values are stored here, so they can be reseted
-	double voltage_min_;
-	double voltage_max_;
-	double current_min_;
-	double current_max_;
-	double resistance_min_;
-	double resistance_max_;
-	double power_min_;
-	double power_max_;
-	double actual_amp_hours_;
-	double actual_watt_hours_;
+	/** Accumulates the values sample by sample on the worker pool. */
+	shared_ptr<sv::data::PowerAccumulator> accumulator_;
+
+	/** The accumulator generation, that is shown in the displays. */
+	size_t shown_generation_;
 
 	QAction *const action_reset_displays_;
 	QToolBar *toolbar_;
@@ -112,11 +102,14 @@ private:
 	void connect_signals();
 	void disconnect_signals();
 	void reset_displays();
-	void init_timer();
-	void stop_timer();
+	/**
+	 * Update the displays, if the accumulated values have changed since the
+	 * last update. This is called by the PlotRefreshScheduler at most once
+	 * per frame.
+	 */
+	void refresh();
 
 private Q_SLOTS:
-	void on_update();
 	void on_action_reset_displays_triggered();
 	void on_digits_changed();
 
@@ -0,0 +1,247 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <memory>
+#include <string>
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QLabel>
+#include <QMessageBox>
+#include <QSettings>
+#include <QSpinBox>
+#include <QToolBar>
+#include <QUuid>
+
+#include "scopeplotview.hpp"
+#include "src/session.hpp"
+#include "src/util.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/hardwarechannel.hpp"
+#include "src/data/basesignal.hpp"
+#include "src/data/framebuffer.hpp"
+#include "src/devices/basedevice.hpp"
+#include "src/ui/dialogs/selectsignaldialog.hpp"
+#include "src/ui/views/baseplotview.hpp"
+#include "src/ui/widgets/plot/curve.hpp"
+#include "src/ui/widgets/plot/decimatingplotcurve.hpp"
+#include "src/ui/widgets/plot/plot.hpp"
+#include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/scopecurvedata.hpp"
+
+using std::dynamic_pointer_cast;
+using std::shared_ptr;
+using std::string;
+
+namespace sv {
+namespace ui {
+namespace views {
+
+ScopePlotView::ScopePlotView(Session &session, QUuid uuid,
+		QWidget *parent) :
+	BasePlotView(session, uuid, parent)
+{
+	id_ = "scopeplot:" + util::format_uuid(uuid_);
+	plot_type_ = PlotType::ScopePlot;
+
+	setup_scope_toolbar();
+}
+
+void ScopePlotView::setup_scope_toolbar()
+{
+	display_mode_box_ = new QComboBox();
+	for (const auto &mode_name : widgets::plot::scope_display_mode_name_map) {
+		display_mode_box_->addItem(mode_name.second, (int)mode_name.first);
+	}
+	connect(display_mode_box_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+		this, &ScopePlotView::on_display_mode_changed);
+
+	frame_count_spin_ = new QSpinBox();
+	frame_count_spin_->setRange(1, 1024);
+	frame_count_spin_->setValue(16);
+	frame_count_spin_->setToolTip(
+		tr("Number of frames for averaging, peak detect and persistence"));
+	connect(frame_count_spin_, QOverload<int>::of(&QSpinBox::valueChanged),
+		this, &ScopePlotView::on_frame_count_changed);
+
+	store_frames_check_ = new QCheckBox(tr("Store frames"));
+	store_frames_check_->setChecked(true);
+	store_frames_check_->setToolTip(
+		tr("Append the frames to the signals of the channels. If disabled, "
+			"only the last frames are kept and the frames are not available "
+			"in other views, math channels and exports."));
+	connect(store_frames_check_, &QCheckBox::toggled,
+		this, &ScopePlotView::on_store_frames_changed);
+
+	scope_toolbar_ = new QToolBar("Scope Toolbar");
+	scope_toolbar_->addWidget(new QLabel(tr("Display ")));
+	scope_toolbar_->addWidget(display_mode_box_);
+	scope_toolbar_->addSeparator();
+	scope_toolbar_->addWidget(new QLabel(tr("Frames ")));
+	scope_toolbar_->addWidget(frame_count_spin_);
+	scope_toolbar_->addSeparator();
+	scope_toolbar_->addWidget(store_frames_check_);
+	this->addToolBar(Qt::TopToolBarArea, scope_toolbar_);
+}
+
+QString ScopePlotView::title() const
+{
+	QString title = tr("Scope");
+	QString sep(" ");
+	for (const auto &curve : plot_->curve_map()) {
+		title = title.append(sep).append(curve.second->name());
+		sep = ", ";
+	}
+	return title;
+}
+
+string ScopePlotView::add_channel(
+	shared_ptr<sv::channels::HardwareChannel> channel)
+{
+	assert(channel);
+	string id;
+
+	// Check if the channel is already added to this plot
+	for (const auto &curve : plot_->curve_map()) {
+		auto *curve_data = qobject_cast<widgets::plot::ScopeCurveData *>(
+			curve.second->curve_data());
+		if (curve_data && curve_data->channel() == channel)
+			return id;
+	}
+
+	channel->frame_buffer()->set_frame_count(frame_count_spin_->value());
+	channel->set_store_frames_in_signal(store_frames_check_->isChecked());
+	auto *curve = new widgets::plot::ScopeCurveData(channel,
+		(widgets::plot::ScopeDisplayMode)display_mode_box_->currentData().toInt());
+	id = plot_->add_curve(curve);
+	if (!id.empty()) {
+		apply_display_mode();
+		Q_EMIT title_changed();
+	}
+	else {
+		QMessageBox::warning(this,
+			tr("Cannot add channel"), tr("Cannot add scope channel to plot!"),
+			QMessageBox::Ok);
+	}
+	return id;
+}
+
+void ScopePlotView::apply_display_mode()
+{
+	const auto display_mode = (widgets::plot::ScopeDisplayMode)
+		display_mode_box_->currentData().toInt();
+	for (const auto &curve : plot_->curve_map()) {
+		auto *curve_data = qobject_cast<widgets::plot::ScopeCurveData *>(
+			curve.second->curve_data());
+		if (!curve_data)
+			continue;
+		curve_data->set_display_mode(display_mode);
+		// The stored frames are drawn as density map, so the persistence
+		// shows how often a waveform hits a pixel.
+		curve.second->set_render_mode(
+			display_mode == widgets::plot::ScopeDisplayMode::Persistence ?
+				widgets::plot::CurveRenderMode::Density :
+				widgets::plot::CurveRenderMode::Lines);
+	}
+}
+
+void ScopePlotView::save_settings(QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device) const
+{
+	BasePlotView::save_settings(settings, origin_device);
+	settings.setValue("display_mode", display_mode_box_->currentData());
+	settings.setValue("frame_count", frame_count_spin_->value());
+	settings.setValue("store_frames", store_frames_check_->isChecked());
+	plot_->save_settings(settings, true, origin_device);
+}
+
+void ScopePlotView::restore_settings(QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device)
+{
+	BasePlotView::restore_settings(settings, origin_device);
+	if (settings.contains("display_mode")) {
+		display_mode_box_->setCurrentIndex(
+			display_mode_box_->findData(settings.value("display_mode")));
+	}
+	if (settings.contains("frame_count"))
+		frame_count_spin_->setValue(settings.value("frame_count").toInt());
+	if (settings.contains("store_frames")) {
+		store_frames_check_->setChecked(
+			settings.value("store_frames").toBool());
+	}
+	plot_->restore_settings(settings, true, origin_device);
+	apply_display_mode();
+	on_store_frames_changed();
+}
+
+void ScopePlotView::on_action_add_curve_triggered()
+{
+	ui::dialogs::SelectSignalDialog dlg(session(), nullptr);
+	if (!dlg.exec())
+		return;
+
+	for (const auto &signal : dlg.signals()) {
+		auto channel = dynamic_pointer_cast<sv::channels::HardwareChannel>(
+			signal->parent_channel());
+		if (!channel) {
+			QMessageBox::warning(this,
+				tr("Cannot add channel"),
+				tr("The signal %1 doesn't belong to a hardware channel!").
+					arg(signal->display_name()),
+				QMessageBox::Ok);
+			continue;
+		}
+		add_channel(channel);
+	}
+}
+
+void ScopePlotView::on_display_mode_changed()
+{
+	apply_display_mode();
+	plot_->replot();
+}
+
+void ScopePlotView::on_frame_count_changed()
+{
+	for (const auto &curve : plot_->curve_map()) {
+		auto *curve_data = qobject_cast<widgets::plot::ScopeCurveData *>(
+			curve.second->curve_data());
+		if (curve_data) {
+			curve_data->channel()->frame_buffer()->set_frame_count(
+				frame_count_spin_->value());
+		}
+	}
+}
+
+void ScopePlotView::on_store_frames_changed()
+{
+	for (const auto &curve : plot_->curve_map()) {
+		auto *curve_data = qobject_cast<widgets::plot::ScopeCurveData *>(
+			curve.second->curve_data());
+		if (curve_data) {
+			curve_data->channel()->set_store_frames_in_signal(
+				store_frames_check_->isChecked());
+		}
+	}
+}
+
+} // namespace views
+} // namespace ui
+} // namespace sv
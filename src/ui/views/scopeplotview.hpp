@@ -0,0 +1,106 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_VIEWS_SCOPEPLOTVIEW_HPP
+#define UI_VIEWS_SCOPEPLOTVIEW_HPP
+
+#include <memory>
+#include <string>
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QSettings>
+#include <QSpinBox>
+#include <QToolBar>
+#include <QUuid>
+
+#include "src/ui/views/baseplotview.hpp"
+
+using std::shared_ptr;
+using std::string;
+
+namespace sv {
+
+class Session;
+
+namespace channels {
+class HardwareChannel;
+}
+namespace devices {
+class BaseDevice;
+}
+
+namespace ui {
+
+namespace widgets {
+namespace plot {
+enum class ScopeDisplayMode;
+}
+}
+
+namespace views {
+
+/**
+ * Plot the frames of oscilloscope channels. The frames can be shown as last
+ * frame, average, peak detect envelope or with persistence.
+ */
+class ScopePlotView : public BasePlotView
+{
+	Q_OBJECT
+
+public:
+	explicit ScopePlotView(Session &session, QUuid uuid = QUuid(),
+		QWidget *parent = nullptr);
+
+	QString title() const override;
+
+	void save_settings(QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device = nullptr) const override;
+	void restore_settings(QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device = nullptr) override;
+
+	/**
+	 * Add the frames of a channel to the plot. Return the curve id.
+	 */
+	string add_channel(shared_ptr<sv::channels::HardwareChannel> channel);
+
+private:
+	void setup_scope_toolbar();
+	void apply_display_mode();
+
+	QComboBox *display_mode_box_;
+	QSpinBox *frame_count_spin_;
+	QCheckBox *store_frames_check_;
+	QToolBar *scope_toolbar_;
+
+protected Q_SLOTS:
+	void on_action_add_curve_triggered() override;
+
+private Q_SLOTS:
+	void on_display_mode_changed();
+	void on_frame_count_changed();
+	void on_store_frames_changed();
+
+};
+
+} // namespace views
+} // namespace ui
+} // namespace sv
+
+#endif // UI_VIEWS_SCOPEPLOTVIEW_HPP
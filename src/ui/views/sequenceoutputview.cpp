@@ -17,10 +17,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <QAction>
@@ -33,6 +36,7 @@
 #include <QHBoxLayout>
 #include <QHeaderView>
 #include <QLabel>
+#include <QItemSelectionModel>
 #include <QList>
 #include <QLocale>
 #include <QMessageBox>
@@ -40,28 +44,38 @@
 #include <QSpinBox>
 #include <QString>
 #include <QStringList>
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QTableView>
 #include <QTextStream>
-#include <QTimer>
 #include <QToolBar>
 #include <QUuid>
 #include <QVariant>
 #include <QVBoxLayout>
 
 #include "sequenceoutputview.hpp"
+#include "src/sequenceoutputengine.hpp"
 #include "src/session.hpp"
 #include "src/settingsmanager.hpp"
 #include "src/util.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/userchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/basesignal.hpp"
+#include "src/data/datautil.hpp"
 #include "src/data/properties/doubleproperty.hpp"
 #include "src/devices/basedevice.hpp"
+#include "src/devices/configurable.hpp"
 #include "src/ui/datatypes/doublespinbox.hpp"
 #include "src/ui/dialogs/generatewaveformdialog.hpp"
 #include "src/ui/views/baseview.hpp"
 #include "src/ui/views/viewhelper.hpp"
+#include "src/ui/widgets/sequencetablemodel.hpp"
+#include "src/ui/widgets/plot/plotrefreshscheduler.hpp"
 
 using std::dynamic_pointer_cast;
+using std::make_pair;
+using std::set;
 using std::shared_ptr;
+using std::static_pointer_cast;
 using std::string;
 using std::vector;
 
@@ -134,19 +148,23 @@ SequenceOutputView::SequenceOutputView(Session &session, QUuid uuid,
 	action_delete_all_(new QAction(this)),
 	action_load_from_file_(new QAction(this)),
 	action_generate_waveform_(new QAction(this)),
-	sequence_pos_(0)
+	engine_(new SequenceOutputEngine(this)),
+	jitter_signal_(nullptr),
+	shown_position_(-1)
 {
 	id_ = "sequenceoutput:" + util::format_uuid(uuid_);
 
 	setup_ui();
 	setup_toolbar();
 
-	timer_ = new QTimer(this);
+	// The engine thread emits finished(), so this is a queued connection.
+	connect(engine_, &SequenceOutputEngine::finished,
+		this, &SequenceOutputView::on_sequence_finished);
 }
 
 SequenceOutputView::~SequenceOutputView()
 {
-	stop_timer();
+	stop_sequence();
 }
 
 QString SequenceOutputView::title() const
@@ -162,9 +180,10 @@ void SequenceOutputView::set_property(
 {
 	assert(property);
 
-	stop_timer();
+	stop_sequence();
 
 	property_ = property;
+	jitter_signal_ = nullptr;
 	sequence_table_->setItemDelegateForColumn(0,
 		new DoubleSpinBoxDelegate(property_->min(), property_->max(),
 			property_->step(), property_->decimal_places()));
@@ -195,14 +214,11 @@ void SequenceOutputView::setup_ui()
 	repeat_layout->addStretch(1);
 	layout->addItem(repeat_layout);
 
-	sequence_table_ = new QTableWidget();
-	sequence_table_->setColumnCount(2);
-	QTableWidgetItem *value_header_item = new QTableWidgetItem(tr("Value"));
-	sequence_table_->setHorizontalHeaderItem(0, value_header_item);
+	sequence_model_ = new widgets::SequenceTableModel(this);
+	sequence_table_ = new QTableView();
+	sequence_table_->setModel(sequence_model_);
 	sequence_table_->horizontalHeader()->setSectionResizeMode(
 		0, QHeaderView::Stretch);
-	QTableWidgetItem *delay_header_item = new QTableWidgetItem(tr("Delay [s]"));
-	sequence_table_->setHorizontalHeaderItem(1, delay_header_item);
 	sequence_table_->horizontalHeader()->setSectionResizeMode(
 		1, QHeaderView::Stretch);
 	sequence_table_->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
@@ -211,7 +227,6 @@ void SequenceOutputView::setup_ui()
 	sequence_table_->setItemDelegateForColumn(1,
 		new DoubleSpinBoxDelegate(0, 100000, 0.1, 3));
 
-	//sequence_table_->setRowCount(1);
 	layout->addWidget(sequence_table_);
 
 	this->central_widget_->setLayout(layout);
@@ -288,20 +303,7 @@ void SequenceOutputView::save_settings(QSettings &settings,
 		QVariant(repeat_infinite_box_->checkState()));
 	settings.setValue("repeat_count", QVariant(repeat_count_box_->value()));
 
-	// Save sequence
-	int row_count = sequence_table_->rowCount();
-	settings.setValue("sequence_row_count", QVariant(row_count));
-	for (int pos=0; pos<row_count; pos++) {
-		QTableWidgetItem *value_item = sequence_table_->item(pos, 0);
-		QTableWidgetItem *delay_item = sequence_table_->item(pos, 1);
-		if (!value_item || !delay_item)
-			continue;
-
-		settings.beginGroup(QString("sequence_").append(QString::number(pos)));
-		settings.setValue("value", value_item->data(0));
-		settings.setValue("delay", delay_item->data(0));
-		settings.endGroup();
-	}
+	sequence_model_->save_settings(settings);
 }
 
 void SequenceOutputView::restore_settings(QSettings &settings,
@@ -322,41 +324,31 @@ void SequenceOutputView::restore_settings(QSettings &settings,
 	if (settings.contains("repeat_count"))
 		repeat_count_box_->setValue(settings.value("repeat_count").toInt());
 
-	// Restore sequence
-	int row_count = settings.value("sequence_row_count").toInt();
-	for (int pos=0; pos<row_count; pos++) {
-		settings.beginGroup(QString("sequence_").append(QString::number(pos)));
-		QVariant value = settings.value("value");
-		QVariant delay = settings.value("delay");
-		sequence_table_->insertRow(pos);
-		QTableWidgetItem *value_item = new QTableWidgetItem(QString::number(
-			value.toDouble(), 'f', 3));
-		value_item->setData(0, value);
-		sequence_table_->setItem(pos, 0, value_item);
-		QTableWidgetItem *delay_item = new QTableWidgetItem(QString::number(
-			delay.toDouble(), 'f', property_->decimal_places()));
-		delay_item->setData(0, delay);
-		sequence_table_->setItem(pos, 1, delay_item);
-		settings.endGroup();
-	}
+	sequence_model_->restore_settings(settings);
 }
 
-void SequenceOutputView::start_timer()
+void SequenceOutputView::start_sequence()
 {
-	if (timer_->isActive()) {
-		timer_->stop();
-		disconnect(timer_, &QTimer::timeout,
-			this, &SequenceOutputView::on_timer_update);
-	}
+	stop_sequence();
+
+	if (!property_ || sequence_model_->rowCount() == 0)
+		return;
+
+	// The engine thread gets its own copy of the sequence.
+	vector<SequenceStep> steps = sequence_model_->steps();
+
+	unsigned int repeat_count = 0;
+	if (!repeat_infinite_box_->isChecked())
+		repeat_count = static_cast<unsigned int>(repeat_count_box_->value());
 
-	sequence_pos_ = 0;
-	sequence_reperat_count_ = 0;
-	if (sequence_table_->rowCount() == 0)
+	engine_->start(property_, std::move(steps), repeat_count,
+		init_jitter_signal());
+	if (!engine_->is_running())
 		return;
 
-	connect(timer_, &QTimer::timeout,
-		this, &SequenceOutputView::on_timer_update);
-	timer_->start();
+	shown_position_ = -1;
+	session_.plot_refresh_scheduler()->add_panel(
+		this, [this]() { refresh_position(); });
 
 	action_run_->setText(tr("Stop"));
 	action_run_->setIcon(
@@ -365,7 +357,7 @@ void SequenceOutputView::start_timer()
 	action_run_->setChecked(true);
 }
 
-void SequenceOutputView::stop_timer()
+void SequenceOutputView::stop_sequence()
 {
 	action_run_->setText(tr("Run"));
 	action_run_->setIcon(
@@ -373,81 +365,80 @@ void SequenceOutputView::stop_timer()
 		QIcon(":/icons/media-playback-start.png")));
 	action_run_->setChecked(false);
 
-	if (!timer_->isActive())
-		return;
-
-	timer_->stop();
-	disconnect(timer_, &QTimer::timeout,
-		this, &SequenceOutputView::on_timer_update);
-	sequence_pos_ = 0;
-	sequence_reperat_count_ = 0;
+	session_.plot_refresh_scheduler()->remove_panel(this);
+	engine_->stop();
 }
 
-void SequenceOutputView::insert_row(int row, double value, double delay)
+void SequenceOutputView::refresh_position()
 {
-	if (!property_) {
-		QMessageBox::warning(this, tr("No property assigned."),
-			tr("Please assign a property to this sequence output view first."),
-			QMessageBox::Ok);
-	}
+	const int position = static_cast<int>(engine_->position());
+	if (position == shown_position_)
+		return;
 
-	sequence_table_->insertRow(row);
-	QTableWidgetItem *value_item = new QTableWidgetItem(
-		QString::number(value, 'f', 3));
-	value_item->setData(0, QVariant(value));
-	sequence_table_->setItem(row, 0, value_item);
-	QTableWidgetItem *delay_item = new QTableWidgetItem(
-		QString::number(delay, 'f', property_->decimal_places()));
-	delay_item->setData(0, QVariant(delay));
-	sequence_table_->setItem(row, 1, delay_item);
+	shown_position_ = position;
+	sequence_table_->selectRow(position);
 }
 
-void SequenceOutputView::on_timer_update()
+shared_ptr<data::AnalogTimeSignal> SequenceOutputView::init_jitter_signal()
 {
-	if (!property_) {
-		stop_timer();
-		return;
-	}
-
-	bool found_value = sequence_pos_ > 0;
-	double value = .0;
-	int delay_ms = 0;
-	// Cycle through the row until a duration is found.
-	do {
-		if (sequence_table_->rowCount() == 0) {
-			stop_timer();
-			return;
-		}
-		if (sequence_pos_ >= sequence_table_->rowCount()) {
-			// Jump up to the first row
-			sequence_pos_ = 0;
-			if (!found_value) {
-				stop_timer();
-				return;
-			}
-			if (!repeat_infinite_box_->isChecked()) {
-				sequence_reperat_count_++;
-				if (sequence_reperat_count_ >= repeat_count_box_->value()) {
-					stop_timer();
-					return;
-				}
+	if (jitter_signal_)
+		return jitter_signal_;
+
+	// Find the device of the property and reuse the jitter channel of a
+	// previous run.
+	shared_ptr<channels::UserChannel> jitter_channel;
+	const auto configurable = property_->configurable();
+	for (const auto &device_pair : session_.device_map()) {
+		auto device = device_pair.second;
+		bool found = false;
+		for (const auto &configurable_pair : device->configurable_map()) {
+			if (configurable_pair.second == configurable) {
+				found = true;
+				break;
 			}
 		}
+		if (!found)
+			continue;
 
-		QTableWidgetItem *value_item = sequence_table_->item(sequence_pos_, 0);
-		if (value_item)
-			value = value_item->data(0).toDouble();
-		QTableWidgetItem *delay_item = sequence_table_->item(sequence_pos_, 1);
-		if (delay_item)
-			delay_ms = (int)std::round(delay_item->data(0).toDouble() * 1000);
-
-		sequence_table_->selectRow(sequence_pos_);
-		sequence_pos_++;
+		const string channel_name =
+			property_->display_name().toStdString() + " Jitter";
+		auto channel_map = device->channel_map();
+		if (channel_map.count(channel_name) > 0) {
+			jitter_channel = dynamic_pointer_cast<channels::UserChannel>(
+				channel_map[channel_name]);
+		}
+		if (!jitter_channel)
+			jitter_channel = device->add_user_channel(channel_name, "Sequence");
+		break;
+	}
+	if (!jitter_channel)
+		return nullptr;
+
+	// Adding a signal creates QObjects and emits the signal_added() signal,
+	// so this must not be done by the engine.
+	const data::measured_quantity_t mq =
+		make_pair(data::Quantity::Time, set<data::QuantityFlag>());
+	auto signal_map = jitter_channel->signal_map();
+	shared_ptr<data::BaseSignal> signal;
+	if (signal_map.count(mq) > 0 && !signal_map[mq].empty())
+		signal = signal_map[mq][0];
+	else {
+		signal = jitter_channel->add_signal(data::Quantity::Time,
+			set<data::QuantityFlag>(), data::Unit::Second);
 	}
-	while (delay_ms <= 0);
 
-	property_->change_value(value);
-	timer_->setInterval(delay_ms);
+	jitter_signal_ = static_pointer_cast<data::AnalogTimeSignal>(signal);
+	return jitter_signal_;
+}
+
+void SequenceOutputView::on_sequence_finished()
+{
+	// The sequence may have been restarted in the meantime.
+	if (engine_->is_running())
+		return;
+
+	refresh_position();
+	stop_sequence();
 }
 
 void SequenceOutputView::on_repeat_infinite_changed()
@@ -461,30 +452,42 @@ void SequenceOutputView::on_repeat_infinite_changed()
 void SequenceOutputView::on_action_run_triggered()
 {
 	if (action_run_->isChecked())
-		start_timer();
+		start_sequence();
 	else
-		stop_timer();
+		stop_sequence();
 }
 
 void SequenceOutputView::on_action_add_row()
 {
-	int row = sequence_table_->currentRow() + 1;
-	insert_row(row, .0, .0);
+	int row = sequence_table_->currentIndex().row() + 1;
+	sequence_model_->insert_step(row, .0, .0);
 }
 
 void SequenceOutputView::on_action_delete_row()
 {
-	// NOTE: If the cells are empty, there is no item to be returned by
-	//       selectedItems() and selectedIndexes() is protected...
-	const auto items = sequence_table_->selectedItems();
-	for (const auto &item : items) {
-		sequence_table_->removeRow(item->row());
+	vector<int> rows;
+	const auto indexes = sequence_table_->selectionModel()->selectedIndexes();
+	for (const auto &index : indexes)
+		rows.push_back(index.row());
+	std::sort(rows.begin(), rows.end());
+	rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+	// Remove contiguous ranges from the bottom up, so the row numbers of the
+	// remaining ranges stay valid.
+	size_t end = rows.size();
+	while (end > 0) {
+		size_t start = end - 1;
+		while (start > 0 && rows[start-1] == rows[start] - 1)
+			--start;
+		sequence_model_->remove_steps(rows[start],
+			static_cast<int>(end - start));
+		end = start;
 	}
 }
 
 void SequenceOutputView::on_action_delete_all()
 {
-	sequence_table_->setRowCount(0);
+	sequence_model_->clear();
 }
 
 void SequenceOutputView::on_action_load_from_file_triggered()
@@ -494,10 +497,11 @@ void SequenceOutputView::on_action_load_from_file_triggered()
 	if (file_name.length() <= 0)
 		return;
 
+	vector<double> values;
+	vector<double> delays;
 	std::ifstream file(file_name.toStdString());
 	if (file.is_open()) {
 		string line;
-		int row = 0;
 		while (std::getline(file, line)) {
 			auto fields = sv::util::parse_csv_line(line);
 
@@ -515,11 +519,13 @@ void SequenceOutputView::on_action_load_from_file_triggered()
 			if (!ok)
 				continue;
 
-			insert_row(row, value, delay);
-			row++;
+			values.push_back(value);
+			delays.push_back(delay);
 		}
 	}
 	file.close();
+
+	sequence_model_->insert_steps(0, values, delays);
 }
 
 void SequenceOutputView::on_action_generate_waveform_triggered()
@@ -528,17 +534,14 @@ void SequenceOutputView::on_action_generate_waveform_triggered()
 		QMessageBox::warning(this, tr("No property assigned."),
 			tr("Please assign a property to this sequence output view first."),
 			QMessageBox::Ok);
+		return;
 	}
 
 	ui::dialogs::GenerateWaveformDialog dlg(property_);
 	if (!dlg.exec())
 		return;
 
-	vector<double> sequence_values = dlg.sequence_values();
-	vector<double> sequence_delays = dlg.sequence_delays();
-	for (size_t i=0; i<sequence_values.size(); ++i) {
-		insert_row(static_cast<int>(i), sequence_values[i], sequence_delays[i]);
-	}
+	sequence_model_->insert_waveform(0, dlg.waveform());
 }
 
 } // namespace views
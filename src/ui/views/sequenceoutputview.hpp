@@ -30,8 +30,7 @@
 #include <QString>
 #include <QStringList>
 #include <QStyledItemDelegate>
-#include <QTableWidget>
-#include <QTimer>
+#include <QTableView>
 #include <QToolBar>
 #include <QUuid>
 #include <QVariant>
@@ -43,8 +42,10 @@ using std::shared_ptr;
 namespace sv {
 
 class Session;
+class SequenceOutputEngine;
 
 namespace data {
+class AnalogTimeSignal;
 namespace properties {
 class DoubleProperty;
 }
@@ -54,6 +55,11 @@ class BaseDevice;
 }
 
 namespace ui {
+
+namespace widgets {
+class SequenceTableModel;
+}
+
 namespace views {
 
 class DoubleSpinBoxDelegate : public QStyledItemDelegate
@@ -109,22 +115,31 @@ private:
 	QAction *const action_load_from_file_;
 	QAction *const action_generate_waveform_;
 	QToolBar *toolbar_;
-	QTimer *timer_;
+	SequenceOutputEngine *engine_;
+	/** Records the set time error of the sequence steps. */
+	shared_ptr<sv::data::AnalogTimeSignal> jitter_signal_;
+	int shown_position_;
 	QCheckBox *repeat_infinite_box_;
 	QSpinBox *repeat_count_box_;
-	QTableWidget *sequence_table_;
-	int sequence_pos_;
-	int sequence_reperat_count_;
+	QTableView *sequence_table_;
+	sv::ui::widgets::SequenceTableModel *sequence_model_;
 
 	void setup_ui();
 	void setup_toolbar();
-	void start_timer();
-	void stop_timer();
-	void insert_row(int row, double value, double delay);
+	void start_sequence();
+	void stop_sequence();
+	/** Select the row of the step, that is actually set by the engine. */
+	void refresh_position();
+	/**
+	 * Find or create the jitter signal in a user channel of the device. The
+	 * signal is created here in the GUI thread, the engine only pushes the
+	 * samples.
+	 */
+	shared_ptr<sv::data::AnalogTimeSignal> init_jitter_signal();
 	QStringList parse_csv_line(QString line);
 
 private Q_SLOTS:
-	void on_timer_update();
+	void on_sequence_finished();
 	void on_repeat_infinite_changed();
 	void on_action_run_triggered();
 	void on_action_add_row();
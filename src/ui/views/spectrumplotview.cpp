@@ -0,0 +1,133 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <memory>
+#include <string>
+
+#include <QMessageBox>
+#include <QSettings>
+#include <QUuid>
+
+#include "spectrumplotview.hpp"
+#include "src/session.hpp"
+#include "src/util.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/spectrumchannel.hpp"
+#include "src/data/basesignal.hpp"
+#include "src/devices/basedevice.hpp"
+#include "src/ui/dialogs/selectsignaldialog.hpp"
+#include "src/ui/views/baseplotview.hpp"
+#include "src/ui/widgets/plot/curve.hpp"
+#include "src/ui/widgets/plot/plot.hpp"
+#include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/spectrumcurvedata.hpp"
+
+using std::dynamic_pointer_cast;
+using std::shared_ptr;
+using std::string;
+
+namespace sv {
+namespace ui {
+namespace views {
+
+SpectrumPlotView::SpectrumPlotView(Session &session, QUuid uuid,
+		QWidget *parent) :
+	BasePlotView(session, uuid, parent)
+{
+	id_ = "spectrumplot:" + util::format_uuid(uuid_);
+	plot_type_ = PlotType::SpectrumPlot;
+}
+
+QString SpectrumPlotView::title() const
+{
+	QString title = tr("Spectrum");
+	QString sep(" ");
+	for (const auto &curve : plot_->curve_map()) {
+		title = title.append(sep).append(curve.second->name());
+		sep = ", ";
+	}
+	return title;
+}
+
+string SpectrumPlotView::add_channel(
+	shared_ptr<sv::channels::SpectrumChannel> channel)
+{
+	assert(channel);
+	string id;
+
+	// Check if the channel is already added to this plot
+	for (const auto &curve : plot_->curve_map()) {
+		auto *curve_data = qobject_cast<widgets::plot::SpectrumCurveData *>(
+			curve.second->curve_data());
+		if (curve_data && curve_data->channel() == channel)
+			return id;
+	}
+
+	auto *curve = new widgets::plot::SpectrumCurveData(channel);
+	id = plot_->add_curve(curve);
+	if (!id.empty()) {
+		Q_EMIT title_changed();
+	}
+	else {
+		QMessageBox::warning(this,
+			tr("Cannot add spectrum"), tr("Cannot add spectrum to plot!"),
+			QMessageBox::Ok);
+	}
+	return id;
+}
+
+void SpectrumPlotView::save_settings(QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device) const
+{
+	BasePlotView::save_settings(settings, origin_device);
+	plot_->save_settings(settings, true, origin_device);
+}
+
+void SpectrumPlotView::restore_settings(QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device)
+{
+	BasePlotView::restore_settings(settings, origin_device);
+	plot_->restore_settings(settings, true, origin_device);
+}
+
+void SpectrumPlotView::on_action_add_curve_triggered()
+{
+	ui::dialogs::SelectSignalDialog dlg(session(), nullptr);
+	if (!dlg.exec())
+		return;
+
+	for (const auto &signal : dlg.signals()) {
+		auto channel = dynamic_pointer_cast<sv::channels::SpectrumChannel>(
+			signal->parent_channel());
+		if (!channel) {
+			QMessageBox::warning(this,
+				tr("Cannot add spectrum"),
+				tr("The signal %1 doesn't belong to a spectrum channel!").
+					arg(signal->display_name()),
+				QMessageBox::Ok);
+			continue;
+		}
+		add_channel(channel);
+	}
+}
+
+} // namespace views
+} // namespace ui
+} // namespace sv
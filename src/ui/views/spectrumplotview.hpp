@@ -0,0 +1,81 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_VIEWS_SPECTRUMPLOTVIEW_HPP
+#define UI_VIEWS_SPECTRUMPLOTVIEW_HPP
+
+#include <memory>
+#include <string>
+
+#include <QSettings>
+#include <QUuid>
+
+#include "src/ui/views/baseplotview.hpp"
+
+using std::shared_ptr;
+using std::string;
+
+namespace sv {
+
+class Session;
+
+namespace channels {
+class SpectrumChannel;
+}
+namespace devices {
+class BaseDevice;
+}
+
+namespace ui {
+namespace views {
+
+/**
+ * Plot the amplitude spectra of spectrum channels over a logarithmic
+ * frequency axis.
+ */
+class SpectrumPlotView : public BasePlotView
+{
+	Q_OBJECT
+
+public:
+	explicit SpectrumPlotView(Session &session, QUuid uuid = QUuid(),
+		QWidget *parent = nullptr);
+
+	QString title() const override;
+
+	void save_settings(QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device = nullptr) const override;
+	void restore_settings(QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device = nullptr) override;
+
+	/**
+	 * Add the spectrum of a spectrum channel to the plot. Return the curve id.
+	 */
+	string add_channel(shared_ptr<sv::channels::SpectrumChannel> channel);
+
+protected Q_SLOTS:
+	void on_action_add_curve_triggered() override;
+
+};
+
+} // namespace views
+} // namespace ui
+} // namespace sv
+
+#endif // UI_VIEWS_SPECTRUMPLOTVIEW_HPP
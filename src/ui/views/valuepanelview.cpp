@@ -18,6 +18,7 @@
  */
 
 #include <cassert>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -27,7 +28,6 @@
 #include <QDebug>
 #include <QHBoxLayout>
 #include <QSettings>
-#include <QTimer>
 #include <QUuid>
 #include <QVariant>
 #include <QVBoxLayout>
@@ -40,10 +40,12 @@
 #include "src/channels/basechannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/basesignal.hpp"
+#include "src/data/signalstatistics.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/views/baseview.hpp"
 #include "src/ui/views/viewhelper.hpp"
 #include "src/ui/widgets/monofontdisplay.hpp"
+#include "src/ui/widgets/plot/plotrefreshscheduler.hpp"
 
 using std::dynamic_pointer_cast;
 using std::shared_ptr;
@@ -56,9 +58,11 @@ ValuePanelView::ValuePanelView(Session &session, QUuid uuid, QWidget *parent) :
 	BaseView(session, uuid, parent),
 	channel_(nullptr),
 	signal_(nullptr),
+	shown_generation_(std::numeric_limits<size_t>::max()),
 	value_min_(std::numeric_limits<double>::max()),
 	value_max_(std::numeric_limits<double>::lowest()),
-	action_reset_display_(new QAction(this))
+	action_reset_display_(new QAction(this)),
+	action_show_percentiles_(new QAction(this))
 {
 	id_ = "valuepanel:" + util::format_uuid(uuid_);
 
@@ -66,13 +70,12 @@ ValuePanelView::ValuePanelView(Session &session, QUuid uuid, QWidget *parent) :
 	setup_toolbar();
 	reset_display();
 
-	timer_ = new QTimer(this);
-	init_timer();
+	session_.plot_refresh_scheduler()->add_panel(this, [this]() { refresh(); });
 }
 
 ValuePanelView::~ValuePanelView()
 {
-	stop_timer();
+	session_.plot_refresh_scheduler()->remove_panel(this);
 }
 
 QString ValuePanelView::title() const
@@ -141,10 +144,23 @@ void ValuePanelView::setup_ui()
 	value_max_display_ = new widgets::MonoFontDisplay(
 		widgets::MonoFontDisplayType::AutoRange, "", "",
 		data::datautil::format_quantity_flag(data::QuantityFlag::Max), true);
-
-	panel_layout->addWidget(value_display_, 0, 0, 1, 2, Qt::AlignHCenter);
+	p1_display_ = new widgets::MonoFontDisplay(
+		widgets::MonoFontDisplayType::AutoRange, "", "", "P1", true);
+	p50_display_ = new widgets::MonoFontDisplay(
+		widgets::MonoFontDisplayType::AutoRange, "", "", "P50", true);
+	p99_display_ = new widgets::MonoFontDisplay(
+		widgets::MonoFontDisplayType::AutoRange, "", "", "P99", true);
+	// The percentiles are only shown on demand
+	p1_display_->setVisible(false);
+	p50_display_->setVisible(false);
+	p99_display_->setVisible(false);
+
+	panel_layout->addWidget(value_display_, 0, 0, 1, 3, Qt::AlignHCenter);
 	panel_layout->addWidget(value_min_display_, 1, 0, 1, 1, Qt::AlignHCenter);
-	panel_layout->addWidget(value_max_display_, 1, 1, 1, 1, Qt::AlignHCenter);
+	panel_layout->addWidget(value_max_display_, 1, 2, 1, 1, Qt::AlignHCenter);
+	panel_layout->addWidget(p1_display_, 2, 0, 1, 1, Qt::AlignHCenter);
+	panel_layout->addWidget(p50_display_, 2, 1, 1, 1, Qt::AlignHCenter);
+	panel_layout->addWidget(p99_display_, 2, 2, 1, 1, Qt::AlignHCenter);
 	layout->addLayout(panel_layout);
 	layout->addStretch(1);
 
@@ -160,8 +176,17 @@ void ValuePanelView::setup_toolbar()
 	connect(action_reset_display_, &QAction::triggered,
 		this, &ValuePanelView::on_action_reset_display_triggered);
 
+	action_show_percentiles_->setText(tr("Show percentiles"));
+	action_show_percentiles_->setIconText(tr("P1/P50/P99"));
+	action_show_percentiles_->setCheckable(true);
+	action_show_percentiles_->setChecked(false);
+	connect(action_show_percentiles_, &QAction::triggered,
+		this, &ValuePanelView::on_action_show_percentiles_triggered);
+
 	toolbar_ = new QToolBar("Panel Toolbar");
 	toolbar_->addAction(action_reset_display_);
+	toolbar_->addSeparator();
+	toolbar_->addAction(action_show_percentiles_);
 	this->addToolBar(Qt::TopToolBarArea, toolbar_);
 }
 
@@ -209,6 +234,19 @@ void ValuePanelView::init_displays()
 		sv::data::datautil::format_quantity_flags(quantity_flags_max, "\n"));
 	value_max_display_->set_decimal_places(
 		sv::data::DefaultTotalDigits, sv::data::DefaultDecimalPlaces);
+
+	for (auto *display : { p1_display_, p50_display_, p99_display_ }) {
+		display->set_unit(unit);
+		display->set_unit_suffix(unit_suffix);
+		display->set_decimal_places(
+			sv::data::DefaultTotalDigits, sv::data::DefaultDecimalPlaces);
+	}
+
+	if (action_show_percentiles_->isChecked())
+		signal_->set_statistics_enabled(true);
+
+	// Show the (new) signal with the next refresh
+	shown_generation_ = std::numeric_limits<size_t>::max();
 }
 
 void ValuePanelView::connect_signals_channel()
@@ -264,6 +302,8 @@ void ValuePanelView::save_settings(QSettings &settings,
 		SettingsManager::save_signal(signal_, settings, origin_device);
 	else
 		SettingsManager::save_channel(channel_, settings, origin_device);
+
+	settings.setValue("show_percentiles", action_show_percentiles_->isChecked());
 }
 
 void ValuePanelView::restore_settings(QSettings &settings,
@@ -271,6 +311,12 @@ void ValuePanelView::restore_settings(QSettings &settings,
 {
 	BaseView::restore_settings(settings, origin_device);
 
+	if (settings.contains("show_percentiles")) {
+		action_show_percentiles_->setChecked(
+			settings.value("show_percentiles").toBool());
+		on_action_show_percentiles_triggered();
+	}
+
 	auto signal = SettingsManager::restore_signal(
 		session_, settings, origin_device);
 	if (signal) {
@@ -286,36 +332,28 @@ void ValuePanelView::restore_settings(QSettings &settings,
 }
 
 void ValuePanelView::reset_display()
-{
-	value_display_->reset_value();
-	value_min_display_->reset_value();
-	value_max_display_->reset_value();
-}
-
-void ValuePanelView::init_timer()
 {
 	value_min_ = std::numeric_limits<double>::max();
 	value_max_ = std::numeric_limits<double>::lowest();
+	shown_generation_ = std::numeric_limits<size_t>::max();
 
-	connect(timer_, &QTimer::timeout, this, &ValuePanelView::on_update);
-	timer_->start(250);
+	value_display_->reset_value();
+	value_min_display_->reset_value();
+	value_max_display_->reset_value();
+	p1_display_->reset_value();
+	p50_display_->reset_value();
+	p99_display_->reset_value();
 }
 
-void ValuePanelView::stop_timer()
+void ValuePanelView::refresh()
 {
-	if (!timer_->isActive())
+	if (!signal_ || signal_->sample_count() == 0)
 		return;
 
-	timer_->stop();
-	disconnect(timer_, &QTimer::timeout, this, &ValuePanelView::on_update);
-
-	reset_display();
-}
-
-void ValuePanelView::on_update()
-{
-	if (!signal_ || signal_->sample_count() == 0)
+	const size_t generation = signal_->generation();
+	if (generation == shown_generation_)
 		return;
+	shown_generation_ = generation;
 
 	double value = signal_->last_value();
 	if (value_min_ > value)
@@ -326,6 +364,16 @@ void ValuePanelView::on_update()
 	value_display_->set_value(value);
 	value_min_display_->set_value(value_min_);
 	value_max_display_->set_value(value_max_);
+
+	if (action_show_percentiles_->isChecked()) {
+		// Querying the sketch is O(centroids), independent of the sample count
+		const sv::data::SignalStatistics statistics = signal_->statistics();
+		if (statistics.count() > 0) {
+			p1_display_->set_value(statistics.quantile(0.01));
+			p50_display_->set_value(statistics.quantile(0.5));
+			p99_display_->set_value(statistics.quantile(0.99));
+		}
+	}
 }
 
 void ValuePanelView::on_signal_changed()
@@ -349,8 +397,22 @@ void ValuePanelView::on_signal_changed()
 
 void ValuePanelView::on_action_reset_display_triggered()
 {
-	stop_timer();
-	init_timer();
+	reset_display();
+}
+
+void ValuePanelView::on_action_show_percentiles_triggered()
+{
+	bool show = action_show_percentiles_->isChecked();
+	p1_display_->setVisible(show);
+	p50_display_->setVisible(show);
+	p99_display_->setVisible(show);
+
+	// The statistics are kept enabled when hiding the percentiles, because
+	// other views could use them too.
+	if (show && signal_)
+		signal_->set_statistics_enabled(true);
+	// Fill the percentile displays with the next refresh
+	shown_generation_ = std::numeric_limits<size_t>::max();
 }
 
 } // namespace views
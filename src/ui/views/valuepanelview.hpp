@@ -26,7 +26,6 @@
 #include <QAction>
 #include <QSettings>
 #include <QString>
-#include <QTimer>
 #include <QToolBar>
 #include <QUuid>
 
@@ -81,17 +80,22 @@ private:
 	shared_ptr<channels::BaseChannel> channel_;
 	shared_ptr<sv::data::AnalogTimeSignal> signal_;
 
-	QTimer *timer_;
+	/** The signal generation, that is shown in the displays. */
+	size_t shown_generation_;
 
 	// Min/max/actual values are stored here, so they can be reseted
 	double value_min_;
 	double value_max_;
 
 	QAction *const action_reset_display_;
+	QAction *const action_show_percentiles_;
 	QToolBar *toolbar_;
 	widgets::MonoFontDisplay *value_display_;
 	widgets::MonoFontDisplay *value_min_display_;
 	widgets::MonoFontDisplay *value_max_display_;
+	widgets::MonoFontDisplay *p1_display_;
+	widgets::MonoFontDisplay *p50_display_;
+	widgets::MonoFontDisplay *p99_display_;
 
 	void setup_ui();
 	void setup_toolbar();
@@ -101,13 +105,16 @@ private:
 	void connect_signals_signal();
 	void disconnect_signals_signal();
 	void reset_display();
-	void init_timer();
-	void stop_timer();
+	/**
+	 * Update the displays, if the signal has changed since the last update.
+	 * This is called by the PlotRefreshScheduler at most once per frame.
+	 */
+	void refresh();
 
 private Q_SLOTS:
-	void on_update();
 	void on_signal_changed();
 	void on_action_reset_display_triggered();
+	void on_action_show_percentiles_triggered();
 
 };
 
@@ -38,6 +38,7 @@
 #include "src/ui/views/baseview.hpp"
 #include "src/ui/views/democontrolview.hpp"
 #include "src/ui/views/genericcontrolview.hpp"
+#include "src/ui/views/histogramview.hpp"
 #include "src/ui/views/measurementcontrolview.hpp"
 #include "src/ui/views/powerpanelview.hpp"
 #include "src/ui/views/scopehorizontalcontrolview.hpp"
@@ -47,6 +48,8 @@
 #include "src/ui/views/smuscriptoutputview.hpp"
 #include "src/ui/views/smuscriptview.hpp"
 #include "src/ui/views/sourcesinkcontrolview.hpp"
+#include "src/ui/views/scopeplotview.hpp"
+#include "src/ui/views/spectrumplotview.hpp"
 #include "src/ui/views/timeplotview.hpp"
 #include "src/ui/views/valuepanelview.hpp"
 #include "src/ui/views/xyplotview.hpp"
@@ -194,6 +197,15 @@ BaseView *get_view_from_settings(Session &session, QSettings &settings,
 	else if (type == "xyplot") {
 		view = new XYPlotView(session, uuid);
 	}
+	else if (type == "spectrumplot") {
+		view = new SpectrumPlotView(session, uuid);
+	}
+	else if (type == "scopeplot") {
+		view = new ScopePlotView(session, uuid);
+	}
+	else if (type == "histogram") {
+		view = new HistogramView(session, uuid);
+	}
 	else if (type == "powerpanel") {
 		view = new PowerPanelView(session, uuid);
 	}
@@ -0,0 +1,180 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QModelIndex>
+#include <QString>
+#include <QVariant>
+
+#include "datatablemodel.hpp"
+#include "src/util.hpp"
+#include "src/data/analogbasesignal.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/mergedtimestampindex.hpp"
+
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+
+DataTableModel::DataTableModel(QObject *parent) :
+	QAbstractTableModel(parent),
+	row_count_(0),
+	suspended_(false)
+{
+}
+
+void DataTableModel::add_signal(shared_ptr<sv::data::AnalogTimeSignal> signal)
+{
+	// All rows must be merged again with the new signal.
+	beginResetModel();
+	index_.add_signal(signal);
+	index_.update();
+	row_count_ = static_cast<int>(std::min<size_t>(
+		index_.row_count(), std::numeric_limits<int>::max()));
+	endResetModel();
+
+	connect(signal.get(), &data::AnalogBaseSignal::sample_appended,
+		this, &DataTableModel::on_sample_appended);
+	connect(signal.get(), &data::AnalogBaseSignal::samples_cleared,
+		this, &DataTableModel::on_samples_cleared);
+}
+
+vector<shared_ptr<sv::data::AnalogTimeSignal>> DataTableModel::signals() const
+{
+	return index_.signals();
+}
+
+void DataTableModel::set_suspended(bool suspended)
+{
+	suspended_ = suspended;
+	if (!suspended_)
+		on_sample_appended();
+}
+
+int DataTableModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return row_count_;
+}
+
+int DataTableModel::columnCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return static_cast<int>(index_.signal_count()) + 1;
+}
+
+QVariant DataTableModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() >= row_count_)
+		return QVariant();
+	if (role != Qt::DisplayRole && role != Qt::EditRole)
+		return QVariant();
+
+	const size_t row = static_cast<size_t>(index.row());
+	if (index.column() == 0) {
+		const double timestamp = index_.row_timestamp(row);
+		if (role == Qt::EditRole)
+			return QVariant(timestamp);
+		char buffer[util::FormatBufferSize];
+		return QVariant(QString::fromLatin1(buffer, util::format_double_fixed(
+			buffer, sizeof(buffer), timestamp, 3)));
+	}
+
+	const size_t signal_index = static_cast<size_t>(index.column() - 1);
+	size_t pos;
+	if (!index_.sample_pos(row, signal_index, pos))
+		return QVariant();
+
+	const auto signal = index_.signal(signal_index);
+	const double value = signal->get_sample(pos, true).second;
+	if (role == Qt::EditRole)
+		return QVariant(value);
+	const int prefix = util::prefix_from_value(value, signal->sr_digits());
+	const int decimal_places = util::decimal_places_from_prefix(
+		prefix, signal->sr_digits());
+	char buffer[util::FormatBufferSize];
+	return QVariant(QString::fromLatin1(buffer, util::format_double_fixed(
+		buffer, sizeof(buffer), value, decimal_places)));
+}
+
+QVariant DataTableModel::headerData(int section, Qt::Orientation orientation,
+	int role) const
+{
+	if (orientation != Qt::Horizontal)
+		return QAbstractTableModel::headerData(section, orientation, role);
+
+	if (role == Qt::TextAlignmentRole)
+		return QVariant(Qt::AlignVCenter);
+	if (role != Qt::DisplayRole)
+		return QVariant();
+
+	if (section == 0)
+		return QVariant(tr("Time [s]"));
+	if (section > 0 && static_cast<size_t>(section) <= index_.signal_count())
+		return QVariant(index_.signal(section-1)->display_name());
+	return QVariant();
+}
+
+void DataTableModel::on_sample_appended()
+{
+	if (suspended_)
+		return;
+
+	const int old_row_count = row_count_;
+	if (!index_.update())
+		return;
+
+	// New samples can be merged into the last row.
+	if (old_row_count > 0) {
+		Q_EMIT dataChanged(this->index(old_row_count-1, 0),
+			this->index(old_row_count-1, columnCount()-1));
+	}
+
+	const int new_row_count = static_cast<int>(std::min<size_t>(
+		index_.row_count(), std::numeric_limits<int>::max()));
+	if (new_row_count > old_row_count) {
+		beginInsertRows(QModelIndex(), old_row_count, new_row_count-1);
+		row_count_ = new_row_count;
+		endInsertRows();
+	}
+}
+
+void DataTableModel::on_samples_cleared()
+{
+	beginResetModel();
+	index_.clear();
+	index_.update();
+	row_count_ = static_cast<int>(std::min<size_t>(
+		index_.row_count(), std::numeric_limits<int>::max()));
+	endResetModel();
+}
+
+} // namespace widgets
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,91 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_DATATABLEMODEL_HPP
+#define UI_WIDGETS_DATATABLEMODEL_HPP
+
+#include <memory>
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QModelIndex>
+#include <QVariant>
+
+#include "src/data/mergedtimestampindex.hpp"
+
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace ui {
+namespace widgets {
+
+/**
+ * A table model for the samples of multiple signals. The first column is the
+ * (relative) time, the other columns are the values of the signals, merged
+ * by their timestamps.
+ *
+ * The samples are not copied, the cells are read from the signals and
+ * formatted when the view requests them, so only the visible rows are
+ * formatted.
+ */
+class DataTableModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+	explicit DataTableModel(QObject *parent = nullptr);
+
+	void add_signal(shared_ptr<sv::data::AnalogTimeSignal> signal);
+	vector<shared_ptr<sv::data::AnalogTimeSignal>> signals() const;
+	/**
+	 * Don't merge new samples while suspended. When the model is resumed,
+	 * all missed samples are merged and inserted in one batch.
+	 */
+	void set_suspended(bool suspended);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index,
+		int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation,
+		int role = Qt::DisplayRole) const override;
+
+private:
+	sv::data::MergedTimestampIndex index_;
+	/** The number of rows, the attached views know about. */
+	int row_count_;
+	bool suspended_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+	void on_samples_cleared();
+
+};
+
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_DATATABLEMODEL_HPP
@@ -184,6 +184,10 @@ void MonoFontDisplay::update_unit_widget_dimensions()
 
 void MonoFontDisplay::show_value(const QString &value)
 {
+	// Setting the text invalidates the label (size hint and layout), so
+	// don't touch it, when the formatted value hasn't changed.
+	if (value == value_label_->text())
+		return;
 	value_label_->setText(value);
 }
 
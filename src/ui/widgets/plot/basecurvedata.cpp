@@ -17,13 +17,17 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <set>
+#include <vector>
 
+#include <QRectF>
 #include <QSettings>
 #include <QString>
 #include <QtGlobal>
 #include <QVariant>
 
+#include <qwt_scale_map.h>
 #include <qwt_series_data.h>
 
 #include "basecurvedata.hpp"
@@ -56,6 +60,74 @@ bool BaseCurveData::is_relative_time() const
 	return relative_time_;
 }
 
+size_t BaseCurveData::generation() const
+{
+	return size();
+}
+
+size_t BaseCurveData::snapshot_generation() const
+{
+	return 0;
+}
+
+void BaseCurveData::set_suspended(bool suspended)
+{
+	(void)suspended;
+}
+
+void BaseCurveData::setRectOfInterest(const QRectF &rect)
+{
+	rect_of_interest_ = rect;
+}
+
+bool BaseCurveData::index_range(double x_min, double x_max,
+	size_t &from, size_t &to) const
+{
+	(void)x_min;
+	(void)x_max;
+	if (size() == 0 || from > to)
+		return false;
+	to = std::min(to, size() - 1);
+	return true;
+}
+
+bool BaseCurveData::visible_range(size_t &from, size_t &to) const
+{
+	if (size() == 0 || from > to)
+		return false;
+	to = std::min(to, size() - 1);
+	return true;
+}
+
+bool BaseCurveData::y_range(double x_min, double x_max,
+	double &y_min, double &y_max) const
+{
+	(void)x_min;
+	(void)x_max;
+	if (size() == 0)
+		return false;
+
+	const QRectF rect = boundingRect();
+	y_min = rect.bottom();
+	y_max = rect.top();
+	return true;
+}
+
+QRectF BaseCurveData::visible_bounding_rect() const
+{
+	return boundingRect();
+}
+
+bool BaseCurveData::decimate(size_t from, size_t to,
+	const QwtScaleMap &x_map, vector<QPointF> &points) const
+{
+	(void)from;
+	(void)to;
+	(void)x_map;
+	(void)points;
+	return false;
+}
+
 } // namespace plot
 } // namespace widgets
 } // namespace ui
@@ -23,6 +23,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <QColor>
 #include <QObject>
@@ -30,6 +31,7 @@
 #include <QRectF>
 #include <QSettings>
 #include <QString>
+#include <qwt_scale_map.h>
 #include <qwt_series_data.h>
 
 #include "src/data/datautil.hpp"
@@ -37,6 +39,7 @@
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::vector;
 
 namespace sv {
 
@@ -50,7 +53,9 @@ namespace plot {
 
 enum class CurveType {
 	TimeCurve,
-	XYCurve
+	XYCurve,
+	SpectrumCurve,
+	ScopeCurve
 };
 
 class BaseCurveData : public QObject, public QwtSeriesData<QPointF>
@@ -69,10 +74,84 @@ public:
 
 	virtual bool is_equal(const BaseCurveData *other) const = 0;
 
+	/**
+	 * Return the generation of the curve data, that changes whenever the
+	 * data has changed. The default implementation returns size().
+	 */
+	virtual size_t generation() const;
+
+	/**
+	 * Return the generation of the actual points of curves, whose points are
+	 * replaced as a whole (e.g. the frames of a scope curve). The default
+	 * implementation returns 0, the points of most curves are only appended.
+	 */
+	virtual size_t snapshot_generation() const;
+
+	/**
+	 * Suspend the processing of new samples, while the curve isn't visible.
+	 * When resumed, the missed samples are processed in one batch. The
+	 * default implementation does nothing, most curves read the samples
+	 * directly from their signals.
+	 */
+	virtual void set_suspended(bool suspended);
+
 	virtual QPointF sample(size_t i) const = 0;
 	virtual size_t size() const = 0;
 	virtual QRectF boundingRect() const = 0;
 
+	/**
+	 * Set the visible area of the plot. This is called by Qwt, when the
+	 * scales of the plot have changed.
+	 */
+	void setRectOfInterest(const QRectF &rect) override;
+
+	/**
+	 * Restrict the index range from..to to the samples between x_min and
+	 * x_max, plus one sample on each side. Returns false, if no sample is
+	 * left.
+	 *
+	 * The default implementation doesn't restrict the range, because the
+	 * samples are not sorted by their x value.
+	 */
+	virtual bool index_range(double x_min, double x_max,
+		size_t &from, size_t &to) const;
+
+	/**
+	 * Restrict the index range from..to to the samples inside the rect of
+	 * interest, plus one sample on each side. Returns false, if none of the
+	 * samples are visible.
+	 *
+	 * The default implementation doesn't restrict the range, because the
+	 * samples are not sorted by their x value.
+	 */
+	virtual bool visible_range(size_t &from, size_t &to) const;
+
+	/**
+	 * Get the minimum and maximum y value of the samples between x_min and
+	 * x_max. Returns false, if there are no samples in this range.
+	 *
+	 * The default implementation returns the y range of boundingRect().
+	 */
+	virtual bool y_range(double x_min, double x_max,
+		double &y_min, double &y_max) const;
+
+	/**
+	 * Return the bounding rect of the samples inside the rect of interest.
+	 * The default implementation returns boundingRect().
+	 */
+	virtual QRectF visible_bounding_rect() const;
+
+	/**
+	 * Decimate the samples from..to to a min/max polyline (M4), with the
+	 * first, minimum, maximum and last sample of every pixel column of the
+	 * given x map. Only the visible part of the x map is decimated.
+	 *
+	 * Returns false, if the curve can't be decimated or if there are not
+	 * enough samples per pixel column, so the raw samples have to be drawn.
+	 */
+	virtual bool decimate(size_t from, size_t to, const QwtScaleMap &x_map,
+		vector<QPointF> &points) const;
+
 	virtual QPointF closest_point(const QPointF &pos, double *dist) const = 0;
 	virtual sv::data::Quantity x_quantity() const = 0;
 	virtual set<sv::data::QuantityFlag> x_quantity_flags() const = 0;
@@ -91,6 +170,7 @@ public:
 protected:
 	const CurveType type_;
 	bool relative_time_;
+	QRectF rect_of_interest_;
 
 };
 
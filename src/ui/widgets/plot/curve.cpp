@@ -17,6 +17,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <limits>
 #include <memory>
 
 #include <QColor>
@@ -42,6 +43,9 @@
 #include "src/data/datautil.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/decimatingplotcurve.hpp"
+#include "src/ui/widgets/plot/scopecurvedata.hpp"
+#include "src/ui/widgets/plot/spectrumcurvedata.hpp"
 #include "src/ui/widgets/plot/timecurvedata.hpp"
 #include "src/ui/widgets/plot/xycurvedata.hpp"
 
@@ -58,7 +62,8 @@ Curve::Curve(BaseCurveData *curve_data, int x_axis_id, int y_axis_id,
 		const QString &custom_name, const QColor &custom_color) :
 	curve_data_(curve_data),
 	plot_direct_painter_(new QwtPlotDirectPainter()),
-	painted_points_(0)
+	painted_points_(0),
+	refreshed_generation_(std::numeric_limits<size_t>::max())
 {
 	id_ = curve_data->id_prefix() + ":" +
 		util::format_uuid(QUuid::createUuid());
@@ -69,7 +74,7 @@ Curve::Curve(BaseCurveData *curve_data, int x_axis_id, int y_axis_id,
 	pen.setStyle(Qt::SolidLine);
 	pen.setCosmetic(false);
 
-	plot_curve_ = new QwtPlotCurve();
+	plot_curve_ = new DecimatingPlotCurve();
 	plot_curve_->setYAxis(y_axis_id);
 	plot_curve_->setXAxis(x_axis_id);
 	plot_curve_->setStyle(QwtPlotCurve::Lines);
@@ -152,6 +157,16 @@ size_t Curve::painted_points() const
 	return painted_points_;
 }
 
+void Curve::set_refreshed_generation(size_t generation)
+{
+	refreshed_generation_ = generation;
+}
+
+size_t Curve::refreshed_generation() const
+{
+	return refreshed_generation_;
+}
+
 void Curve::set_color(const QColor &custom_color)
 {
 	if (custom_color.isValid()) {
@@ -203,6 +218,16 @@ QwtSymbol::Style Curve::symbol() const
 	return plot_curve_->symbol()->style();
 }
 
+void Curve::set_render_mode(CurveRenderMode render_mode)
+{
+	plot_curve_->set_render_mode(render_mode);
+}
+
+CurveRenderMode Curve::render_mode() const
+{
+	return plot_curve_->render_mode();
+}
+
 QwtPlotMarker *Curve::add_marker(const QString &name_postfix)
 {
 	QwtSymbol *marker_symbol = new QwtSymbol(
@@ -248,6 +273,7 @@ void Curve::save_settings(QSettings &settings,
 	// Qt::PenSytle cannot be saved directly
 	settings.setValue("style", QVariant(QPen(style())));
 	settings.setValue("symbol", symbol());
+	settings.setValue("render_mode", (int)render_mode());
 
 	settings.endGroup();
 }
@@ -256,7 +282,9 @@ Curve *Curve::init_from_settings(
 	Session &session, QSettings &settings, const QString &group,
 	shared_ptr<sv::devices::BaseDevice> origin_device)
 {
-	if (!group.startsWith("timecurve:") && !group.startsWith("xycurve:"))
+	if (!group.startsWith("timecurve:") && !group.startsWith("xycurve:") &&
+			!group.startsWith("spectrumcurve:") &&
+			!group.startsWith("scopecurve:"))
 		return nullptr;
 
 	settings.beginGroup(group);
@@ -270,6 +298,14 @@ Curve *Curve::init_from_settings(
 		curve_data = XYCurveData::init_from_settings(
 			session, settings, origin_device);
 	}
+	else if (group.startsWith("spectrumcurve:")) {
+		curve_data = SpectrumCurveData::init_from_settings(
+			session, settings, origin_device);
+	}
+	else if (group.startsWith("scopecurve:")) {
+		curve_data = ScopeCurveData::init_from_settings(
+			session, settings, origin_device);
+	}
 	if (!curve_data) {
 		settings.endGroup();
 		return nullptr;
@@ -291,6 +327,10 @@ Curve *Curve::init_from_settings(
 		curve->set_style(settings.value("style").value<QPen>().style());
 	if (settings.contains("symbol"))
 		curve->set_symbol(settings.value("symbol").value<QwtSymbol::Style>());
+	if (settings.contains("render_mode")) {
+		curve->set_render_mode(
+			(CurveRenderMode)settings.value("render_mode").toInt());
+	}
 
 	settings.endGroup();
 
@@ -34,6 +34,7 @@
 #include <qwt_symbol.h>
 
 #include "src/data/datautil.hpp"
+#include "src/ui/widgets/plot/decimatingplotcurve.hpp"
 
 using std::shared_ptr;
 using std::string;
@@ -84,22 +85,28 @@ public:
 	int y_axis_id() const;
 	void set_painted_points(size_t painted_points);
 	size_t painted_points() const;
+	/** Set the data generation, that was handled by the last plot refresh. */
+	void set_refreshed_generation(size_t generation);
+	size_t refreshed_generation() const;
 	void set_color(const QColor &custom_color);
 	QColor color() const;
 	void set_style(const Qt::PenStyle style);
 	Qt::PenStyle style() const;
 	void set_symbol(const QwtSymbol::Style style);
 	QwtSymbol::Style symbol() const;
+	void set_render_mode(CurveRenderMode render_mode);
+	CurveRenderMode render_mode() const;
 	QwtPlotMarker *add_marker(const QString &name_postfix);
 
 private:
 	BaseCurveData *curve_data_;
-	QwtPlotCurve *plot_curve_;
+	DecimatingPlotCurve *plot_curve_;
 	QwtPlotDirectPainter *plot_direct_painter_;
 	bool has_custom_name_;
 	QString name_;
 	string id_;
 	size_t painted_points_;
+	size_t refreshed_generation_;
 	bool has_custom_color_;
 	QColor color_;
 
@@ -0,0 +1,448 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <QImage>
+#include <QPainter>
+#include <QPointF>
+#include <QPolygonF>
+#include <QRectF>
+#include <qwt_plot.h>
+#include <qwt_plot_curve.h>
+#include <qwt_plot_item.h>
+#include <qwt_scale_map.h>
+#include <qwt_symbol.h>
+
+#include "curvetilelayer.hpp"
+#include "src/session.hpp"
+#include "src/workerpool.hpp"
+#include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/curve.hpp"
+#include "src/ui/widgets/plot/decimatingplotcurve.hpp"
+#include "src/ui/widgets/plot/plot.hpp"
+
+using std::lock_guard;
+using std::make_unique;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+const int CurveTileLayer::tile_width_ = 256;
+const size_t CurveTileLayer::max_tiles_ = 64;
+
+namespace {
+
+bool is_equal_map(const QwtScaleMap &map1, const QwtScaleMap &map2)
+{
+	return map1.s1() == map2.s1() && map1.s2() == map2.s2() &&
+		map1.p1() == map2.p1() && map1.p2() == map2.p2();
+}
+
+} // namespace
+
+bool CurveTileLayer::CurveStyle::operator==(const CurveStyle &other) const
+{
+	return curve_data == other.curve_data && y_axis_id == other.y_axis_id &&
+		pen == other.pen && symbol_style == other.symbol_style &&
+		symbol_brush == other.symbol_brush &&
+		symbol_pen == other.symbol_pen && symbol_size == other.symbol_size &&
+		antialiased == other.antialiased;
+}
+
+bool CurveTileLayer::ScaleKey::operator==(const ScaleKey &other) const
+{
+	// The time span of a tile is calculated from the axis interval, which
+	// can have small rounding errors while scrolling.
+	if (std::fabs(tile_span - other.tile_span) >
+			1e-9 * std::max(std::fabs(tile_span), std::fabs(other.tile_span)))
+		return false;
+	if (tile_width != other.tile_width || height != other.height ||
+			y_maps.size() != other.y_maps.size())
+		return false;
+	for (const auto &y_map : y_maps) {
+		auto other_y_map = other.y_maps.find(y_map.first);
+		if (other_y_map == other.y_maps.end() ||
+				!is_equal_map(y_map.second, other_y_map->second))
+			return false;
+	}
+	return true;
+}
+
+CurveTileLayer::CurveTileLayer(Plot *plot) :
+	QObject(),
+	QwtPlotItem(),
+	plot_(plot),
+	strand_(make_unique<WorkerStrand>(Session::worker_pool)),
+	key_({ 0., tile_width_, 0, {} }),
+	epoch_(0),
+	fallback_key_({ 0., tile_width_, 0, {} })
+{
+	// Draw the tiles at the z order of the curves.
+	setZ(1);
+	setItemAttribute(QwtPlotItem::Legend, false);
+	setItemAttribute(QwtPlotItem::AutoScale, false);
+}
+
+CurveTileLayer::~CurveTileLayer()
+{
+	// Wait for a running render task.
+	strand_.reset();
+}
+
+int CurveTileLayer::rtti() const
+{
+	return QwtPlotItem::Rtti_PlotUserItem + 1;
+}
+
+void CurveTileLayer::reset()
+{
+	// Replacing the strand waits for a running task and drops pending tasks.
+	strand_ = make_unique<WorkerStrand>(Session::worker_pool);
+
+	++epoch_;
+	tiles_.clear();
+	pending_tiles_.clear();
+	fallback_tiles_.clear();
+	styles_.clear();
+	drawn_sample_counts_.clear();
+	lock_guard<mutex> lock(results_mutex_);
+	results_.clear();
+}
+
+void CurveTileLayer::draw(QPainter *painter,
+	const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+	const QRectF &canvas_rect) const
+{
+	const double x_min = std::min(x_map.s1(), x_map.s2());
+	const double x_max = std::max(x_map.s1(), x_map.s2());
+	const double width = std::fabs(x_map.p2() - x_map.p1());
+	if (width < 1. || x_max <= x_min)
+		return;
+
+	drawn_sample_counts_.clear();
+	vector<CurveStyle> styles = curve_styles();
+	if (styles.empty())
+		return;
+
+	// All y axes share the vertical paint interval of the given y map.
+	map<int, QwtScaleMap> y_maps;
+	for (const auto &style : styles) {
+		if (y_maps.count(style.y_axis_id) > 0)
+			continue;
+		QwtScaleMap axis_map = plot_->canvasMap(style.y_axis_id);
+		axis_map.setPaintInterval(y_map.p1(), y_map.p2());
+		y_maps[style.y_axis_id] = axis_map;
+	}
+
+	// Rendering to another device (e.g. exporting the plot to a file) is
+	// done directly, without tiles.
+	if (painter->device() != plot_->canvas()) {
+		painter->save();
+		draw_curves(painter, x_map, y_maps, styles);
+		painter->restore();
+		return;
+	}
+
+	ScaleKey key;
+	key.tile_span = tile_width_ * (x_max - x_min) / width;
+	key.tile_width = tile_width_;
+	key.height = (int)std::ceil(canvas_rect.bottom()) + 1;
+	key.y_maps = y_maps;
+
+	// The scale or the curves have changed: The actual tiles are kept as
+	// fallback until the new tiles are rendered.
+	if (!(key == key_) || !(styles == styles_)) {
+		if (!tiles_.empty() && styles.size() == styles_.size()) {
+			fallback_key_ = key_;
+			fallback_tiles_ = std::move(tiles_);
+		}
+		key_ = key;
+		styles_ = styles;
+		++epoch_;
+		tiles_.clear();
+		pending_tiles_.clear();
+	}
+
+	take_results();
+
+	const long long first_index = (long long)std::floor(x_min / key_.tile_span);
+	const long long last_index = (long long)std::floor(x_max / key_.tile_span);
+	bool all_tiles_ready = true;
+	for (long long index = first_index; index <= last_index; ++index) {
+		// Derive the width from the next tile boundary, so the rounded tile
+		// positions don't leave gaps or overlaps between the tiles.
+		const double tile_x = std::round(x_map.transform(index * key_.tile_span));
+		const double next_tile_x =
+			std::round(x_map.transform((index + 1) * key_.tile_span));
+		const QRectF tile_rect(tile_x, 0, next_tile_x - tile_x, key_.height);
+		auto tile = tiles_.find(index);
+		if (tile == tiles_.end()) {
+			all_tiles_ready = false;
+			request_tile(index);
+			draw_fallback(painter, x_map, tile_rect);
+			continue;
+		}
+
+		if (is_outdated(index, tile->second))
+			request_tile(index);
+		painter->drawImage(tile_rect, tile->second.image);
+
+		if (tile->second.complete ||
+				tile->second.sample_counts.size() != styles_.size())
+			continue;
+		for (size_t i = 0; i < styles_.size(); ++i) {
+			const BaseCurveData *curve_data = styles_[i].curve_data;
+			auto count = drawn_sample_counts_.find(curve_data);
+			if (count == drawn_sample_counts_.end())
+				drawn_sample_counts_[curve_data] = tile->second.sample_counts[i];
+			else
+				count->second =
+					std::min(count->second, tile->second.sample_counts[i]);
+		}
+	}
+
+	if (all_tiles_ready)
+		fallback_tiles_.clear();
+
+	// Drop the tiles, that are farthest away from the visible tiles.
+	while (tiles_.size() > max_tiles_) {
+		if (std::llabs(tiles_.begin()->first - first_index) >
+				std::llabs(tiles_.rbegin()->first - last_index))
+			tiles_.erase(tiles_.begin());
+		else
+			tiles_.erase(std::prev(tiles_.end()));
+	}
+}
+
+size_t CurveTileLayer::drawn_sample_count(const BaseCurveData *curve_data,
+	size_t sample_count) const
+{
+	auto count = drawn_sample_counts_.find(curve_data);
+	if (count == drawn_sample_counts_.end())
+		return sample_count;
+	return std::min(count->second, sample_count);
+}
+
+vector<CurveTileLayer::CurveStyle> CurveTileLayer::curve_styles() const
+{
+	vector<CurveStyle> styles;
+	for (const auto &curve_pair : plot_->curve_map()) {
+		const auto *plot_curve = dynamic_cast<const DecimatingPlotCurve *>(
+			curve_pair.second->plot_curve());
+		if (!plot_curve || !plot_curve->is_tiled() || !plot_curve->isVisible())
+			continue;
+
+		CurveStyle style;
+		style.curve_data = curve_pair.second->curve_data();
+		style.y_axis_id = plot_curve->yAxis();
+		style.pen = plot_curve->pen();
+		style.symbol_style = QwtSymbol::NoSymbol;
+		if (plot_curve->symbol()) {
+			style.symbol_style = plot_curve->symbol()->style();
+			style.symbol_brush = plot_curve->symbol()->brush();
+			style.symbol_pen = plot_curve->symbol()->pen();
+			style.symbol_size = plot_curve->symbol()->size();
+		}
+		style.antialiased =
+			plot_curve->testRenderHint(QwtPlotItem::RenderAntialiased);
+		styles.push_back(style);
+	}
+	return styles;
+}
+
+void CurveTileLayer::take_results() const
+{
+	vector<RenderResult> results;
+	{
+		lock_guard<mutex> lock(results_mutex_);
+		results.swap(results_);
+	}
+
+	for (auto &result : results) {
+		if (result.epoch != epoch_)
+			continue;
+		pending_tiles_.erase(result.index);
+		tiles_[result.index] = std::move(result.tile);
+	}
+}
+
+void CurveTileLayer::request_tile(long long index) const
+{
+	if (pending_tiles_.count(index) > 0)
+		return;
+	pending_tiles_.insert(index);
+
+	const ScaleKey key = key_;
+	const vector<CurveStyle> styles = styles_;
+	const size_t epoch = epoch_;
+	CurveTileLayer *layer = const_cast<CurveTileLayer *>(this);
+	strand_->post([layer, key, styles, index, epoch]() {
+		Tile tile = render_tile(key, styles, index);
+		bool notify;
+		{
+			lock_guard<mutex> lock(layer->results_mutex_);
+			// Only notify once, until the results are taken.
+			notify = layer->results_.empty();
+			layer->results_.push_back({ index, epoch, std::move(tile) });
+		}
+		if (notify)
+			Q_EMIT layer->tiles_rendered();
+	});
+}
+
+bool CurveTileLayer::is_outdated(long long index, const Tile &tile) const
+{
+	if (tile.complete || tile.sample_counts.size() != styles_.size())
+		return false;
+
+	// Only re-render the tile, when new samples fall into its time range.
+	const double x_max = (index + 1) * key_.tile_span;
+	for (size_t i = 0; i < styles_.size(); ++i) {
+		const BaseCurveData *curve_data = styles_[i].curve_data;
+		const size_t sample_count = curve_data->size();
+		if (sample_count < tile.sample_counts[i])
+			return true;
+		if (sample_count > tile.sample_counts[i] &&
+				curve_data->sample(tile.sample_counts[i]).x() < x_max)
+			return true;
+	}
+	return false;
+}
+
+void CurveTileLayer::draw_fallback(QPainter *painter,
+	const QwtScaleMap &x_map, const QRectF &tile_rect) const
+{
+	if (fallback_tiles_.empty() || fallback_key_.y_maps.empty() ||
+			key_.y_maps.count(fallback_key_.y_maps.begin()->first) == 0)
+		return;
+
+	// Stretch the old tiles to the new scales. With multiple y axes, the
+	// first axis is used for the fallback.
+	const QwtScaleMap &old_y_map = fallback_key_.y_maps.begin()->second;
+	const QwtScaleMap &new_y_map =
+		key_.y_maps.at(fallback_key_.y_maps.begin()->first);
+	const double top = new_y_map.transform(old_y_map.invTransform(0));
+	const double bottom = new_y_map.transform(
+		old_y_map.invTransform(fallback_key_.height));
+
+	painter->save();
+	painter->setClipRect(tile_rect, Qt::IntersectClip);
+	for (const auto &tile : fallback_tiles_) {
+		const double x1 = x_map.transform(tile.first * fallback_key_.tile_span);
+		const double x2 = x_map.transform(
+			(tile.first + 1) * fallback_key_.tile_span);
+		const QRectF target(QPointF(x1, top), QPointF(x2, bottom));
+		if (!target.intersects(tile_rect))
+			continue;
+		painter->drawImage(target, tile.second.image);
+	}
+	painter->restore();
+}
+
+CurveTileLayer::Tile CurveTileLayer::render_tile(const ScaleKey &key,
+	const vector<CurveStyle> &styles, long long index)
+{
+	Tile tile;
+	tile.complete = true;
+	tile.image = QImage(key.tile_width, key.height,
+		QImage::Format_ARGB32_Premultiplied);
+	tile.image.fill(Qt::transparent);
+
+	const double x_min = index * key.tile_span;
+	const double x_max = x_min + key.tile_span;
+	QwtScaleMap x_map;
+	x_map.setPaintInterval(0, key.tile_width);
+	x_map.setScaleInterval(x_min, x_max);
+
+	// Read the sample counts first, so newer samples mark the tile outdated.
+	for (const auto &style : styles) {
+		const size_t sample_count = style.curve_data->size();
+		tile.sample_counts.push_back(sample_count);
+		if (sample_count == 0 ||
+				style.curve_data->sample(sample_count - 1).x() < x_max)
+			tile.complete = false;
+	}
+
+	QPainter painter(&tile.image);
+	draw_curves(&painter, x_map, key.y_maps, styles);
+
+	return tile;
+}
+
+void CurveTileLayer::draw_curves(QPainter *painter, const QwtScaleMap &x_map,
+	const map<int, QwtScaleMap> &y_maps, const vector<CurveStyle> &styles)
+{
+	const double x_min = std::min(x_map.s1(), x_map.s2());
+	const double x_max = std::max(x_map.s1(), x_map.s2());
+
+	vector<QPointF> points;
+	for (const auto &style : styles) {
+		const BaseCurveData *curve_data = style.curve_data;
+		const size_t sample_count = curve_data->size();
+		if (sample_count == 0)
+			continue;
+
+		// Decimate the samples or use the raw samples, when zoomed in.
+		points.clear();
+		if (!curve_data->decimate(0, sample_count - 1, x_map, points)) {
+			size_t from = 0;
+			size_t to = sample_count - 1;
+			if (!curve_data->index_range(x_min, x_max, from, to))
+				continue;
+			for (size_t i = from; i <= to; ++i)
+				points.push_back(curve_data->sample(i));
+		}
+
+		const QwtScaleMap &y_map = y_maps.at(style.y_axis_id);
+		QPolygonF polyline((int)points.size());
+		for (size_t i = 0; i < points.size(); ++i) {
+			polyline[(int)i] = QPointF(
+				x_map.transform(points[i].x()), y_map.transform(points[i].y()));
+		}
+
+		painter->setRenderHint(QPainter::Antialiasing, style.antialiased);
+		painter->setPen(style.pen);
+		painter->drawPolyline(polyline);
+		if (style.symbol_style != QwtSymbol::NoSymbol) {
+			QwtSymbol symbol(style.symbol_style, style.symbol_brush,
+				style.symbol_pen, style.symbol_size);
+			// The tiles are rendered in the worker pool, where no QPixmap
+			// (the symbol cache) must be used.
+			symbol.setCachePolicy(QwtSymbol::NoCache);
+			symbol.drawSymbols(painter, polyline);
+		}
+	}
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
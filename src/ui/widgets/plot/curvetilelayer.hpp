@@ -0,0 +1,185 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_CURVETILELAYER_HPP
+#define UI_WIDGETS_PLOT_CURVETILELAYER_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include <QBrush>
+#include <QImage>
+#include <QObject>
+#include <QPainter>
+#include <QPen>
+#include <QRectF>
+#include <QSize>
+#include <qwt_plot_item.h>
+#include <qwt_scale_map.h>
+#include <qwt_symbol.h>
+
+using std::map;
+using std::mutex;
+using std::set;
+using std::unique_ptr;
+using std::vector;
+
+namespace sv {
+
+class WorkerStrand;
+
+namespace ui {
+namespace widgets {
+namespace plot {
+
+class BaseCurveData;
+class Plot;
+
+/**
+ * A plot item, that rasterizes the tiled time curves of a plot on the
+ * session worker pool and only composites the rendered tiles in the GUI
+ * thread.
+ *
+ * The x axis is split into tiles with a fixed width in pixels. The tiles
+ * are keyed by the x scale (time per pixel), the y scales and the canvas
+ * height. When a time plot is scrolled, the tiles of the old time range are
+ * reused and only the newly exposed tiles are rendered. Tiles, that are not
+ * rendered yet, are filled with the stretched tiles of the last scale, so
+ * zooming and resizing don't leave empty areas.
+ *
+ * Tiles at the end of the data are re-rendered, when new samples of the
+ * curves fall into their time range.
+ */
+class CurveTileLayer : public QObject, public QwtPlotItem
+{
+	Q_OBJECT
+
+public:
+	explicit CurveTileLayer(Plot *plot);
+	~CurveTileLayer();
+
+	int rtti() const override;
+	void draw(QPainter *painter,
+		const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		const QRectF &canvas_rect) const override;
+
+	/**
+	 * Drop all tiles and wait for a running render task. This must be called
+	 * before a curve of the plot is deleted.
+	 */
+	void reset();
+
+	/**
+	 * Return the number of samples of the curve, that are contained in all
+	 * tiles drawn by the last draw(). Newer samples must be painted
+	 * directly. If no tile depends on the sample count, `sample_count` is
+	 * returned.
+	 */
+	size_t drawn_sample_count(const BaseCurveData *curve_data,
+		size_t sample_count) const;
+
+private:
+	struct CurveStyle
+	{
+		const BaseCurveData *curve_data;
+		int y_axis_id;
+		QPen pen;
+		QwtSymbol::Style symbol_style;
+		QBrush symbol_brush;
+		QPen symbol_pen;
+		QSize symbol_size;
+		bool antialiased;
+
+		bool operator==(const CurveStyle &other) const;
+	};
+
+	struct ScaleKey
+	{
+		double tile_span;
+		int tile_width;
+		int height;
+		map<int, QwtScaleMap> y_maps;
+
+		bool operator==(const ScaleKey &other) const;
+	};
+
+	struct Tile
+	{
+		QImage image;
+		/** The sample counts of the curves, the tile was rendered from. */
+		vector<size_t> sample_counts;
+		/** All curves have data beyond the end of the tile. */
+		bool complete;
+	};
+
+	struct RenderResult
+	{
+		long long index;
+		size_t epoch;
+		Tile tile;
+	};
+
+	vector<CurveStyle> curve_styles() const;
+	void take_results() const;
+	void request_tile(long long index) const;
+	bool is_outdated(long long index, const Tile &tile) const;
+	void draw_fallback(QPainter *painter, const QwtScaleMap &x_map,
+		const QRectF &tile_rect) const;
+	static Tile render_tile(const ScaleKey &key,
+		const vector<CurveStyle> &styles, long long index);
+	static void draw_curves(QPainter *painter, const QwtScaleMap &x_map,
+		const map<int, QwtScaleMap> &y_maps, const vector<CurveStyle> &styles);
+
+	Plot *plot_;
+	unique_ptr<WorkerStrand> strand_;
+
+	// The tile cache is updated while compositing in draw().
+	mutable ScaleKey key_;
+	mutable vector<CurveStyle> styles_;
+	mutable size_t epoch_;
+	mutable map<long long, Tile> tiles_;
+	mutable set<long long> pending_tiles_;
+	mutable ScaleKey fallback_key_;
+	mutable map<long long, Tile> fallback_tiles_;
+	/** The minimal sample counts of the incomplete tiles of the last draw. */
+	mutable map<const BaseCurveData *, size_t> drawn_sample_counts_;
+
+	mutable mutex results_mutex_;
+	mutable vector<RenderResult> results_;
+
+	/** The width of a tile in pixels. */
+	static const int tile_width_;
+	/** The maximum number of cached tiles. */
+	static const size_t max_tiles_;
+
+Q_SIGNALS:
+	/** Emitted from a worker thread, when new tiles are ready. */
+	void tiles_rendered();
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_CURVETILELAYER_HPP
@@ -0,0 +1,171 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include <QImage>
+#include <QPainter>
+#include <QPointF>
+#include <QPolygonF>
+#include <QRect>
+#include <QRectF>
+#include <qwt_painter.h>
+#include <qwt_plot_curve.h>
+#include <qwt_scale_map.h>
+#include <qwt_symbol.h>
+
+#include "decimatingplotcurve.hpp"
+#include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/densitymap.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+DecimatingPlotCurve::DecimatingPlotCurve() : QwtPlotCurve(),
+	tiled_(false),
+	render_mode_(CurveRenderMode::Lines),
+	density_generation_(0)
+{
+	// Let Qwt pass the visible area to the curve data.
+	setItemInterest(QwtPlotItem::ScaleInterest, true);
+}
+
+QRectF DecimatingPlotCurve::boundingRect() const
+{
+	const auto *curve_data = dynamic_cast<const BaseCurveData *>(data());
+	if (curve_data == nullptr)
+		return QwtPlotCurve::boundingRect();
+	return curve_data->visible_bounding_rect();
+}
+
+void DecimatingPlotCurve::set_tiled(bool tiled)
+{
+	tiled_ = tiled;
+}
+
+bool DecimatingPlotCurve::is_tiled() const
+{
+	return tiled_ && render_mode_ == CurveRenderMode::Lines;
+}
+
+void DecimatingPlotCurve::set_render_mode(CurveRenderMode render_mode)
+{
+	render_mode_ = render_mode;
+	density_map_.clear();
+}
+
+CurveRenderMode DecimatingPlotCurve::render_mode() const
+{
+	return render_mode_;
+}
+
+void DecimatingPlotCurve::draw(QPainter *painter,
+	const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+	const QRectF &canvas_rect) const
+{
+	if (is_tiled())
+		return;
+	QwtPlotCurve::draw(painter, x_map, y_map, canvas_rect);
+}
+
+void DecimatingPlotCurve::drawSeries(QPainter *painter,
+	const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+	const QRectF &canvas_rect, int from, int to) const
+{
+	const size_t num_samples = dataSize();
+	if (num_samples == 0)
+		return;
+	if (render_mode_ == CurveRenderMode::Density) {
+		draw_density(painter, x_map, y_map, canvas_rect);
+		return;
+	}
+	if (from < 0)
+		from = 0;
+	if (to < 0)
+		to = (int)num_samples - 1;
+
+	const auto *curve_data = dynamic_cast<const BaseCurveData *>(data());
+	if (curve_data != nullptr) {
+		size_t first = from;
+		size_t last = to;
+		if (!curve_data->visible_range(first, last))
+			return;
+		from = (int)first;
+		to = (int)last;
+	}
+
+	vector<QPointF> points;
+	if (style() != QwtPlotCurve::Lines || curve_data == nullptr ||
+			!curve_data->decimate(from, to, x_map, points)) {
+		QwtPlotCurve::drawSeries(painter, x_map, y_map, canvas_rect, from, to);
+		return;
+	}
+
+	QPolygonF polyline((int)points.size());
+	for (size_t i = 0; i < points.size(); ++i) {
+		polyline[(int)i] = QPointF(
+			x_map.transform(points[i].x()), y_map.transform(points[i].y()));
+	}
+
+	painter->save();
+	painter->setPen(pen());
+	QwtPainter::drawPolyline(painter, polyline);
+	if (symbol() && symbol()->style() != QwtSymbol::NoSymbol)
+		symbol()->drawSymbols(painter, polyline);
+	painter->restore();
+}
+
+void DecimatingPlotCurve::draw_density(QPainter *painter,
+	const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+	const QRectF &canvas_rect) const
+{
+	const size_t num_samples = dataSize();
+	const QRect rect = canvas_rect.toAlignedRect();
+	density_map_.set_geometry(x_map, y_map, rect);
+	if (num_samples < density_map_.next_index())
+		density_map_.clear();
+
+	// The points of snapshot curves (e.g. scope frames) are replaced as a
+	// whole, so all points must be binned again.
+	const auto *curve_data = dynamic_cast<const BaseCurveData *>(data());
+	if (curve_data != nullptr &&
+			curve_data->snapshot_generation() != density_generation_) {
+		density_generation_ = curve_data->snapshot_generation();
+		density_map_.clear();
+	}
+
+	// Only bin the new points. After the histogram was cleared, the points
+	// can be restricted to the visible ones.
+	size_t first = density_map_.next_index();
+	size_t last = num_samples - 1;
+	if (first <= last && (first > 0 || curve_data == nullptr ||
+			curve_data->visible_range(first, last)))
+		density_map_.add(*data(), first, last);
+
+	painter->drawImage(rect.topLeft(), density_map_.image(pen().color()));
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_DECIMATINGPLOTCURVE_HPP
+#define UI_WIDGETS_PLOT_DECIMATINGPLOTCURVE_HPP
+
+#include <QPainter>
+#include <QRectF>
+#include <qwt_plot_curve.h>
+#include <qwt_scale_map.h>
+
+#include "src/ui/widgets/plot/densitymap.hpp"
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+enum class CurveRenderMode {
+	/** Draw the curve as (decimated) polyline. */
+	Lines = 0,
+	/** Draw the curve as colour mapped 2D histogram of the points. */
+	Density
+};
+
+/**
+ * A QwtPlotCurve, that only draws the visible slice of the BaseCurveData.
+ * When there are many more visible samples than pixel columns, a min/max
+ * decimated polyline is drawn. The decimation is done by the BaseCurveData
+ * of the curve, so drawing the curve only depends on the canvas width and
+ * the number of visible samples, but not on the total number of samples.
+ * When zoomed in far enough, the raw samples are drawn.
+ *
+ * In the density render mode, the points are binned into a DensityMap
+ * instead and the colour mapped histogram is drawn.
+ */
+class DecimatingPlotCurve : public QwtPlotCurve
+{
+
+public:
+	DecimatingPlotCurve();
+
+	QRectF boundingRect() const override;
+
+	/**
+	 * When the curve is tiled, it is rendered in the background by the
+	 * CurveTileLayer. A full replot of the plot then doesn't draw the curve,
+	 * only new samples are still painted incrementally via drawSeries().
+	 */
+	void set_tiled(bool tiled);
+	/** Return true, if the curve is tiled and drawn as lines. */
+	bool is_tiled() const;
+	void set_render_mode(CurveRenderMode render_mode);
+	CurveRenderMode render_mode() const;
+
+	void draw(QPainter *painter,
+		const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		const QRectF &canvas_rect) const override;
+
+protected:
+	void drawSeries(QPainter *painter,
+		const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		const QRectF &canvas_rect, int from, int to) const override;
+
+private:
+	void draw_density(QPainter *painter,
+		const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		const QRectF &canvas_rect) const;
+
+	bool tiled_;
+	CurveRenderMode render_mode_;
+	mutable DensityMap density_map_;
+	/** The snapshot generation of the points in the density map. */
+	mutable size_t density_generation_;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_DECIMATINGPLOTCURVE_HPP
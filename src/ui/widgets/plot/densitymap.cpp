@@ -0,0 +1,158 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <QColor>
+#include <QImage>
+#include <QPointF>
+#include <QRect>
+#include <qwt_scale_map.h>
+#include <qwt_series_data.h>
+
+#include "densitymap.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+namespace {
+
+bool is_equal_map(const QwtScaleMap &map1, const QwtScaleMap &map2)
+{
+	return map1.s1() == map2.s1() && map1.s2() == map2.s2() &&
+		map1.p1() == map2.p1() && map1.p2() == map2.p2();
+}
+
+QColor mix(const QColor &color1, const QColor &color2, double factor)
+{
+	return QColor::fromRgbF(
+		color1.redF() + factor * (color2.redF() - color1.redF()),
+		color1.greenF() + factor * (color2.greenF() - color1.greenF()),
+		color1.blueF() + factor * (color2.blueF() - color1.blueF()));
+}
+
+} // namespace
+
+DensityMap::DensityMap() :
+	max_count_(0),
+	next_index_(0),
+	image_valid_(false)
+{
+}
+
+bool DensityMap::set_geometry(const QwtScaleMap &x_map,
+	const QwtScaleMap &y_map, const QRect &rect)
+{
+	if (rect == rect_ && is_equal_map(x_map, x_map_) &&
+			is_equal_map(y_map, y_map_))
+		return false;
+
+	x_map_ = x_map;
+	y_map_ = y_map;
+	rect_ = rect;
+	clear();
+	return true;
+}
+
+void DensityMap::clear()
+{
+	bins_.assign((size_t)std::max(0, rect_.width() * rect_.height()), 0);
+	max_count_ = 0;
+	next_index_ = 0;
+	image_valid_ = false;
+}
+
+size_t DensityMap::next_index() const
+{
+	return next_index_;
+}
+
+void DensityMap::add(const QwtSeriesData<QPointF> &data,
+	size_t from, size_t to)
+{
+	const int width = rect_.width();
+	const int height = rect_.height();
+	for (size_t i = from; i <= to; ++i) {
+		const QPointF point = data.sample(i);
+		const double x = x_map_.transform(point.x()) - rect_.left();
+		const double y = y_map_.transform(point.y()) - rect_.top();
+		// Also filters NaN.
+		if (!(x >= 0 && x < width && y >= 0 && y < height))
+			continue;
+
+		uint32_t &bin = bins_[(size_t)y * width + (size_t)x];
+		if (bin < UINT32_MAX)
+			++bin;
+		max_count_ = std::max(max_count_, bin);
+		image_valid_ = false;
+	}
+	next_index_ = std::max(next_index_, to + 1);
+}
+
+const QImage &DensityMap::image(const QColor &color) const
+{
+	if (image_valid_ && color == image_color_)
+		return image_;
+
+	const int width = rect_.width();
+	const int height = rect_.height();
+	if (image_.width() != width || image_.height() != height)
+		image_ = QImage(width, height, QImage::Format_ARGB32_Premultiplied);
+	image_.fill(Qt::transparent);
+
+	const QColor low_color = color.darker(300);
+	const QColor high_color(Qt::white);
+	for (int y = 0; y < height; ++y) {
+		QRgb *line = reinterpret_cast<QRgb *>(image_.scanLine(y));
+		const uint32_t *bins = &bins_[(size_t)y * width];
+		for (int x = 0; x < width; ++x) {
+			if (bins[x] == 0)
+				continue;
+			double density = 1.;
+			if (max_count_ > 1)
+				density = std::log1p((double)bins[x] - 1.) /
+					std::log1p((double)max_count_ - 1.);
+			const QColor pixel_color = density < 0.5 ?
+				mix(low_color, color, 2 * density) :
+				mix(color, high_color, 2 * density - 1);
+			line[x] = pixel_color.rgb();
+		}
+	}
+
+	image_color_ = color;
+	image_valid_ = true;
+	return image_;
+}
+
+QRect DensityMap::rect() const
+{
+	return rect_;
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
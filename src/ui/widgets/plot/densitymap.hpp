@@ -0,0 +1,99 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_DENSITYMAP_HPP
+#define UI_WIDGETS_PLOT_DENSITYMAP_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <QColor>
+#include <QImage>
+#include <QPointF>
+#include <QRect>
+#include <qwt_scale_map.h>
+#include <qwt_series_data.h>
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+/**
+ * A 2D histogram of the points of a curve with the resolution of the
+ * canvas. Every bin counts the points, that fall into one pixel. The
+ * histogram is rendered as a colour mapped image, so the cost of drawing
+ * doesn't depend on the number of points.
+ *
+ * The points are binned incrementally, the histogram is only rebuilt when
+ * the scales or the size of the canvas change.
+ */
+class DensityMap
+{
+
+public:
+	DensityMap();
+
+	/**
+	 * Set the scales and the canvas rect. If they have changed, all bins
+	 * are cleared and true is returned.
+	 */
+	bool set_geometry(const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		const QRect &rect);
+	void clear();
+
+	/** Return the index of the next point to add. */
+	size_t next_index() const;
+
+	/**
+	 * Add the points data[from..to] to the histogram. Points outside of the
+	 * canvas are ignored.
+	 */
+	void add(const QwtSeriesData<QPointF> &data, size_t from, size_t to);
+
+	/**
+	 * Return the colour mapped histogram. The density is scaled
+	 * logarithmically from a dark variant of the color (one point) over the
+	 * color itself to white (maximum count). Empty bins are transparent.
+	 */
+	const QImage &image(const QColor &color) const;
+	QRect rect() const;
+
+private:
+	QwtScaleMap x_map_;
+	QwtScaleMap y_map_;
+	QRect rect_;
+	vector<uint32_t> bins_;
+	uint32_t max_count_;
+	size_t next_index_;
+
+	mutable QImage image_;
+	mutable QColor image_color_;
+	mutable bool image_valid_;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_DENSITYMAP_HPP
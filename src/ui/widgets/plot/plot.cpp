@@ -18,6 +18,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <memory>
@@ -58,6 +59,7 @@
 #include <qwt_plot_panner.h>
 #include <qwt_plot_picker.h>
 #include <qwt_scale_draw.h>
+#include <qwt_scale_engine.h>
 #include <qwt_scale_map.h>
 #include <qwt_scale_widget.h>
 #include <qwt_symbol.h>
@@ -69,8 +71,13 @@
 #include "src/ui/widgets/plot/axislocklabel.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
 #include "src/ui/widgets/plot/curve.hpp"
+#include "src/ui/widgets/plot/curvetilelayer.hpp"
+#include "src/ui/widgets/plot/decimatingplotcurve.hpp"
 #include "src/ui/widgets/plot/plotmagnifier.hpp"
+#include "src/ui/widgets/plot/plotrefreshscheduler.hpp"
 #include "src/ui/widgets/plot/plotscalepicker.hpp"
+#include "src/ui/widgets/plot/scopecurvedata.hpp"
+#include "src/ui/widgets/plot/spectrumcurvedata.hpp"
 #include "src/ui/widgets/plot/timecurvedata.hpp"
 #include "src/ui/widgets/plot/xycurvedata.hpp"
 
@@ -143,10 +150,13 @@ private:
 
 Plot::Plot(Session &session, QWidget *parent) : QwtPlot(parent),
 	session_(session),
+	refresh_scheduler_(session.plot_refresh_scheduler()),
 	plot_interval_(200),
-	timer_id_(-1),
 	time_span_(120.),
 	add_time_(30.),
+	suspended_(false),
+	started_(false),
+	tiles_dirty_(false),
 	active_marker_(nullptr),
 	markers_label_(nullptr),
 	markers_label_alignment_(Qt::AlignBottom | Qt::AlignHCenter),
@@ -179,6 +189,12 @@ Plot::Plot(Session &session, QWidget *parent) : QwtPlot(parent),
 	grid->enableYMin(false);
 	grid->attach(this);
 
+	// Time curves are rasterized in tiles on the worker pool.
+	tile_layer_ = new CurveTileLayer(this);
+	tile_layer_->attach(this);
+	connect(tile_layer_, &CurveTileLayer::tiles_rendered,
+		this, &Plot::on_tiles_rendered);
+
 	// Disable all x axis to have a known state for init_x_axis()
 	this->enableAxis(QwtPlot::xBottom, false);
 	this->enableAxis(QwtPlot::xTop, false);
@@ -201,31 +217,73 @@ Plot::Plot(Session &session, QWidget *parent) : QwtPlot(parent),
 
 Plot::~Plot()
 {
+	tiles_dirty_ = false;
 	this->stop();
 	for (const auto &marker_pair : marker_curve_map_)
 		delete marker_pair.first;
+	tile_layer_->reset();
 	for (const auto &curve_pair : curve_map_)
 		delete curve_pair.second;
 }
 
 void Plot::start()
 {
-	timer_id_ = startTimer(plot_interval_);
+	started_ = true;
+	refresh_scheduler_->add_plot(this);
 }
 
 void Plot::stop()
 {
 	//qWarning() << "Plot::stop() for " << curve_data_->name();
-	killTimer(timer_id_);
+	refresh_scheduler_->remove_plot(this);
+	started_ = false;
+	if (tiles_dirty_)
+		replot();
+}
+
+void Plot::refresh()
+{
+	// Only touch the curves, whose data has changed since the last refresh.
+	vector<Curve *> changed_curves;
+	for (const auto &curve : curve_map_) {
+		const size_t generation = curve.second->curve_data()->generation();
+		if (generation == curve.second->refreshed_generation())
+			continue;
+		curve.second->set_refreshed_generation(generation);
+		changed_curves.push_back(curve.second);
+	}
+	if (!changed_curves.empty()) {
+		update_intervals(changed_curves);
+		update_curves(changed_curves);
+	}
+
+	// Composite the tiles, that were rendered since the last refresh.
+	if (tiles_dirty_)
+		replot();
 }
 
 void Plot::replot()
 {
 	//qWarning() << "Plot::replot()";
-	for (const auto &curve : curve_map_)
-		curve.second->set_painted_points(0);
+	tiles_dirty_ = false;
+	map<Curve *, size_t> tiled_sizes;
+	for (const auto &curve : curve_map_) {
+		const auto *plot_curve =
+			dynamic_cast<const DecimatingPlotCurve *>(curve.second->plot_curve());
+		if (plot_curve && plot_curve->is_tiled())
+			tiled_sizes[curve.second] = curve.second->curve_data()->size();
+		else
+			curve.second->set_painted_points(0);
+	}
 
 	QwtPlot::replot();
+
+	// The tile layer draws the samples of tiled curves, that are contained
+	// in the tiles. Only the newer samples must be painted directly.
+	for (const auto &tiled_size : tiled_sizes) {
+		tiled_size.first->set_painted_points(tile_layer_->drawn_sample_count(
+			tiled_size.first->curve_data(), tiled_size.second));
+	}
 }
 
 string Plot::add_curve(BaseCurveData *curve_data)
@@ -243,6 +301,8 @@ string Plot::add_curve(BaseCurveData *curve_data)
 		return "";
 
 	Curve *curve = new Curve(curve_data, x_axis_id, y_axis_id);
+	curve_data->set_suspended(suspended_);
+	set_curve_tiled(curve);
 	curve->plot_curve()->attach(this);
 	curve_map_.insert(make_pair(curve->id(), curve));
 
@@ -267,6 +327,8 @@ bool Plot::add_curve(Curve *curve)
 	if (x_axis_id < 0)
 		return false;
 
+	curve->curve_data()->set_suspended(suspended_);
+	set_curve_tiled(curve);
 	curve->plot_curve()->attach(this);
 	curve_map_.insert(make_pair(curve->id(), curve));
 
@@ -289,6 +351,7 @@ void Plot::remove_curve(Curve *curve)
 	}
 
 	// Delete curve
+	tile_layer_->reset();
 	curve_map_.erase(curve->id());
 	curve->plot_curve()->detach();
 	delete curve;
@@ -303,6 +366,15 @@ void Plot::remove_all_curves()
 	}
 }
 
+void Plot::set_curve_tiled(Curve *curve)
+{
+	if (curve->curve_data()->type() != CurveType::TimeCurve)
+		return;
+	auto *plot_curve = dynamic_cast<DecimatingPlotCurve *>(curve->plot_curve());
+	if (plot_curve)
+		plot_curve->set_tiled(true);
+}
+
 int Plot::init_x_axis(BaseCurveData *curve_data, int x_axis_id)
 {
 	assert(curve_data);
@@ -353,6 +425,22 @@ int Plot::init_x_axis(BaseCurveData *curve_data, int x_axis_id)
 		max = curve_data->boundingRect().right() +
 			(std::fabs(curve_data->boundingRect().right()) * 0.1);
 	}
+	else if (curve_data->type() == CurveType::SpectrumCurve) {
+		// Logarithmic axis, the lower boundary must be > 0.
+		min = curve_data->boundingRect().left();
+		max = curve_data->boundingRect().right();
+		if (min <= 0.)
+			min = 1.;
+		if (max <= min)
+			max = min * 1000.;
+	}
+	else if (curve_data->type() == CurveType::ScopeCurve) {
+		// The time since the start of the frame.
+		min = 0.;
+		max = curve_data->boundingRect().right();
+		if (max <= min)
+			max = 1.;
+	}
 	else {
 		throw std::runtime_error(
 			"Plot::init_x_axis(): Curve type not implemented!");
@@ -363,6 +451,8 @@ int Plot::init_x_axis(BaseCurveData *curve_data, int x_axis_id)
 	if (curve_data->type() == CurveType::TimeCurve &&
 			!curve_data->is_relative_time())
 		this->setAxisScaleEngine(x_axis_id, new QwtDateScaleEngine());
+	else if (curve_data->type() == CurveType::SpectrumCurve)
+		this->setAxisScaleEngine(x_axis_id, new QwtLogScaleEngine());
 
 	return x_axis_id;
 }
@@ -701,11 +791,39 @@ void Plot::on_legend_clicked(const QVariant &item_info, int index)
 	dlg.exec();
 }
 
-void Plot::update_curves()
+void Plot::on_tiles_rendered()
 {
-	for (const auto &curve : curve_map_) {
-		const size_t painted_points = curve.second->painted_points();
-		const size_t num_points = curve.second->curve_data()->size();
+	// While the plot is refreshed, the tiles are composited with the next
+	// refresh, so the refresh pacing of the scheduler is kept.
+	if (started_)
+		tiles_dirty_ = true;
+	else
+		this->replot();
+}
+
+void Plot::update_curves(const vector<Curve *> &curves)
+{
+	bool snapshot_changed = false;
+	for (auto *curve : curves) {
+		// Spectra are replaced as a whole and can't be painted incrementally.
+		if (curve->curve_data()->type() == CurveType::SpectrumCurve) {
+			auto *spectrum_data = qobject_cast<SpectrumCurveData *>(
+				curve->curve_data());
+			if (spectrum_data && spectrum_data->update_spectrum())
+				snapshot_changed = true;
+			continue;
+		}
+		// Scope frames are replaced as a whole, too.
+		if (curve->curve_data()->type() == CurveType::ScopeCurve) {
+			auto *scope_data = qobject_cast<ScopeCurveData *>(
+				curve->curve_data());
+			if (scope_data && scope_data->update_frames())
+				snapshot_changed = true;
+			continue;
+		}
+
+		const size_t painted_points = curve->painted_points();
+		const size_t num_points = curve->curve_data()->size();
 		if (num_points > painted_points) {
 			//qWarning() << QString("Plot::updateCurve(): num_points = %1, painted_points = %2").
 			//	arg(num_points).arg(painted_points);
@@ -719,34 +837,45 @@ void Plot::update_curves()
 				 * out - maybe to an unaccelerated frame buffer device.
 				 */
 
-				const QwtScaleMap x_map = canvasMap(curve.second->x_axis_id());
-				const QwtScaleMap y_map = canvasMap(curve.second->y_axis_id());
-				QRectF br = qwtBoundingRect(*curve.second->plot_curve()->data(),
+				const QwtScaleMap x_map = canvasMap(curve->x_axis_id());
+				const QwtScaleMap y_map = canvasMap(curve->y_axis_id());
+				QRectF br = qwtBoundingRect(*curve->plot_curve()->data(),
 					(int)painted_points - 1, (int)num_points - 1);
 
-				curve.second->plot_direct_painter()->setClipRegion(
+				curve->plot_direct_painter()->setClipRegion(
 					QwtScaleMap::transform(x_map, y_map, br).toRect());
 			}
-			curve.second->plot_direct_painter()->drawSeries(
-				curve.second->plot_curve(), (int)painted_points - 1,
+			curve->plot_direct_painter()->drawSeries(
+				curve->plot_curve(), (int)painted_points - 1,
 				(int)num_points - 1);
-			curve.second->set_painted_points(num_points);
+			curve->set_painted_points(num_points);
 		}
 
 		//replot();
 	}
+
+	if (snapshot_changed)
+		replot();
 }
 
-void Plot::update_intervals()
+void Plot::update_intervals(const vector<Curve *> &curves)
 {
 	bool intervals_changed = false;
 
-	for (const auto &curve : curve_map_) {
-		if (update_x_interval(curve.second))
+	// In the rolling and oscilloscope modes, only the extremes of the
+	// visible time window are used for the y axis.
+	const bool windowed = update_mode_ == PlotUpdateMode::Rolling ||
+		update_mode_ == PlotUpdateMode::Oscilloscope;
+	for (auto *curve : curves) {
+		if (update_x_interval(curve))
 			intervals_changed = true;
-		if (update_y_interval(curve.second))
+		if (windowed && curve->curve_data()->type() == CurveType::TimeCurve)
+			continue;
+		if (update_y_interval(curve))
 			intervals_changed = true;
 	}
+	if (windowed && update_windowed_y_intervals())
+		intervals_changed = true;
 
 	if (intervals_changed)
 		replot();
@@ -782,6 +911,42 @@ bool Plot::update_x_interval(Curve *curve)
 		if (interval_changed)
 			setAxisScale(QwtPlot::xBottom, min, max);
 	}
+	// Spectra are shown on a logarithmic axis, don't add a margin.
+	else if (curve->curve_data()->type() == CurveType::SpectrumCurve) {
+		if (boundaries.left() <= 0.)
+			return false;
+		if (!axis_lock_map_[QwtPlot::xBottom][AxisBoundary::LowerBoundary] &&
+				boundaries.left() < min) {
+			min = boundaries.left();
+			interval_changed = true;
+		}
+		if (!axis_lock_map_[QwtPlot::xBottom][AxisBoundary::UpperBoundary] &&
+				boundaries.right() > max) {
+			max = boundaries.right();
+			interval_changed = true;
+		}
+
+		if (interval_changed)
+			setAxisScale(QwtPlot::xBottom, min, max);
+	}
+	// Scope frames always start at 0 and have a fixed length.
+	else if (curve->curve_data()->type() == CurveType::ScopeCurve) {
+		if (boundaries.right() <= 0.)
+			return false;
+		if (!axis_lock_map_[QwtPlot::xBottom][AxisBoundary::LowerBoundary] &&
+				min != 0.) {
+			min = 0.;
+			interval_changed = true;
+		}
+		if (!axis_lock_map_[QwtPlot::xBottom][AxisBoundary::UpperBoundary] &&
+				boundaries.right() != max) {
+			max = boundaries.right();
+			interval_changed = true;
+		}
+
+		if (interval_changed)
+			setAxisScale(QwtPlot::xBottom, min, max);
+	}
 	// Handle the Additive plot mode
 	else if (update_mode_ == PlotUpdateMode::Additive) {
 		if (!axis_lock_map_[QwtPlot::xBottom][AxisBoundary::LowerBoundary] &&
@@ -882,6 +1047,76 @@ bool Plot::update_y_interval(const Curve *curve)
 	return interval_changed;
 }
 
+bool Plot::update_windowed_y_intervals()
+{
+	const QwtInterval x_interval = this->axisInterval(QwtPlot::xBottom);
+
+	// Combine the extremes of all time curves per y axis.
+	map<int, pair<double, double>> y_ranges;
+	for (const auto &curve : curve_map_) {
+		if (curve.second->curve_data()->type() != CurveType::TimeCurve)
+			continue;
+
+		double y_min;
+		double y_max;
+		if (!curve.second->curve_data()->y_range(x_interval.minValue(),
+				x_interval.maxValue(), y_min, y_max))
+			continue;
+
+		const int y_axis_id = curve.second->y_axis_id();
+		if (y_ranges.count(y_axis_id) == 0) {
+			y_ranges[y_axis_id] = make_pair(y_min, y_max);
+		}
+		else {
+			y_ranges[y_axis_id].first = std::min(y_ranges[y_axis_id].first, y_min);
+			y_ranges[y_axis_id].second = std::max(y_ranges[y_axis_id].second, y_max);
+		}
+	}
+
+	bool intervals_changed = false;
+	for (const auto &y_range : y_ranges) {
+		const int y_axis_id = y_range.first;
+		const bool min_locked =
+			axis_lock_map_[y_axis_id][AxisBoundary::LowerBoundary];
+		const bool max_locked =
+			axis_lock_map_[y_axis_id][AxisBoundary::UpperBoundary];
+		if (min_locked && max_locked)
+			continue;
+
+		// Values +/- 10%
+		const double data_min = y_range.second.first;
+		const double data_max = y_range.second.second;
+		const double new_min = data_min - (std::fabs(data_min) * 0.1);
+		const double new_max = data_max + (std::fabs(data_max) * 0.1);
+
+		const QwtInterval y_interval = this->axisInterval(y_axis_id);
+		double min = y_interval.minValue();
+		double max = y_interval.maxValue();
+
+		// Extend the interval when the values leave it, shrink it when it is
+		// more than twice as large as needed (e.g. after a spike has left
+		// the time window).
+		bool interval_changed = false;
+		const bool shrink = new_max > new_min &&
+			(max - min) > 2 * (new_max - new_min);
+		if (!min_locked && (data_min < min || shrink)) {
+			min = new_min;
+			interval_changed = true;
+		}
+		if (!max_locked && (data_max > max || shrink)) {
+			max = new_max;
+			interval_changed = true;
+		}
+
+		if (interval_changed && max > min) {
+			setAxisScale(y_axis_id, min, max);
+			intervals_changed = true;
+		}
+	}
+
+	return intervals_changed;
+}
+
 void Plot::set_markers_label_alignment(int alignment)
 {
 	markers_label_alignment_ = alignment;
@@ -894,6 +1129,16 @@ void Plot::set_markers_label_alignment(int alignment)
 	}
 }
 
+void Plot::set_suspended(bool suspended)
+{
+	if (suspended == suspended_)
+		return;
+
+	suspended_ = suspended;
+	for (const auto &curve : curve_map_)
+		curve.second->curve_data()->set_suspended(suspended_);
+}
+
 void Plot::update_markers_label()
 {
 	if (!markers_label_) {
@@ -967,17 +1212,6 @@ void Plot::update_markers_label()
 	markers_label_->setText(text);
 }
 
-void Plot::timerEvent(QTimerEvent *event)
-{
-	if (event->timerId() == timer_id_) {
-		update_intervals();
-		update_curves();
-		return;
-	}
-
-	QwtPlot::timerEvent(event);
-}
-
 void Plot::resizeEvent(QResizeEvent *event)
 {
 	for (const auto &curve : curve_map_) {
@@ -1028,7 +1262,9 @@ void Plot::restore_settings(QSettings &settings, bool restore_curves,
 		return;
 	const auto groups = settings.childGroups();
 	for (const auto &group : groups) {
-		if (group.startsWith("timecurve:") || group.startsWith("xycurve:")) {
+		if (group.startsWith("timecurve:") || group.startsWith("xycurve:") ||
+				group.startsWith("spectrumcurve:") ||
+				group.startsWith("scopecurve:")) {
 			Curve *curve = Curve::init_from_settings(
 				session_, settings, group, origin_device);
 			if (curve)
@@ -63,7 +63,9 @@ namespace plot {
 
 class BaseCurveData;
 class Curve;
+class CurveTileLayer;
 class PlotMagnifier;
+class PlotRefreshScheduler;
 
 enum class AxisBoundary {
 	LowerBoundary,
@@ -110,6 +112,7 @@ public:
 	void set_axis_locked(int axis_id, AxisBoundary axis_boundary, bool locked);
 	void set_all_axis_locked(bool locked);
 	void set_plot_interval(int plot_interval) { plot_interval_ = plot_interval; }
+	int plot_interval() const { return plot_interval_; }
 	void set_update_mode(PlotUpdateMode update_mode) { update_mode_ = update_mode; }
 	PlotUpdateMode update_mode() const { return update_mode_; };
 	void set_time_span(double time_span);
@@ -119,6 +122,12 @@ public:
 	map<QwtPlotMarker *, Curve *> marker_curve_map() const { return marker_curve_map_; }
 	void set_markers_label_alignment(int alignment);
 	int markers_label_alignment() const { return markers_label_alignment_; }
+	/**
+	 * Suspend the sample processing of all curves, while the plot isn't
+	 * visible.
+	 */
+	void set_suspended(bool suspended);
+	bool is_suspended() const { return suspended_; }
 
 	void save_settings(QSettings &settings, bool save_curves,
 		shared_ptr<sv::devices::BaseDevice> origin_device) const;
@@ -128,6 +137,12 @@ public:
 public Q_SLOTS:
 	void start();
 	void stop();
+	/**
+	 * Update the intervals and paint the new samples of all curves, whose
+	 * data has changed since the last refresh. This is called by the
+	 * PlotRefreshScheduler.
+	 */
+	void refresh();
 	void add_axis_icons(const int axis_id);
 	void lock_all_axis();
 	void on_axis_lock_clicked();
@@ -137,33 +152,41 @@ public Q_SLOTS:
 	void on_marker_selected(const QPointF mouse_pos);
 	void on_marker_moved(const QPointF mouse_pos);
 	void on_legend_clicked(const QVariant &item_info, int index);
+	void on_tiles_rendered();
 
 protected:
 	virtual void showEvent(QShowEvent *event) override;
 	virtual void resizeEvent(QResizeEvent *event) override;
-	virtual void timerEvent(QTimerEvent *event) override;
 
 private:
+	void set_curve_tiled(Curve *curve);
 	int init_x_axis(BaseCurveData *curve_data, int x_axis_id = -1);
 	int init_y_axis(BaseCurveData *curve_data, int y_axis_id = -1);
 	void init_axis(int axis_id, double min, double max, const QString &title,
 		bool auto_scale);
-	void update_curves();
-	void update_intervals();
+	void update_curves(const vector<Curve *> &curves);
+	void update_intervals(const vector<Curve *> &curves);
 	bool update_x_interval(Curve *curve);
 	bool update_y_interval(const Curve *curve);
+	bool update_windowed_y_intervals();
 	void update_markers_label();
 	Curve *get_curve_from_plot_curve(const QwtPlotCurve *plot_curve) const;
 
 	Session &session_;
+	shared_ptr<PlotRefreshScheduler> refresh_scheduler_;
 	map<string, Curve *> curve_map_;
 	map<int, map<AxisBoundary, bool>> axis_lock_map_; // map<axis_id, map<AxisBoundary, locked>>
 	int plot_interval_;
-	int timer_id_;
 	PlotUpdateMode update_mode_;
 	double time_span_;
 	double add_time_;
+	bool suspended_;
+	/** The plot is refreshed by the PlotRefreshScheduler. */
+	bool started_;
+	/** New tiles were rendered, replot with the next refresh. */
+	bool tiles_dirty_;
 
+	CurveTileLayer *tile_layer_;
 	QwtPlotPanner *plot_panner_;
 	PlotMagnifier *plot_magnifier_;
 
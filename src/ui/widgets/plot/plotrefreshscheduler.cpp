@@ -0,0 +1,164 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QTimer>
+#include <QWidget>
+
+#include "plotrefreshscheduler.hpp"
+#include "src/ui/widgets/plot/plot.hpp"
+
+using std::function;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+const double PlotRefreshScheduler::max_load_factor_ = 8.;
+
+PlotRefreshScheduler::PlotRefreshScheduler(QObject *parent) :
+	QObject(parent),
+	next_entry_(0),
+	frame_interval_(16),
+	load_factor_(1.)
+{
+	QScreen *screen = QGuiApplication::primaryScreen();
+	if (screen && screen->refreshRate() > 0)
+		frame_interval_ = std::max(1, (int)(1000. / screen->refreshRate()));
+
+	clock_.start();
+
+	timer_ = new QTimer(this);
+	timer_->setTimerType(Qt::PreciseTimer);
+	timer_->setInterval(frame_interval_);
+	connect(timer_, &QTimer::timeout, this, &PlotRefreshScheduler::on_tick);
+}
+
+void PlotRefreshScheduler::add_plot(Plot *plot)
+{
+	add_entry(plot,
+		[plot]() { plot->refresh(); },
+		[plot]() { return plot->plot_interval(); });
+}
+
+void PlotRefreshScheduler::remove_plot(Plot *plot)
+{
+	remove_entry(plot);
+}
+
+void PlotRefreshScheduler::add_panel(QWidget *panel, function<void()> refresh)
+{
+	// A panel interval of 0 means once per frame.
+	add_entry(panel, std::move(refresh), []() { return 0; });
+}
+
+void PlotRefreshScheduler::remove_panel(QWidget *panel)
+{
+	remove_entry(panel);
+}
+
+void PlotRefreshScheduler::add_entry(QWidget *widget,
+	function<void()> refresh, function<int()> interval)
+{
+	for (const auto &entry : entries_) {
+		if (entry.widget == widget)
+			return;
+	}
+	entries_.push_back({ widget, std::move(refresh), std::move(interval),
+		clock_.elapsed() });
+
+	if (!timer_->isActive())
+		timer_->start();
+}
+
+void PlotRefreshScheduler::remove_entry(QWidget *widget)
+{
+	entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+		[widget](const RefreshEntry &entry) { return entry.widget == widget; }),
+		entries_.end());
+
+	if (entries_.empty())
+		timer_->stop();
+}
+
+double PlotRefreshScheduler::load_factor() const
+{
+	return load_factor_;
+}
+
+bool PlotRefreshScheduler::is_widget_visible(const QWidget *widget)
+{
+	if (!widget->isVisible() || widget->visibleRegion().isEmpty())
+		return false;
+	return !widget->window()->isMinimized();
+}
+
+void PlotRefreshScheduler::on_tick()
+{
+	if (entries_.empty())
+		return;
+
+	// Only use half of the frame for the refreshes, the rest is left for the
+	// input handling and painting.
+	const qint64 budget = std::max(1, frame_interval_ / 2);
+	const qint64 now = clock_.elapsed();
+	QElapsedTimer tick_timer;
+	tick_timer.start();
+
+	bool over_budget = false;
+	const size_t entry_count = entries_.size();
+	size_t i;
+	for (i = 0; i < entry_count; ++i) {
+		RefreshEntry &entry = entries_[(next_entry_ + i) % entry_count];
+		if (now < entry.next_refresh)
+			continue;
+		if (!is_widget_visible(entry.widget))
+			continue;
+		if (tick_timer.elapsed() >= budget) {
+			over_budget = true;
+			break;
+		}
+
+		entry.refresh();
+		entry.next_refresh = now +
+			(qint64)std::ceil(entry.interval() * load_factor_);
+	}
+	// Continue with the first entry, that wasn't refreshed in this frame.
+	next_entry_ = (next_entry_ + i) % entry_count;
+
+	const qint64 elapsed = tick_timer.elapsed();
+	if (over_budget || elapsed > budget)
+		load_factor_ = std::min(max_load_factor_, load_factor_ * 1.5);
+	else if (elapsed < budget / 4)
+		load_factor_ = std::max(1., load_factor_ / 1.1);
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
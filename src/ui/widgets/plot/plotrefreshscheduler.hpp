@@ -0,0 +1,112 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_PLOTREFRESHSCHEDULER_HPP
+#define UI_WIDGETS_PLOT_PLOTREFRESHSCHEDULER_HPP
+
+#include <functional>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <QWidget>
+
+using std::function;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+class Plot;
+
+/**
+ * A single, frame paced refresh timer for all plots and value panels of the
+ * session.
+ *
+ * The scheduler ticks once per display frame and refreshes the plots, whose
+ * plot interval has elapsed, in a round robin order. Panels are refreshed
+ * once per frame, they must skip the refresh themselves when their data
+ * hasn't changed. Hidden widgets (e.g. in a dock behind another tab) and
+ * widgets in minimized windows are skipped, they are refreshed when they are
+ * shown again.
+ *
+ * Only a part of the frame is used for refreshing the plots, the remaining
+ * plots are refreshed in the next frame. When the refreshes take longer than
+ * the budget, the refresh intervals of all plots are stretched by a load
+ * factor, so the GUI stays responsive. The load factor recovers when the
+ * load goes down.
+ */
+class PlotRefreshScheduler : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit PlotRefreshScheduler(QObject *parent = nullptr);
+
+	void add_plot(Plot *plot);
+	void remove_plot(Plot *plot);
+	/**
+	 * Add a panel widget (e.g. a value panel), that is refreshed at most once
+	 * per display frame by calling the given refresh function.
+	 */
+	void add_panel(QWidget *panel, function<void()> refresh);
+	void remove_panel(QWidget *panel);
+
+	/** Return the actual factor, by which all plot intervals are stretched. */
+	double load_factor() const;
+
+private:
+	struct RefreshEntry
+	{
+		QWidget *widget;
+		function<void()> refresh;
+		/** Return the refresh interval in ms. */
+		function<int()> interval;
+		qint64 next_refresh;
+	};
+
+	void add_entry(QWidget *widget, function<void()> refresh,
+		function<int()> interval);
+	void remove_entry(QWidget *widget);
+	static bool is_widget_visible(const QWidget *widget);
+
+	vector<RefreshEntry> entries_;
+	size_t next_entry_;
+	QTimer *timer_;
+	QElapsedTimer clock_;
+	int frame_interval_;
+	double load_factor_;
+
+	/** The maximum load factor. */
+	static const double max_load_factor_;
+
+private Q_SLOTS:
+	void on_tick();
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_PLOTREFRESHSCHEDULER_HPP
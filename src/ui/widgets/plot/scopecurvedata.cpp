@@ -0,0 +1,316 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <QPointF>
+#include <QRectF>
+#include <QSettings>
+#include <QString>
+
+#include "scopecurvedata.hpp"
+#include "src/session.hpp"
+#include "src/settingsmanager.hpp"
+#include "src/channels/hardwarechannel.hpp"
+#include "src/data/basesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/framebuffer.hpp"
+#include "src/devices/basedevice.hpp"
+#include "src/ui/widgets/plot/basecurvedata.hpp"
+
+using std::dynamic_pointer_cast;
+using std::set;
+using std::shared_ptr;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+ScopeCurveData::ScopeCurveData(
+		shared_ptr<sv::channels::HardwareChannel> channel,
+		ScopeDisplayMode display_mode) :
+	BaseCurveData(CurveType::ScopeCurve),
+	channel_(channel),
+	display_mode_(display_mode),
+	mode_generation_(0),
+	updated_generation_(std::numeric_limits<size_t>::max()),
+	sample_interval_(1.)
+{
+	// The frames are only copied into the frame buffer, while they are shown.
+	channel_->enable_scope_mode();
+	update_frames();
+}
+
+ScopeCurveData::~ScopeCurveData()
+{
+	channel_->disable_scope_mode();
+}
+
+bool ScopeCurveData::is_equal(const BaseCurveData *other) const
+{
+	const ScopeCurveData *scd = dynamic_cast<const ScopeCurveData *>(other);
+	if (scd == nullptr)
+		return false;
+
+	return channel_ == scd->channel() && display_mode_ == scd->display_mode();
+}
+
+size_t ScopeCurveData::generation() const
+{
+	return channel_->frame_buffer()->generation() + mode_generation_;
+}
+
+QPointF ScopeCurveData::sample(size_t index) const
+{
+	return points_.at(index);
+}
+
+size_t ScopeCurveData::size() const
+{
+	return points_.size();
+}
+
+QRectF ScopeCurveData::boundingRect() const
+{
+	return bounding_rect_;
+}
+
+QPointF ScopeCurveData::closest_point(const QPointF &pos, double *dist) const
+{
+	if (points_.empty())
+		return QPointF(0, 0); // TODO
+
+	size_t index = 0;
+	if (display_mode_ == ScopeDisplayMode::LastFrame ||
+			display_mode_ == ScopeDisplayMode::Average) {
+		// The samples are equidistant, so the closest sample can be
+		// calculated.
+		const double pos_index = std::round(pos.x() / sample_interval_);
+		index = (size_t)std::min(
+			std::max(pos_index, 0.), (double)points_.size() - 1);
+	}
+	else {
+		double d_min = std::numeric_limits<double>::infinity();
+		for (size_t i = 0; i < points_.size(); ++i) {
+			const double d = std::hypot(
+				points_[i].x() - pos.x(), points_[i].y() - pos.y());
+			if (d < d_min) {
+				d_min = d;
+				index = i;
+			}
+		}
+	}
+
+	const QPointF sample_point = points_[index];
+	if (dist) {
+		*dist = std::hypot(
+			sample_point.x() - pos.x(), sample_point.y() - pos.y());
+	}
+
+	return sample_point;
+}
+
+QString ScopeCurveData::name() const
+{
+	return channel_->display_name();
+}
+
+string ScopeCurveData::id_prefix() const
+{
+	return "scopecurve";
+}
+
+sv::data::Quantity ScopeCurveData::x_quantity() const
+{
+	return sv::data::Quantity::Time;
+}
+
+set<sv::data::QuantityFlag> ScopeCurveData::x_quantity_flags() const
+{
+	return set<sv::data::QuantityFlag>();
+}
+
+sv::data::Unit ScopeCurveData::x_unit() const
+{
+	return sv::data::Unit::Second;
+}
+
+QString ScopeCurveData::x_unit_str() const
+{
+	return data::datautil::format_unit(x_unit(), x_quantity_flags());
+}
+
+QString ScopeCurveData::x_title() const
+{
+	return QString("%1 [%2]").
+		arg(data::datautil::format_quantity(x_quantity()), x_unit_str());
+}
+
+sv::data::Quantity ScopeCurveData::y_quantity() const
+{
+	if (!channel_->actual_signal())
+		return sv::data::Quantity::Unknown;
+	return channel_->actual_signal()->quantity();
+}
+
+set<sv::data::QuantityFlag> ScopeCurveData::y_quantity_flags() const
+{
+	if (!channel_->actual_signal())
+		return set<sv::data::QuantityFlag>();
+	return channel_->actual_signal()->quantity_flags();
+}
+
+sv::data::Unit ScopeCurveData::y_unit() const
+{
+	if (!channel_->actual_signal())
+		return sv::data::Unit::Unknown;
+	return channel_->actual_signal()->unit();
+}
+
+QString ScopeCurveData::y_unit_str() const
+{
+	return data::datautil::format_unit(y_unit(), y_quantity_flags());
+}
+
+QString ScopeCurveData::y_title() const
+{
+	// Don't use only the unit, so we can add AC/DC to axis label.
+	return QString("%1 [%2]").
+		arg(data::datautil::format_quantity(y_quantity()), y_unit_str());
+}
+
+shared_ptr<sv::channels::HardwareChannel> ScopeCurveData::channel() const
+{
+	return channel_;
+}
+
+void ScopeCurveData::set_display_mode(ScopeDisplayMode display_mode)
+{
+	if (display_mode == display_mode_)
+		return;
+	display_mode_ = display_mode;
+	++mode_generation_;
+}
+
+size_t ScopeCurveData::snapshot_generation() const
+{
+	return updated_generation_;
+}
+
+ScopeDisplayMode ScopeCurveData::display_mode() const
+{
+	return display_mode_;
+}
+
+bool ScopeCurveData::update_frames()
+{
+	const size_t generation = this->generation();
+	if (generation == updated_generation_)
+		return false;
+	updated_generation_ = generation;
+
+	const auto frame_buffer = channel_->frame_buffer();
+	const uint64_t samplerate = frame_buffer->samplerate();
+	sample_interval_ = samplerate > 0 ? 1. / (double)samplerate : 1.;
+
+	points_.clear();
+	switch (display_mode_) {
+	case ScopeDisplayMode::LastFrame:
+		if (frame_buffer->frame(0, frame_))
+			append_frame(frame_, false);
+		break;
+	case ScopeDisplayMode::Average:
+		if (frame_buffer->average(frame_))
+			append_frame(frame_, false);
+		break;
+	case ScopeDisplayMode::PeakDetect:
+		// Draw the envelope as closed polygon: The minimum forwards, the
+		// maximum backwards.
+		if (frame_buffer->peak(frame_, max_frame_)) {
+			append_frame(frame_, false);
+			append_frame(max_frame_, true);
+		}
+		break;
+	case ScopeDisplayMode::Persistence:
+		for (size_t age = 0; frame_buffer->frame(age, frame_); ++age)
+			append_frame(frame_, false);
+		break;
+	}
+
+	double y_min = std::numeric_limits<double>::infinity();
+	double y_max = -std::numeric_limits<double>::infinity();
+	double x_max = 0.;
+	for (const auto &point : points_) {
+		if (!std::isfinite(point.y()))
+			continue;
+		y_min = std::min(y_min, point.y());
+		y_max = std::max(y_max, point.y());
+		x_max = std::max(x_max, point.x());
+	}
+	if (y_min > y_max)
+		bounding_rect_ = QRectF();
+	else // top left, bottom right
+		bounding_rect_ = QRectF(QPointF(0., y_max), QPointF(x_max, y_min));
+
+	return true;
+}
+
+void ScopeCurveData::append_frame(const vector<float> &frame, bool reverse)
+{
+	const size_t size = frame.size();
+	for (size_t i = 0; i < size; ++i) {
+		const size_t pos = reverse ? size - 1 - i : i;
+		points_.emplace_back((double)pos * sample_interval_, (double)frame[pos]);
+	}
+}
+
+void ScopeCurveData::save_settings(QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device) const
+{
+	SettingsManager::save_channel(channel_, settings, origin_device);
+	settings.setValue("display_mode", (int)display_mode_);
+}
+
+ScopeCurveData *ScopeCurveData::init_from_settings(
+	Session &session, QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device)
+{
+	auto channel = dynamic_pointer_cast<sv::channels::HardwareChannel>(
+		SettingsManager::restore_channel(session, settings, origin_device));
+	if (!channel)
+		return nullptr;
+
+	ScopeDisplayMode display_mode = ScopeDisplayMode::LastFrame;
+	if (settings.contains("display_mode"))
+		display_mode = (ScopeDisplayMode)settings.value("display_mode").toInt();
+
+	return new ScopeCurveData(channel, display_mode);
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,157 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_SCOPECURVEDATA_HPP
+#define UI_WIDGETS_PLOT_SCOPECURVEDATA_HPP
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QPointF>
+#include <QRectF>
+#include <QSettings>
+#include <QString>
+
+#include "src/data/datautil.hpp"
+#include "src/ui/widgets/plot/basecurvedata.hpp"
+
+using std::map;
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+class Session;
+
+namespace channels {
+class HardwareChannel;
+}
+namespace devices {
+class BaseDevice;
+}
+
+namespace ui {
+namespace widgets {
+namespace plot {
+
+enum class ScopeDisplayMode {
+	/** The last frame. */
+	LastFrame = 0,
+	/** The average of the stored frames. */
+	Average,
+	/** The min/max envelope of the stored frames. */
+	PeakDetect,
+	/** All stored frames, best drawn in the density render mode. */
+	Persistence
+};
+
+// TODO: Use tr(), QCoreApplication::translate(), QT_TR_NOOP() or
+//       QT_TRANSLATE_NOOP() for translation.
+//       See: http://doc.qt.io/qt-5/i18n-source-translation.html
+typedef map<ScopeDisplayMode, QString> scope_display_mode_name_map_t;
+static scope_display_mode_name_map_t scope_display_mode_name_map = {
+	{ ScopeDisplayMode::LastFrame, QString("Last frame") },
+	{ ScopeDisplayMode::Average, QString("Average") },
+	{ ScopeDisplayMode::PeakDetect, QString("Peak detect") },
+	{ ScopeDisplayMode::Persistence, QString("Persistence") },
+};
+
+/**
+ * The frames of an oscilloscope channel, from the FrameBuffer of the
+ * channel. The x axis is the time since the start of the frame.
+ *
+ * Like spectrum curves, the whole curve is replaced by every new frame. The
+ * plot fetches the latest frame(s) via update_frames().
+ */
+class ScopeCurveData : public BaseCurveData
+{
+	Q_OBJECT
+
+public:
+	explicit ScopeCurveData(
+		shared_ptr<sv::channels::HardwareChannel> channel,
+		ScopeDisplayMode display_mode = ScopeDisplayMode::LastFrame);
+	~ScopeCurveData();
+
+	bool is_equal(const BaseCurveData *other) const override;
+	size_t generation() const override;
+	size_t snapshot_generation() const override;
+
+	QPointF sample(size_t index) const override;
+	size_t size() const override;
+	QRectF boundingRect() const override;
+
+	QPointF closest_point(const QPointF &pos, double *dist) const override;
+	QString name() const override;
+	string id_prefix() const override;
+	sv::data::Quantity x_quantity() const override;
+	set<sv::data::QuantityFlag> x_quantity_flags() const override;
+	sv::data::Unit x_unit() const override;
+	QString x_unit_str() const override;
+	QString x_title() const override;
+	sv::data::Quantity y_quantity() const override;
+	set<sv::data::QuantityFlag> y_quantity_flags() const override;
+	sv::data::Unit y_unit() const override;
+	QString y_unit_str() const override;
+	QString y_title() const override;
+
+	shared_ptr<sv::channels::HardwareChannel> channel() const;
+	void set_display_mode(ScopeDisplayMode display_mode);
+	ScopeDisplayMode display_mode() const;
+
+	/**
+	 * Fetch the latest frame(s) from the frame buffer of the channel. Return
+	 * true if the curve has changed and must be replotted.
+	 */
+	bool update_frames();
+
+	void save_settings(QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device) const override;
+	static ScopeCurveData *init_from_settings(
+		Session &session, QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device);
+
+private:
+	void append_frame(const vector<float> &frame, bool reverse);
+
+	shared_ptr<sv::channels::HardwareChannel> channel_;
+	ScopeDisplayMode display_mode_;
+	/** Incremented when the display mode is changed. */
+	size_t mode_generation_;
+	size_t updated_generation_;
+	double sample_interval_;
+	vector<QPointF> points_;
+	QRectF bounding_rect_;
+	// Buffers, to not allocate memory for every frame.
+	vector<float> frame_;
+	vector<float> max_frame_;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_SCOPECURVEDATA_HPP
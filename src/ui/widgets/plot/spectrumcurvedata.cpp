@@ -0,0 +1,228 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <QPointF>
+#include <QRectF>
+#include <QSettings>
+#include <QString>
+
+#include "spectrumcurvedata.hpp"
+#include "src/session.hpp"
+#include "src/settingsmanager.hpp"
+#include "src/channels/spectrumchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+#include "src/ui/widgets/plot/basecurvedata.hpp"
+
+using std::dynamic_pointer_cast;
+using std::make_shared;
+using std::set;
+using std::shared_ptr;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+SpectrumCurveData::SpectrumCurveData(
+		shared_ptr<sv::channels::SpectrumChannel> channel) :
+	BaseCurveData(CurveType::SpectrumCurve),
+	channel_(channel),
+	bin_width_(0.),
+	max_amplitude_(0.),
+	spectrum_count_(0)
+{
+	spectrum_ = make_shared<const vector<double>>();
+	update_spectrum();
+}
+
+bool SpectrumCurveData::is_equal(const BaseCurveData *other) const
+{
+	const SpectrumCurveData *scd =
+		dynamic_cast<const SpectrumCurveData *>(other);
+	if (scd == nullptr)
+		return false;
+
+	return channel_ == scd->channel();
+}
+
+size_t SpectrumCurveData::generation() const
+{
+	return channel_->spectrum_count();
+}
+
+QPointF SpectrumCurveData::sample(size_t index) const
+{
+	// Skip the DC bin
+	return QPointF((double)(index + 1) * bin_width_, spectrum_->at(index + 1));
+}
+
+size_t SpectrumCurveData::size() const
+{
+	return spectrum_->empty() ? 0 : spectrum_->size() - 1;
+}
+
+QRectF SpectrumCurveData::boundingRect() const
+{
+	if (spectrum_->size() < 2)
+		return QRectF();
+
+	// top left, bottom right
+	return QRectF(
+		QPointF(bin_width_, max_amplitude_),
+		QPointF((double)(spectrum_->size() - 1) * bin_width_, 0.));
+}
+
+QPointF SpectrumCurveData::closest_point(const QPointF &pos, double *dist) const
+{
+	const size_t num_samples = size();
+	if (num_samples == 0)
+		return QPointF(0, 0); // TODO
+
+	// The bins are equidistant, so the closest bin can be calculated.
+	double bin = std::round(pos.x() / bin_width_) - 1;
+	size_t index = (size_t)std::min(std::max(bin, 0.), (double)num_samples-1);
+
+	const QPointF sample_point = sample(index);
+	if (dist) {
+		*dist = std::hypot(
+			sample_point.x() - pos.x(), sample_point.y() - pos.y());
+	}
+
+	return sample_point;
+}
+
+QString SpectrumCurveData::name() const
+{
+	return channel_->display_name();
+}
+
+string SpectrumCurveData::id_prefix() const
+{
+	return "spectrumcurve";
+}
+
+sv::data::Quantity SpectrumCurveData::x_quantity() const
+{
+	return sv::data::Quantity::Frequency;
+}
+
+set<sv::data::QuantityFlag> SpectrumCurveData::x_quantity_flags() const
+{
+	return set<sv::data::QuantityFlag>();
+}
+
+sv::data::Unit SpectrumCurveData::x_unit() const
+{
+	return sv::data::Unit::Hertz;
+}
+
+QString SpectrumCurveData::x_unit_str() const
+{
+	return data::datautil::format_unit(x_unit(), x_quantity_flags());
+}
+
+QString SpectrumCurveData::x_title() const
+{
+	return QString("%1 [%2]").
+		arg(data::datautil::format_quantity(x_quantity()), x_unit_str());
+}
+
+sv::data::Quantity SpectrumCurveData::y_quantity() const
+{
+	return channel_->signal()->quantity();
+}
+
+set<sv::data::QuantityFlag> SpectrumCurveData::y_quantity_flags() const
+{
+	return channel_->signal()->quantity_flags();
+}
+
+sv::data::Unit SpectrumCurveData::y_unit() const
+{
+	return channel_->signal()->unit();
+}
+
+QString SpectrumCurveData::y_unit_str() const
+{
+	return data::datautil::format_unit(y_unit(), y_quantity_flags());
+}
+
+QString SpectrumCurveData::y_title() const
+{
+	// Don't use only the unit, so we can add AC/DC to axis label.
+	return QString("%1 [%2]").
+		arg(data::datautil::format_quantity(y_quantity()), y_unit_str());
+}
+
+shared_ptr<sv::channels::SpectrumChannel> SpectrumCurveData::channel() const
+{
+	return channel_;
+}
+
+size_t SpectrumCurveData::snapshot_generation() const
+{
+	return spectrum_count_;
+}
+
+bool SpectrumCurveData::update_spectrum()
+{
+	size_t spectrum_count = channel_->spectrum_count();
+	if (spectrum_count == spectrum_count_)
+		return false;
+
+	spectrum_count_ = spectrum_count;
+	spectrum_ = channel_->spectrum();
+	bin_width_ = channel_->bin_width();
+	max_amplitude_ = 0.;
+	for (size_t i=1; i<spectrum_->size(); ++i)
+		max_amplitude_ = std::max(max_amplitude_, (*spectrum_)[i]);
+
+	return true;
+}
+
+void SpectrumCurveData::save_settings(QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device) const
+{
+	SettingsManager::save_channel(channel_, settings, origin_device);
+}
+
+SpectrumCurveData *SpectrumCurveData::init_from_settings(
+	Session &session, QSettings &settings,
+	shared_ptr<sv::devices::BaseDevice> origin_device)
+{
+	auto channel = dynamic_pointer_cast<sv::channels::SpectrumChannel>(
+		SettingsManager::restore_channel(session, settings, origin_device));
+	if (!channel)
+		return nullptr;
+
+	return new SpectrumCurveData(channel);
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_SPECTRUMCURVEDATA_HPP
+#define UI_WIDGETS_PLOT_SPECTRUMCURVEDATA_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QPointF>
+#include <QRectF>
+#include <QSettings>
+#include <QString>
+
+#include "src/data/datautil.hpp"
+#include "src/ui/widgets/plot/basecurvedata.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+class Session;
+
+namespace channels {
+class SpectrumChannel;
+}
+namespace devices {
+class BaseDevice;
+}
+
+namespace ui {
+namespace widgets {
+namespace plot {
+
+/**
+ * The amplitude spectrum of a SpectrumChannel. The DC bin is omitted, so the
+ * curve can be shown on a logarithmic frequency axis.
+ *
+ * Other than time and x/y curves, the whole curve is replaced by every new
+ * spectrum. The plot fetches the latest spectrum via update_spectrum().
+ */
+class SpectrumCurveData : public BaseCurveData
+{
+	Q_OBJECT
+
+public:
+	explicit SpectrumCurveData(
+		shared_ptr<sv::channels::SpectrumChannel> channel);
+
+	bool is_equal(const BaseCurveData *other) const override;
+	size_t generation() const override;
+	size_t snapshot_generation() const override;
+
+	QPointF sample(size_t index) const override;
+	size_t size() const override;
+	QRectF boundingRect() const override;
+
+	QPointF closest_point(const QPointF &pos, double *dist) const override;
+	QString name() const override;
+	string id_prefix() const override;
+	sv::data::Quantity x_quantity() const override;
+	set<sv::data::QuantityFlag> x_quantity_flags() const override;
+	sv::data::Unit x_unit() const override;
+	QString x_unit_str() const override;
+	QString x_title() const override;
+	sv::data::Quantity y_quantity() const override;
+	set<sv::data::QuantityFlag> y_quantity_flags() const override;
+	sv::data::Unit y_unit() const override;
+	QString y_unit_str() const override;
+	QString y_title() const override;
+
+	shared_ptr<sv::channels::SpectrumChannel> channel() const;
+
+	/**
+	 * Fetch the latest spectrum from the channel. Return true if the
+	 * spectrum has changed and the curve must be replotted.
+	 */
+	bool update_spectrum();
+
+	void save_settings(QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device) const override;
+	static SpectrumCurveData *init_from_settings(
+		Session &session, QSettings &settings,
+		shared_ptr<sv::devices::BaseDevice> origin_device);
+
+private:
+	shared_ptr<sv::channels::SpectrumChannel> channel_;
+	shared_ptr<const vector<double>> spectrum_;
+	double bin_width_;
+	double max_amplitude_;
+	size_t spectrum_count_;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_SPECTRUMCURVEDATA_HPP
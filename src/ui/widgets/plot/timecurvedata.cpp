@@ -17,13 +17,17 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include <QPointF>
 #include <QRectF>
 #include <QSettings>
 #include <QString>
+#include <qwt_scale_map.h>
 
 #include "timecurvedata.hpp"
 #include "src/session.hpp"
@@ -36,12 +40,16 @@
 using std::dynamic_pointer_cast;
 using std::set;
 using std::shared_ptr;
+using std::vector;
 
 namespace sv {
 namespace ui {
 namespace widgets {
 namespace plot {
 
+const size_t TimeCurveData::decimation_threshold_ = 4;
+const size_t TimeCurveData::pyramid_threshold_ = 64;
+
 TimeCurveData::TimeCurveData(shared_ptr<sv::data::AnalogTimeSignal> signal) :
 	BaseCurveData(CurveType::TimeCurve),
 	signal_(signal)
@@ -57,6 +65,11 @@ bool TimeCurveData::is_equal(const BaseCurveData *other) const
 	return signal_ == tcd->signal();
 }
 
+size_t TimeCurveData::generation() const
+{
+	return signal_->generation();
+}
+
 QPointF TimeCurveData::sample(size_t index) const
 {
 	//signal_data_->lock();
@@ -94,6 +107,148 @@ QRectF TimeCurveData::boundingRect() const
 		QPointF(signal_->last_timestamp(relative_time_), signal_->min_value()));
 }
 
+bool TimeCurveData::visible_range(size_t &from, size_t &to) const
+{
+	if (rect_of_interest_.isNull())
+		return BaseCurveData::visible_range(from, to);
+
+	return index_range(
+		std::min(rect_of_interest_.left(), rect_of_interest_.right()),
+		std::max(rect_of_interest_.left(), rect_of_interest_.right()),
+		from, to);
+}
+
+bool TimeCurveData::y_range(double x_min, double x_max,
+	double &y_min, double &y_max) const
+{
+	return signal_->get_min_max(x_min, x_max, relative_time_, y_min, y_max);
+}
+
+QRectF TimeCurveData::visible_bounding_rect() const
+{
+	size_t from = 0;
+	size_t to = signal_->sample_count();
+	if (to == 0 || !visible_range(from, --to))
+		return QRectF();
+
+	const double x_min = signal_->get_sample(from, relative_time_).first;
+	const double x_max = signal_->get_sample(to, relative_time_).first;
+	double y_min;
+	double y_max;
+	if (!y_range(x_min, x_max, y_min, y_max))
+		return QRectF();
+
+	// top left, bottom right
+	return QRectF(QPointF(x_min, y_max), QPointF(x_max, y_min));
+}
+
+bool TimeCurveData::index_range(double x_min, double x_max,
+	size_t &from, size_t &to) const
+{
+	const size_t sample_count = signal_->sample_count();
+	if (sample_count == 0 || from > to)
+		return false;
+	to = std::min(to, sample_count - 1);
+
+	// The samples are sorted by time. Keep one sample on each side, so the
+	// curve is connected to the canvas borders.
+	size_t first = signal_->get_lower_pos(x_min, relative_time_);
+	first = std::max(from, first > 0 ? first - 1 : 0);
+	size_t last = std::min(to, signal_->get_lower_pos(x_max, relative_time_));
+	if (first > last)
+		return false;
+
+	from = first;
+	to = last;
+	return true;
+}
+
+bool TimeCurveData::decimate(size_t from, size_t to,
+	const QwtScaleMap &x_map, vector<QPointF> &points) const
+{
+	size_t first = from;
+	size_t last = to;
+	if (!index_range(std::min(x_map.s1(), x_map.s2()),
+			std::max(x_map.s1(), x_map.s2()), first, last) || first >= last)
+		return false;
+
+	const double columns = std::abs(x_map.p2() - x_map.p1()) + 1;
+	if ((double)(last - first + 1) <= decimation_threshold_ * columns)
+		return false;
+
+	points.clear();
+	points.reserve((size_t)columns * decimation_threshold_ + 2);
+
+	auto push_sample = [&](size_t pos) {
+		auto sample = signal_->get_sample(pos, relative_time_);
+		points.push_back(QPointF(sample.first, sample.second));
+	};
+
+	// Emit the first, min, max and last sample of every column in time
+	// order. A column with many samples (e.g. the whole history in additive
+	// mode) takes the min/max from the pyramid of the signal.
+	const bool ascending = x_map.p2() >= x_map.p1();
+	size_t col_first = first;
+	while (col_first <= last) {
+		auto first_sample = signal_->get_sample(col_first, relative_time_);
+		const double column = std::floor(x_map.transform(first_sample.first));
+		const double next_column_ts =
+			x_map.invTransform(ascending ? column + 1 : column);
+		size_t col_last = signal_->get_lower_pos(next_column_ts, relative_time_);
+		col_last = std::min(last, std::max(col_first + 1, col_last) - 1);
+
+		double min;
+		double max;
+		if (col_last - col_first + 1 > pyramid_threshold_ &&
+				signal_->get_min_max(col_first, col_last, min, max)) {
+			// The positions of min and max are unknown, but the whole column
+			// is one pixel wide. Draw the extreme nearer to the first sample
+			// first.
+			auto last_sample = signal_->get_sample(col_last, relative_time_);
+			const double x_mid = (first_sample.first + last_sample.first) / 2;
+			if (std::fabs(first_sample.second - min) >
+					std::fabs(first_sample.second - max))
+				std::swap(min, max);
+			points.push_back(QPointF(first_sample.first, first_sample.second));
+			points.push_back(QPointF(x_mid, min));
+			points.push_back(QPointF(x_mid, max));
+			points.push_back(QPointF(last_sample.first, last_sample.second));
+		}
+		else {
+			size_t col_min = col_first;
+			size_t col_max = col_first;
+			double col_min_value = first_sample.second;
+			double col_max_value = first_sample.second;
+			for (size_t i = col_first + 1; i <= col_last; ++i) {
+				const double value = signal_->get_sample(i, relative_time_).second;
+				if (value < col_min_value) {
+					col_min = i;
+					col_min_value = value;
+				}
+				else if (value > col_max_value) {
+					col_max = i;
+					col_max_value = value;
+				}
+			}
+			size_t pos[4] = {
+				col_first,
+				std::min(col_min, col_max),
+				std::max(col_min, col_max),
+				col_last
+			};
+			for (size_t i = 0; i < 4; ++i) {
+				if (i > 0 && pos[i] == pos[i-1])
+					continue;
+				push_sample(pos[i]);
+			}
+		}
+
+		col_first = col_last + 1;
+	}
+
+	return true;
+}
+
 QPointF TimeCurveData::closest_point(const QPointF &pos, double *dist) const
 {
 	(void)dist;
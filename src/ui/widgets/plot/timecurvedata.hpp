@@ -23,11 +23,13 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <QPointF>
 #include <QRectF>
 #include <QSettings>
 #include <QString>
+#include <qwt_scale_map.h>
 
 #include "src/data/datautil.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
@@ -35,6 +37,7 @@
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::vector;
 
 namespace sv {
 
@@ -59,10 +62,19 @@ public:
 	explicit TimeCurveData(shared_ptr<sv::data::AnalogTimeSignal> signal);
 
 	bool is_equal(const BaseCurveData *other) const override;
+	size_t generation() const override;
 
 	QPointF sample(size_t index) const override;
 	size_t size() const override;
 	QRectF boundingRect() const override;
+	bool index_range(double x_min, double x_max,
+		size_t &from, size_t &to) const override;
+	bool visible_range(size_t &from, size_t &to) const override;
+	bool y_range(double x_min, double x_max,
+		double &y_min, double &y_max) const override;
+	QRectF visible_bounding_rect() const override;
+	bool decimate(size_t from, size_t to, const QwtScaleMap &x_map,
+		vector<QPointF> &points) const override;
 
 	QPointF closest_point(const QPointF &pos, double *dist) const override;
 	QString name() const override;
@@ -89,6 +101,17 @@ public:
 private:
 	shared_ptr<sv::data::AnalogTimeSignal> signal_;
 
+	/**
+	 * Only decimate, if there are more than this number of samples per
+	 * pixel column. Otherwise the raw samples are drawn.
+	 */
+	static const size_t decimation_threshold_;
+	/**
+	 * Pixel columns with more samples than this take the min/max from the
+	 * min/max pyramid of the signal instead of scanning the samples.
+	 */
+	static const size_t pyramid_threshold_;
+
 };
 
 } // namespace plot
@@ -17,6 +17,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -32,14 +35,15 @@
 #include "xycurvedata.hpp"
 #include "src/session.hpp"
 #include "src/settingsmanager.hpp"
+#include "src/workerpool.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/xypointindex.hpp"
 
 using std::dynamic_pointer_cast;
 using std::lock_guard;
-using std::make_shared;
 using std::mutex;
 using std::set;
 using std::shared_ptr;
@@ -55,18 +59,36 @@ XYCurveData::XYCurveData(shared_ptr<sv::data::AnalogTimeSignal> x_t_signal,
 	x_t_signal_(x_t_signal),
 	y_t_signal_(y_t_signal),
 	x_t_signal_pos_(0),
-	y_t_signal_pos_(0)
+	y_t_signal_pos_(0),
+	epoch_(0),
+	cursor_epoch_(0),
+	identity_size_(0),
+	strand_(new WorkerStrand(Session::worker_pool)),
+	alignment_scheduled_(false),
+	suspended_(false)
 {
-	x_data_ = make_shared<vector<double>>();
-	y_data_ = make_shared<vector<double>>();
+	connect(this, &XYCurveData::samples_aligned,
+		this, &XYCurveData::on_samples_aligned);
 
-	// Prefill data vectors
+	// Align the already existing samples
 	this->on_sample_appended();
 
 	connect(x_t_signal_.get(), &sv::data::AnalogTimeSignal::sample_appended,
-		this, &XYCurveData::on_sample_appended);
+		this, &XYCurveData::on_sample_appended, Qt::DirectConnection);
 	connect(y_t_signal_.get(), &sv::data::AnalogTimeSignal::sample_appended,
-		this, &XYCurveData::on_sample_appended);
+		this, &XYCurveData::on_sample_appended, Qt::DirectConnection);
+	// The points reference the samples of the signals, so they must be
+	// cleared together with the signals.
+	connect(x_t_signal_.get(), &sv::data::AnalogTimeSignal::samples_cleared,
+		this, &XYCurveData::on_samples_cleared);
+	connect(y_t_signal_.get(), &sv::data::AnalogTimeSignal::samples_cleared,
+		this, &XYCurveData::on_samples_cleared);
+}
+
+XYCurveData::~XYCurveData()
+{
+	// Wait for a running alignment, before the members are destroyed.
+	strand_->close();
 }
 
 bool XYCurveData::is_equal(const BaseCurveData *other) const
@@ -81,13 +103,27 @@ bool XYCurveData::is_equal(const BaseCurveData *other) const
 
 QPointF XYCurveData::sample(size_t index) const
 {
-	QPointF sample_point(x_data_->at(index), y_data_->at(index));
-	return sample_point;
+	if (index < identity_size_) {
+		return QPointF(x_t_signal_->get_sample(index, false).second,
+			y_t_signal_->get_sample(index, false).second);
+	}
+
+	const AlignedPoint &point = points_.at(index - identity_size_);
+	if (point.factor > 0) {
+		return QPointF(x_t_signal_->get_sample(point.x_pos, false).second,
+			interpolate(y_t_signal_, point.y_pos, point.factor));
+	}
+	if (point.factor < 0) {
+		return QPointF(interpolate(x_t_signal_, point.x_pos, -point.factor),
+			y_t_signal_->get_sample(point.y_pos, false).second);
+	}
+	return QPointF(x_t_signal_->get_sample(point.x_pos, false).second,
+		y_t_signal_->get_sample(point.y_pos, false).second);
 }
 
 size_t XYCurveData::size() const
 {
-	return x_data_->size();
+	return identity_size_ + points_.size();
 }
 
 QRectF XYCurveData::boundingRect() const
@@ -98,29 +134,39 @@ QRectF XYCurveData::boundingRect() const
 		QPointF(x_t_signal_->max_value(), y_t_signal_->min_value()));
 }
 
+void XYCurveData::set_suspended(bool suspended)
+{
+	suspended_ = suspended;
+	// Align all samples, that were appended while suspended.
+	if (!suspended_)
+		on_sample_appended();
+}
+
 QPointF XYCurveData::closest_point(const QPointF &pos, double *dist) const
 {
-	const size_t num_samples = size();
-	if (num_samples == 0)
+	point_index_.update(*this, size());
+
+	// Scale both axes to the visible area, if known.
+	double x_scale = 1.;
+	double y_scale = 1.;
+	if (rect_of_interest_.width() != 0. && rect_of_interest_.height() != 0.) {
+		x_scale = 1. / std::fabs(rect_of_interest_.width());
+		y_scale = 1. / std::fabs(rect_of_interest_.height());
+	}
+
+	size_t index;
+	double scaled_dist;
+	if (!point_index_.nearest(*this, pos.x(), pos.y(),
+			x_scale, y_scale, index, scaled_dist))
 		return QPointF(0, 0); // TODO
 
-	size_t index = -1;
-	double d_min = 1.0e10;
-
-	for (size_t i=0; i < num_samples; i++) {
-		const QPointF sample_point = sample(i);
-		const double d_x = sample_point.x() - pos.x();
-		const double d_y = sample_point.y() - pos.y();
-		const double d_actual = qwtSqr(d_x) + qwtSqr(d_y);
-		if (d_actual < d_min) {
-			index = i;
-			d_min = d_actual;
-		}
+	const QPointF sample_point = sample(index);
+	if (dist) {
+		*dist = qSqrt(qwtSqr(sample_point.x() - pos.x()) +
+			qwtSqr(sample_point.y() - pos.y()));
 	}
-	if (dist)
-		*dist = qSqrt(d_min);
 
-	return sample(index);
+	return sample_point;
 }
 
 QString XYCurveData::name() const
@@ -222,15 +268,131 @@ XYCurveData *XYCurveData::init_from_settings(
 		dynamic_pointer_cast<sv::data::AnalogTimeSignal>(y_t_data_signal));
 }
 
+void XYCurveData::align_samples()
+{
+	// The signals were cleared, start at the first samples again.
+	const size_t epoch = epoch_;
+	if (epoch != cursor_epoch_) {
+		cursor_epoch_ = epoch;
+		x_t_signal_pos_ = 0;
+		y_t_signal_pos_ = 0;
+	}
+
+	// Merge join of the x and y samples.
+	// Samples before the first sample of the other signal are ignored.
+	const size_t x_count = x_t_signal_->sample_count();
+	const size_t y_count = y_t_signal_->sample_count();
+	const size_t max_pos = std::numeric_limits<uint32_t>::max();
+	vector<AlignedPoint> points;
+	while (x_t_signal_pos_ < x_count && y_t_signal_pos_ < y_count &&
+			x_t_signal_pos_ < max_pos && y_t_signal_pos_ < max_pos) {
+
+		const double x_ts = x_t_signal_->get_sample(x_t_signal_pos_, false).first;
+		const double y_ts = y_t_signal_->get_sample(y_t_signal_pos_, false).first;
+		AlignedPoint point{ (uint32_t)x_t_signal_pos_, (uint32_t)y_t_signal_pos_,
+			0.f };
+
+		if (x_ts == y_ts) {
+			++x_t_signal_pos_;
+			++y_t_signal_pos_;
+		}
+		else if (x_ts < y_ts) {
+			++x_t_signal_pos_;
+			if (point.y_pos == 0)
+				continue;
+			const double prev_ts =
+				y_t_signal_->get_sample(point.y_pos - 1, false).first;
+			point.factor = (float)((x_ts - prev_ts) / (y_ts - prev_ts));
+			// Exactly at the previous sample (duplicate timestamps).
+			if (point.factor <= 0.f) {
+				point.factor = 0.f;
+				--point.y_pos;
+			}
+		}
+		else {
+			++y_t_signal_pos_;
+			if (point.x_pos == 0)
+				continue;
+			const double prev_ts =
+				x_t_signal_->get_sample(point.x_pos - 1, false).first;
+			point.factor = -(float)((y_ts - prev_ts) / (x_ts - prev_ts));
+			if (point.factor >= 0.f) {
+				point.factor = 0.f;
+				--point.x_pos;
+			}
+		}
+		points.push_back(point);
+	}
+	if (points.empty())
+		return;
+
+	{
+		lock_guard<mutex> lock(sample_append_mutex_);
+		// Drop the points, if the signals were cleared meanwhile.
+		if (epoch != epoch_)
+			return;
+		aligned_points_.insert(aligned_points_.end(),
+			points.begin(), points.end());
+	}
+	Q_EMIT samples_aligned();
+}
+
+double XYCurveData::interpolate(
+	const shared_ptr<sv::data::AnalogTimeSignal> &signal,
+	size_t pos, double factor)
+{
+	const double prev_value = signal->get_sample(pos - 1, false).second;
+	const double value = signal->get_sample(pos, false).second;
+	return prev_value + factor * (value - prev_value);
+}
+
 void XYCurveData::on_sample_appended()
+{
+	if (suspended_)
+		return;
+
+	// Coalesce the notifications of both signals. The x/y positions are only
+	// touched within the strand.
+	if (alignment_scheduled_.exchange(true))
+		return;
+
+	strand_->post([this]() {
+		alignment_scheduled_ = false;
+		align_samples();
+	});
+}
+
+void XYCurveData::on_samples_aligned()
 {
 	lock_guard<mutex> lock(sample_append_mutex_);
 
-	shared_ptr<vector<double>> time = make_shared<vector<double>>();
-	sv::data::AnalogTimeSignal::combine_signals(
-		x_t_signal_, x_t_signal_pos_,
-		y_t_signal_, y_t_signal_pos_,
-		time, x_data_, y_data_);
+	for (const auto &point : aligned_points_) {
+		// Don't store the points, as long as both signals share the
+		// timestamps.
+		if (points_.empty() && point.factor == 0.f &&
+				point.x_pos == identity_size_ && point.y_pos == identity_size_)
+			++identity_size_;
+		else
+			points_.push_back(point);
+	}
+	aligned_points_.clear();
+}
+
+void XYCurveData::on_samples_cleared()
+{
+	// A running or pending alignment drops its points and the next
+	// alignment resets the cursor, see align_samples().
+	{
+		lock_guard<mutex> lock(sample_append_mutex_);
+		++epoch_;
+		aligned_points_.clear();
+	}
+	identity_size_ = 0;
+	points_.clear();
+	point_index_.clear();
+
+	// Align the remaining samples of the other signal.
+	this->on_sample_appended();
 }
 
 } // namespace plot
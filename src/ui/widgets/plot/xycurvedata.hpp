@@ -20,6 +20,8 @@
 #ifndef UI_WIDGETS_PLOT_XYCURVEDATA_HPP
 #define UI_WIDGETS_PLOT_XYCURVEDATA_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -33,16 +35,20 @@
 
 #include "src/data/datautil.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/xypointindex.hpp"
 
+using std::atomic;
 using std::mutex;
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::unique_ptr;
 using std::vector;
 
 namespace sv {
 
 class Session;
+class WorkerStrand;
 
 namespace data {
 class AnalogTimeSignal;
@@ -66,13 +72,20 @@ class XYCurveData : public BaseCurveData
 public:
 	XYCurveData(shared_ptr<sv::data::AnalogTimeSignal> x_t_signal,
 		shared_ptr<sv::data::AnalogTimeSignal> y_t_signal);
+	~XYCurveData();
 
 	bool is_equal(const BaseCurveData *other) const override;
 
 	QPointF sample(size_t index) const override;
 	size_t size() const override;
 	QRectF boundingRect() const override;
+	void set_suspended(bool suspended) override;
 
+	/**
+	 * Return the point closest to pos. The distances are measured relative
+	 * to the visible area of the plot, so both axes are weighted like on the
+	 * canvas. The returned distance is in the units of the data.
+	 */
 	QPointF closest_point(const QPointF &pos, double *dist) const override;
 	QString name() const override;
 	string id_prefix() const override;
@@ -97,17 +110,66 @@ public:
 		shared_ptr<sv::devices::BaseDevice> origin_device);
 
 private:
+	/**
+	 * An aligned point references the samples of the x and y signal. One of
+	 * the values can be linearly interpolated between the referenced sample
+	 * and the sample before:
+	 *
+	 * factor == 0: x = x[x_pos], y = y[y_pos]
+	 * factor > 0:  x = x[x_pos], y = y[y_pos-1] + factor * (y[y_pos]-y[y_pos-1])
+	 * factor < 0:  x = x[x_pos-1] - factor * (x[x_pos]-x[x_pos-1]), y = y[y_pos]
+	 *
+	 * The positions are stored as 32 bit values, to keep the point small.
+	 */
+	struct AlignedPoint
+	{
+		uint32_t x_pos;
+		uint32_t y_pos;
+		float factor;
+	};
+
+	/**
+	 * Advance the merge join cursor over the new samples of the x and y
+	 * signal. This runs on the session worker pool, the aligned points are
+	 * handed over to the GUI thread via samples_aligned().
+	 */
+	void align_samples();
+	static double interpolate(
+		const shared_ptr<sv::data::AnalogTimeSignal> &signal,
+		size_t pos, double factor);
+
 	shared_ptr<sv::data::AnalogTimeSignal> x_t_signal_;
 	shared_ptr<sv::data::AnalogTimeSignal> y_t_signal_;
 	size_t x_t_signal_pos_;
 	size_t y_t_signal_pos_;
-	// TODO: use some sort of AnalogSignal instead of 2 vectors?
-	shared_ptr<vector<double>> x_data_;
-	shared_ptr<vector<double>> y_data_;
+	/**
+	 * Incremented when the signals are cleared. Alignments of an older epoch
+	 * are dropped, the merge join cursor is reset for a new epoch.
+	 */
+	atomic<size_t> epoch_;
+	/** The epoch of the merge join cursor, only used within the strand. */
+	size_t cursor_epoch_;
+	/**
+	 * The number of leading points, where both signals share the timestamps.
+	 * Those points are not stored: x = x[i], y = y[i].
+	 */
+	size_t identity_size_;
+	vector<AlignedPoint> points_;
+	vector<AlignedPoint> aligned_points_;
+	/** Spatial index for closest_point(), updated when it is queried. */
+	mutable XYPointIndex point_index_;
 	mutex sample_append_mutex_;
+	unique_ptr<WorkerStrand> strand_;
+	atomic<bool> alignment_scheduled_;
+	atomic<bool> suspended_;
 
 private Q_SLOTS:
 	void on_sample_appended();
+	void on_samples_aligned();
+	void on_samples_cleared();
+
+Q_SIGNALS:
+	void samples_aligned();
 
 };
 
@@ -0,0 +1,179 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <QPointF>
+#include <qwt_series_data.h>
+
+#include "xypointindex.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+XYPointIndex::XYPointIndex(size_t block_size) :
+	block_size_(block_size > 0 ? block_size : 1),
+	indexed_size_(0),
+	size_(0)
+{
+}
+
+void XYPointIndex::update(const QwtSeriesData<QPointF> &data, size_t count)
+{
+	count = std::min(count, data.size());
+	if (count <= size_)
+		return;
+	size_ = count;
+
+	while (size_ - indexed_size_ >= block_size_) {
+		Tree tree;
+		tree.size = block_size_;
+		for (size_t i = indexed_size_; i < indexed_size_ + block_size_; ++i) {
+			if (is_finite(data.sample(i)))
+				tree.nodes.push_back(i);
+		}
+		indexed_size_ += block_size_;
+
+		// Merge the trees with the same size, like a binary counter.
+		while (!trees_.empty() && trees_.back().size == tree.size) {
+			Tree &last = trees_.back();
+			last.nodes.insert(last.nodes.end(),
+				tree.nodes.begin(), tree.nodes.end());
+			last.size += tree.size;
+			tree = std::move(last);
+			trees_.pop_back();
+		}
+		build(data, tree.nodes, 0, tree.nodes.size(), true);
+		trees_.push_back(std::move(tree));
+	}
+}
+
+void XYPointIndex::clear()
+{
+	trees_.clear();
+	indexed_size_ = 0;
+	size_ = 0;
+}
+
+size_t XYPointIndex::size() const
+{
+	return size_;
+}
+
+bool XYPointIndex::nearest(const QwtSeriesData<QPointF> &data,
+	double pos_x, double pos_y, double x_scale, double y_scale,
+	size_t &index, double &dist) const
+{
+	Query query{ data, pos_x, pos_y, x_scale, y_scale,
+		0, std::numeric_limits<double>::infinity() };
+
+	// Start with the newest points, they are likely to be close to the
+	// actual position of the curve.
+	for (size_t i = indexed_size_; i < size_; ++i) {
+		if (is_finite(data.sample(i)))
+			query.check(i);
+	}
+	for (auto it = trees_.rbegin(); it != trees_.rend(); ++it)
+		search(it->nodes, 0, it->nodes.size(), true, query);
+
+	if (std::isinf(query.dist_sqr))
+		return false;
+
+	index = query.index;
+	dist = std::sqrt(query.dist_sqr);
+	return true;
+}
+
+void XYPointIndex::Query::check(size_t i)
+{
+	const QPointF point = data.sample(i);
+	const double d_x = (point.x() - pos_x) * x_scale;
+	const double d_y = (point.y() - pos_y) * y_scale;
+	const double d = d_x * d_x + d_y * d_y;
+	if (d < dist_sqr) {
+		dist_sqr = d;
+		index = i;
+	}
+}
+
+bool XYPointIndex::is_finite(const QPointF &point)
+{
+	return std::isfinite(point.x()) && std::isfinite(point.y());
+}
+
+void XYPointIndex::build(const QwtSeriesData<QPointF> &data,
+	vector<size_t> &nodes, size_t from, size_t to, bool split_x)
+{
+	if (to - from <= 1)
+		return;
+
+	const size_t mid = from + (to - from) / 2;
+	std::nth_element(nodes.begin() + from, nodes.begin() + mid,
+		nodes.begin() + to,
+		[&data, split_x](size_t a, size_t b) {
+			return split_x ?
+				data.sample(a).x() < data.sample(b).x() :
+				data.sample(a).y() < data.sample(b).y();
+		});
+
+	build(data, nodes, from, mid, !split_x);
+	build(data, nodes, mid + 1, to, !split_x);
+}
+
+void XYPointIndex::search(const vector<size_t> &nodes,
+	size_t from, size_t to, bool split_x, Query &query)
+{
+	if (from >= to)
+		return;
+
+	const size_t mid = from + (to - from) / 2;
+	const size_t i = nodes[mid];
+	query.check(i);
+
+	const QPointF point = query.data.sample(i);
+	const double diff = split_x ?
+		(query.pos_x - point.x()) * query.x_scale :
+		(query.pos_y - point.y()) * query.y_scale;
+
+	// Search the side of the split with the position first, the other side
+	// only if it can contain a closer point.
+	if (diff < 0) {
+		search(nodes, from, mid, !split_x, query);
+		if (diff * diff < query.dist_sqr)
+			search(nodes, mid + 1, to, !split_x, query);
+	}
+	else {
+		search(nodes, mid + 1, to, !split_x, query);
+		if (diff * diff < query.dist_sqr)
+			search(nodes, from, mid, !split_x, query);
+	}
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
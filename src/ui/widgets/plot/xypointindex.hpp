@@ -0,0 +1,117 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_XYPOINTINDEX_HPP
+#define UI_WIDGETS_PLOT_XYPOINTINDEX_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <QPointF>
+#include <qwt_series_data.h>
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+/**
+ * A spatial index over the points of a XY curve, to find the point closest
+ * to a position in O(log² n).
+ *
+ * The points are indexed in blocks of k-d trees over consecutive sample
+ * ranges. Whenever two trees have the same size, they are merged, so there
+ * are at most O(log n) trees and appending is amortized O(log² n) per point.
+ * The newest points, that don't fill a block yet, are searched linearly.
+ *
+ * The index doesn't store the points itself, the curve data is passed to
+ * update() and nearest(). Non finite points are ignored.
+ */
+class XYPointIndex
+{
+
+public:
+	/**
+	 * @param[in] block_size The number of points of the smallest tree.
+	 */
+	explicit XYPointIndex(size_t block_size = 64);
+
+	/** Add the points data[size()..count-1] to the index. */
+	void update(const QwtSeriesData<QPointF> &data, size_t count);
+	void clear();
+	/** Return the number of points in the index. */
+	size_t size() const;
+
+	/**
+	 * Find the point closest to pos_x/pos_y. The distances of both axes are
+	 * multiplied with x_scale/y_scale (e.g. pixels per unit), so the
+	 * distance can be measured on the canvas.
+	 *
+	 * @param[out] index The index of the closest point.
+	 * @param[out] dist The scaled distance to the closest point.
+	 *
+	 * @return false, if the index contains no finite point.
+	 */
+	bool nearest(const QwtSeriesData<QPointF> &data,
+		double pos_x, double pos_y, double x_scale, double y_scale,
+		size_t &index, double &dist) const;
+
+private:
+	struct Tree
+	{
+		size_t size;
+		/** The point indices, ordered as implicit k-d tree. */
+		vector<size_t> nodes;
+	};
+
+	struct Query
+	{
+		const QwtSeriesData<QPointF> &data;
+		double pos_x;
+		double pos_y;
+		double x_scale;
+		double y_scale;
+		size_t index;
+		double dist_sqr;
+
+		void check(size_t i);
+	};
+
+	static bool is_finite(const QPointF &point);
+	static void build(const QwtSeriesData<QPointF> &data, vector<size_t> &nodes,
+		size_t from, size_t to, bool split_x);
+	static void search(const vector<size_t> &nodes, size_t from, size_t to,
+		bool split_x, Query &query);
+
+	const size_t block_size_;
+	/** The number of points in the trees. */
+	size_t indexed_size_;
+	size_t size_;
+	vector<Tree> trees_;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_XYPOINTINDEX_HPP
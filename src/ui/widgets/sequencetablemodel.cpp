@@ -0,0 +1,350 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QByteArray>
+#include <QDataStream>
+#include <QIODevice>
+#include <QModelIndex>
+#include <QSettings>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QtGlobal>
+
+#include "sequencetablemodel.hpp"
+#include "src/sequenceoutputengine.hpp"
+#include "src/data/waveform.hpp"
+
+using std::make_unique;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+
+namespace {
+
+const quint32 BlobVersion = 1;
+
+void write_doubles(QDataStream &stream, const vector<double> &doubles)
+{
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+	stream.writeRawData(reinterpret_cast<const char *>(doubles.data()),
+		static_cast<int>(doubles.size() * sizeof(double)));
+#else
+	for (const double d : doubles)
+		stream << d;
+#endif
+}
+
+bool read_doubles(QDataStream &stream, vector<double> &doubles, size_t count)
+{
+	doubles.resize(count);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+	const int size = static_cast<int>(count * sizeof(double));
+	if (stream.readRawData(reinterpret_cast<char *>(doubles.data()), size)
+			!= size)
+		return false;
+#else
+	for (size_t i=0; i<count; ++i)
+		stream >> doubles[i];
+#endif
+	return stream.status() == QDataStream::Ok;
+}
+
+} // namespace
+
+SequenceTableModel::SequenceTableModel(QObject *parent) :
+	QAbstractTableModel(parent)
+{
+}
+
+int SequenceTableModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return step_count();
+}
+
+int SequenceTableModel::columnCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return 2;
+}
+
+QVariant SequenceTableModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() >= step_count())
+		return QVariant();
+	if (role != Qt::DisplayRole && role != Qt::EditRole)
+		return QVariant();
+
+	if (index.column() == 0)
+		return QVariant(value(index.row()));
+	if (index.column() == 1)
+		return QVariant(delay(index.row()));
+	return QVariant();
+}
+
+bool SequenceTableModel::setData(const QModelIndex &index,
+	const QVariant &value, int role)
+{
+	if (!index.isValid() || index.row() >= step_count() || role != Qt::EditRole)
+		return false;
+
+	materialize_waveform();
+	const size_t row = static_cast<size_t>(index.row());
+	if (index.column() == 0)
+		values_[row] = value.toDouble();
+	else if (index.column() == 1)
+		delays_[row] = value.toDouble();
+	else
+		return false;
+
+	Q_EMIT dataChanged(index, index);
+	return true;
+}
+
+Qt::ItemFlags SequenceTableModel::flags(const QModelIndex &index) const
+{
+	if (!index.isValid())
+		return Qt::NoItemFlags;
+	return QAbstractTableModel::flags(index) | Qt::ItemIsEditable;
+}
+
+QVariant SequenceTableModel::headerData(int section,
+	Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+		return QAbstractTableModel::headerData(section, orientation, role);
+
+	if (section == 0)
+		return QVariant(tr("Value"));
+	if (section == 1)
+		return QVariant(tr("Delay [s]"));
+	return QVariant();
+}
+
+double SequenceTableModel::value(int row) const
+{
+	if (waveform_)
+		return waveform_->value(static_cast<size_t>(row));
+	return values_[static_cast<size_t>(row)];
+}
+
+double SequenceTableModel::delay(int row) const
+{
+	if (waveform_)
+		return waveform_->interval();
+	return delays_[static_cast<size_t>(row)];
+}
+
+void SequenceTableModel::insert_step(int row, double value, double delay)
+{
+	insert_steps(row, vector<double>{ value }, vector<double>{ delay });
+}
+
+void SequenceTableModel::insert_steps(int row, const vector<double> &values,
+	const vector<double> &delays)
+{
+	const size_t count = std::min(values.size(), delays.size());
+	if (count == 0)
+		return;
+
+	materialize_waveform();
+	row = std::max(0, std::min(row, step_count()));
+	beginInsertRows(QModelIndex(), row, row + static_cast<int>(count) - 1);
+	values_.insert(values_.begin() + row, values.begin(),
+		values.begin() + static_cast<ptrdiff_t>(count));
+	delays_.insert(delays_.begin() + row, delays.begin(),
+		delays.begin() + static_cast<ptrdiff_t>(count));
+	endInsertRows();
+}
+
+void SequenceTableModel::insert_waveform(int row,
+	const sv::data::Waveform &waveform)
+{
+	const size_t count = std::min<size_t>(
+		waveform.sample_count(), std::numeric_limits<int>::max());
+	if (count == 0)
+		return;
+
+	if (step_count() > 0) {
+		vector<double> values(count);
+		for (size_t i=0; i<count; ++i)
+			values[i] = waveform.value(i);
+		insert_steps(row, values, vector<double>(count, waveform.interval()));
+		return;
+	}
+
+	beginInsertRows(QModelIndex(), 0, static_cast<int>(count) - 1);
+	waveform_ = make_unique<sv::data::Waveform>(waveform);
+	endInsertRows();
+}
+
+void SequenceTableModel::remove_steps(int row, int count)
+{
+	if (row < 0 || count <= 0 || row + count > step_count())
+		return;
+
+	materialize_waveform();
+	beginRemoveRows(QModelIndex(), row, row + count - 1);
+	values_.erase(values_.begin() + row, values_.begin() + row + count);
+	delays_.erase(delays_.begin() + row, delays_.begin() + row + count);
+	endRemoveRows();
+}
+
+void SequenceTableModel::clear()
+{
+	beginResetModel();
+	values_.clear();
+	values_.shrink_to_fit();
+	delays_.clear();
+	delays_.shrink_to_fit();
+	waveform_.reset();
+	endResetModel();
+}
+
+vector<SequenceStep> SequenceTableModel::steps() const
+{
+	const int count = step_count();
+	vector<SequenceStep> steps;
+	steps.reserve(static_cast<size_t>(count));
+	for (int row=0; row<count; ++row)
+		steps.push_back({ value(row), delay(row) });
+	return steps;
+}
+
+void SequenceTableModel::save_settings(QSettings &settings) const
+{
+	// Remove the keys of the other formats, so they can't shadow this one.
+	settings.remove("sequence_row_count");
+	const auto groups = settings.childGroups();
+	for (const auto &group : groups) {
+		if (group.startsWith("sequence_") && group != "sequence_waveform")
+			settings.remove(group);
+	}
+	if (waveform_) {
+		settings.remove("sequence_data");
+		settings.beginGroup("sequence_waveform");
+		settings.setValue("type", QVariant(static_cast<int>(waveform_->type())));
+		settings.setValue("amplitude", QVariant(waveform_->amplitude()));
+		settings.setValue("offset", QVariant(waveform_->offset()));
+		settings.setValue("periode", QVariant(waveform_->periode()));
+		settings.setValue("interval", QVariant(waveform_->interval()));
+		settings.setValue("phi", QVariant(waveform_->phi()));
+		settings.endGroup();
+		return;
+	}
+
+	settings.remove("sequence_waveform");
+	QByteArray blob;
+	QDataStream stream(&blob, QIODevice::WriteOnly);
+	stream.setByteOrder(QDataStream::LittleEndian);
+	stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+	stream << BlobVersion << static_cast<quint64>(values_.size());
+	write_doubles(stream, values_);
+	write_doubles(stream, delays_);
+	settings.setValue("sequence_data", QVariant(blob));
+}
+
+void SequenceTableModel::restore_settings(QSettings &settings)
+{
+	beginResetModel();
+	values_.clear();
+	delays_.clear();
+	waveform_.reset();
+
+	if (settings.childGroups().contains("sequence_waveform")) {
+		settings.beginGroup("sequence_waveform");
+		waveform_ = make_unique<sv::data::Waveform>(
+			static_cast<sv::data::WaveformType>(settings.value("type").toInt()),
+			settings.value("amplitude").toDouble(),
+			settings.value("offset").toDouble(),
+			settings.value("periode").toDouble(),
+			settings.value("interval").toDouble(),
+			settings.value("phi").toDouble());
+		settings.endGroup();
+	}
+	else if (settings.contains("sequence_data")) {
+		QByteArray blob = settings.value("sequence_data").toByteArray();
+		QDataStream stream(&blob, QIODevice::ReadOnly);
+		stream.setByteOrder(QDataStream::LittleEndian);
+		stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+		quint32 version;
+		quint64 count;
+		stream >> version >> count;
+		const quint64 max_count =
+			static_cast<quint64>(blob.size()) / (2 * sizeof(double));
+		if (version != BlobVersion || count > max_count ||
+				!read_doubles(stream, values_, count) ||
+				!read_doubles(stream, delays_, count)) {
+			values_.clear();
+			delays_.clear();
+		}
+	}
+	else {
+		// Sequence saved by an older version, one group per row.
+		int row_count = settings.value("sequence_row_count").toInt();
+		values_.reserve(static_cast<size_t>(std::max(0, row_count)));
+		delays_.reserve(static_cast<size_t>(std::max(0, row_count)));
+		for (int pos=0; pos<row_count; pos++) {
+			settings.beginGroup(QString("sequence_").append(QString::number(pos)));
+			values_.push_back(settings.value("value").toDouble());
+			delays_.push_back(settings.value("delay").toDouble());
+			settings.endGroup();
+		}
+	}
+
+	endResetModel();
+}
+
+int SequenceTableModel::step_count() const
+{
+	if (waveform_) {
+		return static_cast<int>(std::min<size_t>(
+			waveform_->sample_count(), std::numeric_limits<int>::max()));
+	}
+	return static_cast<int>(values_.size());
+}
+
+void SequenceTableModel::materialize_waveform()
+{
+	if (!waveform_)
+		return;
+
+	const size_t count = static_cast<size_t>(step_count());
+	values_.resize(count);
+	delays_.assign(count, waveform_->interval());
+	for (size_t i=0; i<count; ++i)
+		values_[i] = waveform_->value(i);
+	waveform_.reset();
+}
+
+} // namespace widgets
+} // namespace ui
+} // namespace sv
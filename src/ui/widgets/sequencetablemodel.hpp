@@ -0,0 +1,108 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_SEQUENCETABLEMODEL_HPP
+#define UI_WIDGETS_SEQUENCETABLEMODEL_HPP
+
+#include <memory>
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QModelIndex>
+#include <QSettings>
+#include <QVariant>
+
+#include "src/sequenceoutputengine.hpp"
+#include "src/data/waveform.hpp"
+
+using std::unique_ptr;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+
+/**
+ * A table model for an output sequence. The first column is the value, the
+ * second column is the delay of the step.
+ *
+ * The steps are stored in packed value/delay arrays. A generated waveform is
+ * only stored by its parameters and the steps are calculated, when they are
+ * requested by the view. The waveform is converted into the arrays, when the
+ * sequence is edited.
+ */
+class SequenceTableModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+	explicit SequenceTableModel(QObject *parent = nullptr);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index,
+		int role = Qt::DisplayRole) const override;
+	bool setData(const QModelIndex &index, const QVariant &value,
+		int role = Qt::EditRole) override;
+	Qt::ItemFlags flags(const QModelIndex &index) const override;
+	QVariant headerData(int section, Qt::Orientation orientation,
+		int role = Qt::DisplayRole) const override;
+
+	double value(int row) const;
+	double delay(int row) const;
+	void insert_step(int row, double value, double delay);
+	void insert_steps(int row, const vector<double> &values,
+		const vector<double> &delays);
+	/**
+	 * Insert the samples of a waveform. If the sequence is empty, only the
+	 * waveform parameters are stored.
+	 */
+	void insert_waveform(int row, const sv::data::Waveform &waveform);
+	void remove_steps(int row, int count);
+	void clear();
+	/** Return a copy of the sequence for the SequenceOutputEngine. */
+	vector<SequenceStep> steps() const;
+
+	/**
+	 * Save the sequence as waveform parameters or as one binary blob of the
+	 * packed value/delay arrays.
+	 */
+	void save_settings(QSettings &settings) const;
+	/**
+	 * Restore the sequence. Sequences, that were saved row by row by older
+	 * versions, are also restored.
+	 */
+	void restore_settings(QSettings &settings);
+
+private:
+	int step_count() const;
+	/** Convert the waveform into the value/delay arrays. */
+	void materialize_waveform();
+
+	vector<double> values_;
+	vector<double> delays_;
+	unique_ptr<sv::data::Waveform> waveform_;
+
+};
+
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_SEQUENCETABLEMODEL_HPP
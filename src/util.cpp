@@ -19,7 +19,11 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <limits>
 #include <math.h>
 #include <sstream>
@@ -27,8 +31,8 @@
 
 #include <libsigrokcxx/libsigrokcxx.hpp>
 
-#include <QDateTime>
 #include <QDebug>
+#include <QLocale>
 #include <QTextStream>
 #include <QUuid>
 
@@ -47,30 +51,35 @@ using std::vector;
 namespace sv {
 namespace util {
 
-static QTextStream &operator<<(QTextStream &stream, SIPrefix prefix)
+const char *si_prefix_symbol(SIPrefix prefix)
 {
 	switch (prefix) {
-	case SIPrefix::yocto: return stream << 'y';
-	case SIPrefix::zepto: return stream << 'z';
-	case SIPrefix::atto:  return stream << 'a';
-	case SIPrefix::femto: return stream << 'f';
-	case SIPrefix::pico:  return stream << 'p';
-	case SIPrefix::nano:  return stream << 'n';
-	case SIPrefix::micro: return stream << QChar(0x03BC);
-	case SIPrefix::milli: return stream << 'm';
-	case SIPrefix::kilo:  return stream << 'k';
-	case SIPrefix::mega:  return stream << 'M';
-	case SIPrefix::giga:  return stream << 'G';
-	case SIPrefix::tera:  return stream << 'T';
-	case SIPrefix::peta:  return stream << 'P';
-	case SIPrefix::exa:   return stream << 'E';
-	case SIPrefix::zetta: return stream << 'Z';
-	case SIPrefix::yotta: return stream << 'Y';
-
-	default: return stream;
+	case SIPrefix::yocto: return "y";
+	case SIPrefix::zepto: return "z";
+	case SIPrefix::atto:  return "a";
+	case SIPrefix::femto: return "f";
+	case SIPrefix::pico:  return "p";
+	case SIPrefix::nano:  return "n";
+	case SIPrefix::micro: return "\xCE\xBC"; // U+03BC
+	case SIPrefix::milli: return "m";
+	case SIPrefix::kilo:  return "k";
+	case SIPrefix::mega:  return "M";
+	case SIPrefix::giga:  return "G";
+	case SIPrefix::tera:  return "T";
+	case SIPrefix::peta:  return "P";
+	case SIPrefix::exa:   return "E";
+	case SIPrefix::zetta: return "Z";
+	case SIPrefix::yotta: return "Y";
+
+	default: return "";
 	}
 }
 
+static QTextStream &operator<<(QTextStream &stream, SIPrefix prefix)
+{
+	return stream << QString::fromUtf8(si_prefix_symbol(prefix));
+}
+
 int exponent(SIPrefix prefix)
 {
 	return 3 * (static_cast<int>(prefix) - static_cast<int>(SIPrefix::none));
@@ -92,6 +101,190 @@ static SIPrefix si_prefix_from_prefix(int prefix)
 	return static_cast<SIPrefix>(static_cast<int>(SIPrefix::none) + prefix);
 }
 
+/**
+ * Returns the factor pow(10, -exponent(prefix)) to scale a value to the given
+ * SI prefix. The factors are calculated once with the same pow() calls as
+ * before, so the scaled values are bit identical.
+ */
+static double prefix_multiplier(SIPrefix prefix)
+{
+	static const auto multipliers = []() {
+		std::array<double, static_cast<size_t>(SIPrefix::yotta) + 1> m;
+		for (size_t i=0; i<m.size(); ++i)
+			m[i] = pow(10, -exponent(static_cast<SIPrefix>(i)));
+		return m;
+	}();
+	return multipliers[static_cast<size_t>(prefix)];
+}
+
+/**
+ * Check if the exact binary value of `value` lies exactly in the middle of
+ * two decimal numbers with `k` decimal places (`k` can be negative).
+ *
+ * printf() rounds these ties to even, while Qt (double-conversion) rounds
+ * them away from zero.
+ */
+static bool is_decimal_tie(const double value, const int k)
+{
+	int exp;
+	const double mantissa = frexp(fabs(value), &exp);
+	if (mantissa == 0)
+		return false;
+
+	// value = m * 2^e with an odd integer m
+	long long m = static_cast<long long>(ldexp(mantissa, 53));
+	int e = exp - 53;
+	while ((m & 1) == 0) {
+		m >>= 1;
+		++e;
+	}
+
+	// value * 10^k = m * 5^k * 2^(e+k), which is a tie when e+k == -1 and
+	// (for negative k) m is divisible by 5^-k.
+	if (e + k != -1)
+		return false;
+	if (k >= 0)
+		return true;
+	long long pow5 = 1;
+	for (int i=0; i<-k; ++i) {
+		if (pow5 > m)
+			return false;
+		pow5 *= 5;
+	}
+	return m % pow5 == 0;
+}
+
+/**
+ * Round ties away from zero like Qt does, by moving the value one ULP away
+ * from the tie before it is passed to printf().
+ */
+static double round_tie_away(const double value, const int k)
+{
+	if (!std::isfinite(value) || !is_decimal_tie(value, k))
+		return value;
+	return nextafter(value, value < 0 ?
+		-std::numeric_limits<double>::infinity() :
+		std::numeric_limits<double>::infinity());
+}
+
+/**
+ * printf() uses the decimal point of the C locale, which is set to the system
+ * locale by Qt. Replace it with a '.' in place.
+ */
+static int normalize_decimal_point(char *buffer, int length)
+{
+	auto is_number_char = [](char c) {
+		return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == 'e';
+	};
+
+	for (int i=0; i<length; ++i) {
+		if (is_number_char(buffer[i]))
+			continue;
+		if (buffer[i] == '.')
+			return length;
+
+		// The decimal point of the locale can have more than one char
+		int end = i + 1;
+		while (end < length && !is_number_char(buffer[end]))
+			++end;
+		buffer[i] = '.';
+		memmove(buffer + i + 1, buffer + end, length - end + 1);
+		return length - (end - i - 1);
+	}
+	return length;
+}
+
+/**
+ * Pad the number in the buffer with spaces to `field_width` like
+ * `QString::arg()`: Positive values right-align, negative values left-align
+ * the number.
+ */
+static int pad_field(char *buffer, size_t buffer_size, int length,
+	int field_width)
+{
+	const int width = abs(field_width);
+	if (length >= width || static_cast<size_t>(width) >= buffer_size)
+		return length;
+
+	if (field_width > 0) {
+		memmove(buffer + width - length, buffer, length + 1);
+		memset(buffer, ' ', width - length);
+	}
+	else {
+		memset(buffer + length, ' ', width - length);
+		buffer[width] = '\0';
+	}
+	return width;
+}
+
+static int print_double(char *buffer, size_t buffer_size, char format,
+	int precision, double value)
+{
+	int length;
+	if (std::isnan(value))
+		length = snprintf(buffer, buffer_size, "nan");
+	else if (format == 'f')
+		length = snprintf(buffer, buffer_size, "%.*f", precision, value);
+	else
+		length = snprintf(buffer, buffer_size, "%.*g", precision, value);
+
+	if (length < 0 || static_cast<size_t>(length) >= buffer_size ||
+			!std::isfinite(value))
+		return length;
+	return normalize_decimal_point(buffer, length);
+}
+
+/**
+ * Convert a number, that was formatted in the "C" locale, into the current
+ * locale, like `QString::arg()` does for "%L1".
+ */
+static QString localize_number(const char *buffer, int length,
+	int field_width)
+{
+	const QLocale locale;
+	const ushort zero = locale.zeroDigit().unicode();
+	const bool use_group =
+		!(locale.numberOptions() & QLocale::OmitGroupSeparator);
+
+	int int_digits = 0;
+	for (int i=0; i<length && buffer[i] != '.'; ++i) {
+		if (buffer[i] >= '0' && buffer[i] <= '9')
+			++int_digits;
+	}
+
+	QString str;
+	str.reserve(length + int_digits / 3 + 1);
+	int digit_count = 0;
+	bool fraction = false;
+	for (int i=0; i<length; ++i) {
+		const char c = buffer[i];
+		if (c >= '0' && c <= '9') {
+			str.append(QChar(static_cast<ushort>(zero + (c - '0'))));
+			if (fraction)
+				continue;
+			const int remaining = int_digits - ++digit_count;
+			if (use_group && remaining > 0 && remaining % 3 == 0)
+				str.append(locale.groupSeparator());
+		}
+		else if (c == '.') {
+			str.append(locale.decimalPoint());
+			fraction = true;
+		}
+		else if (c == '-') {
+			str.append(locale.negativeSign());
+		}
+		else {
+			str.append(QChar::fromLatin1(c));
+		}
+	}
+
+	if (field_width > 0)
+		return str.rightJustified(field_width, QChar(' '));
+	if (field_width < 0)
+		return str.leftJustified(-field_width, QChar(' '));
+	return str;
+}
+
 // Insert the timestamp value into the stream in fixed-point notation
 // (and honor the precision)
 static QTextStream &operator<<(QTextStream &stream, const Timestamp &timestamp)
@@ -155,60 +348,123 @@ int decimal_places_from_prefix(const int prefix, const int sr_digits)
 	return decimal_places;
 }
 
-void format_value_si(
+int format_double_fixed(char *buffer, size_t buffer_size,
+	const double value, const int decimal_places, const int field_width)
+{
+	// A negative precision means 6 decimal places, like in printf() and Qt.
+	const int k = decimal_places < 0 ? 6 : decimal_places;
+	const int length = print_double(buffer, buffer_size, 'f', decimal_places,
+		round_tie_away(value, k));
+	return pad_field(buffer, buffer_size, length, field_width);
+}
+
+int format_double_general(char *buffer, size_t buffer_size,
+	const double value, const int precision)
+{
+	int digits = precision < 0 ? 6 : precision;
+	if (digits == 0)
+		digits = 1;
+
+	double rounded = value;
+	if (std::isfinite(value) && value != 0) {
+		// The decimal exponent of the (unrounded) value
+		const double abs_value = fabs(value);
+		int exp10 = static_cast<int>(floor(log10(abs_value)));
+		if (abs_value < pow(10, exp10))
+			--exp10;
+		else if (abs_value >= pow(10, exp10 + 1))
+			++exp10;
+		rounded = round_tie_away(value, digits - 1 - exp10);
+	}
+
+	return print_double(buffer, buffer_size, 'g', digits, rounded);
+}
+
+int format_value_si(char *buffer, size_t buffer_size,
 	const double value, const int total_digits, const int sr_digits,
-	QString &value_str, QString &si_prefix_str, const bool use_locale)
+	const char *&si_prefix)
 {
 	int prefix = prefix_from_value(value, sr_digits);
-	SIPrefix si_prefix = si_prefix_from_prefix(prefix);
-	assert(si_prefix >= SIPrefix::yocto);
-	assert(si_prefix <= SIPrefix::yotta);
+	SIPrefix si_prefix_enum = si_prefix_from_prefix(prefix);
+	assert(si_prefix_enum >= SIPrefix::yocto);
+	assert(si_prefix_enum <= SIPrefix::yotta);
 
 	int decimal_places = decimal_places_from_prefix(prefix, sr_digits);
 
-	double new_value = value * pow(10, -3 * prefix);
-
-	// Check if, use current locale (%L) for formating.
-	QString format_string = use_locale ? "%L1" : "%1";
-	value_str = QString(format_string)
-		.arg(new_value, total_digits, 'f', decimal_places, QChar(' '));
-
-	QTextStream si_prefix_stream(&si_prefix_str);
-	si_prefix_stream << si_prefix;
+	si_prefix = si_prefix_symbol(si_prefix_enum);
+	return format_double_fixed(buffer, buffer_size,
+		value * prefix_multiplier(si_prefix_enum), decimal_places, total_digits);
 }
 
-void format_value_si_autoscale(
+int format_value_si_autoscale(char *buffer, size_t buffer_size,
 	const double value, const int total_digits, const int decimal_places,
-	QString &value_str, QString &si_prefix_str, const bool use_locale)
+	const char *&si_prefix)
 {
-	SIPrefix si_prefix;
+	SIPrefix si_prefix_enum;
 	if (value == 0 || value == NAN ||
 			value == std::numeric_limits<double>::infinity() ||
 			value >= std::numeric_limits<double>::max() ||
 			value <= std::numeric_limits<double>::lowest()) {
-		si_prefix = SIPrefix::none;
+		si_prefix_enum = SIPrefix::none;
 	}
 	else {
-		int exp = exponent(SIPrefix::yotta);
-		si_prefix = SIPrefix::yocto;
-		while ((fabs(value) * pow(10, exp)) > 999 &&
-				si_prefix < SIPrefix::yotta) {
-			si_prefix = successor(si_prefix);
-			exp -= 3;
+		si_prefix_enum = SIPrefix::yocto;
+		while ((fabs(value) * prefix_multiplier(si_prefix_enum)) > 999 &&
+				si_prefix_enum < SIPrefix::yotta) {
+			si_prefix_enum = successor(si_prefix_enum);
 		}
 	}
-	assert(si_prefix >= SIPrefix::yocto);
-	assert(si_prefix <= SIPrefix::yotta);
+	assert(si_prefix_enum >= SIPrefix::yocto);
+	assert(si_prefix_enum <= SIPrefix::yotta);
 
-	const double multiplier = pow(10, -exponent(si_prefix));
+	si_prefix = si_prefix_symbol(si_prefix_enum);
+	return format_double_fixed(buffer, buffer_size,
+		value * prefix_multiplier(si_prefix_enum), decimal_places, total_digits);
+}
+
+void format_value_si(
+	const double value, const int total_digits, const int sr_digits,
+	QString &value_str, QString &si_prefix_str, const bool use_locale)
+{
+	char buffer[FormatBufferSize];
+	const char *si_prefix;
+
+	// Check if, use current locale (%L) for formating. The locale version is
+	// padded after the conversion, because of the group separators.
+	if (use_locale) {
+		const int length = format_value_si(buffer, sizeof(buffer),
+			value, 0, sr_digits, si_prefix);
+		value_str = localize_number(buffer, length, total_digits);
+	}
+	else {
+		const int length = format_value_si(buffer, sizeof(buffer),
+			value, total_digits, sr_digits, si_prefix);
+		value_str = QString::fromLatin1(buffer, length);
+	}
+
+	si_prefix_str.append(QString::fromUtf8(si_prefix));
+}
+
+void format_value_si_autoscale(
+	const double value, const int total_digits, const int decimal_places,
+	QString &value_str, QString &si_prefix_str, const bool use_locale)
+{
+	char buffer[FormatBufferSize];
+	const char *si_prefix;
 
 	// Check if, use current locale (%L) for formating.
-	QString format_string = use_locale ? "%L1" : "%1";
-	value_str = QString(format_string).
-		arg(value * multiplier, total_digits, 'f', decimal_places, QChar(' '));
+	if (use_locale) {
+		const int length = format_value_si_autoscale(buffer, sizeof(buffer),
+			value, 0, decimal_places, si_prefix);
+		value_str = localize_number(buffer, length, total_digits);
+	}
+	else {
+		const int length = format_value_si_autoscale(buffer, sizeof(buffer),
+			value, total_digits, decimal_places, si_prefix);
+		value_str = QString::fromLatin1(buffer, length);
+	}
 
-	QTextStream si_prefix_stream(&si_prefix_str);
-	si_prefix_stream << si_prefix;
+	si_prefix_str.append(QString::fromUtf8(si_prefix));
 }
 
 QString format_time_si(const Timestamp &timestamp, SIPrefix prefix,
@@ -328,9 +584,46 @@ QString format_time_minutes(const Timestamp &timestamp, signed precision,
 
 QString format_time_date(double timestamp)
 {
-	QDateTime date;
-	date.setMSecsSinceEpoch(static_cast<qint64>(timestamp * 1000));
-	return date.toString("yyyy.MM.dd hh:mm:ss.zzz");
+	char buffer[FormatBufferSize];
+	const int length = format_time_date(buffer, sizeof(buffer), timestamp);
+	return QString::fromLatin1(buffer, length);
+}
+
+int format_time_date(char *buffer, size_t buffer_size, double timestamp)
+{
+	// Same as QDateTime::setMSecsSinceEpoch() and the format
+	// "yyyy.MM.dd hh:mm:ss.zzz" in the local time zone.
+	const qint64 msecs = static_cast<qint64>(timestamp * 1000);
+	qint64 secs = msecs / 1000;
+	int msec = static_cast<int>(msecs % 1000);
+	if (msec < 0) {
+		msec += 1000;
+		--secs;
+	}
+
+	// The conversion into the local time is the expensive part. Consecutive
+	// timestamps are mostly in the same second, so cache the last conversion.
+	thread_local bool cached = false;
+	thread_local time_t cached_secs = 0;
+	thread_local struct tm cached_tm;
+	const time_t t = static_cast<time_t>(secs);
+	if (!cached || t != cached_secs) {
+#ifdef _WIN32
+		cached = localtime_s(&cached_tm, &t) == 0;
+#else
+		cached = localtime_r(&t, &cached_tm) != nullptr;
+#endif
+		cached_secs = t;
+	}
+	if (!cached) {
+		if (buffer_size > 0)
+			buffer[0] = '\0';
+		return 0;
+	}
+
+	return snprintf(buffer, buffer_size, "%04d.%02d.%02d %02d:%02d:%02d.%03d",
+		cached_tm.tm_year + 1900, cached_tm.tm_mon + 1, cached_tm.tm_mday,
+		cached_tm.tm_hour, cached_tm.tm_min, cached_tm.tm_sec, msec);
 }
 
 string format_uuid(QUuid uuid)
@@ -117,6 +117,60 @@ void format_value_si_autoscale(
 	const double value, const int total_digits, const int decimal_places,
 	QString &value_str, QString &si_prefix_str, const bool use_locale = true);
 
+/**
+ * The buffer size, that is sufficient for all the formatting functions below,
+ * that write into a caller provided buffer.
+ */
+const size_t FormatBufferSize = 512;
+
+/**
+ * Returns the symbol of the SI prefix as UTF-8 string ("" for no prefix).
+ */
+const char *si_prefix_symbol(SIPrefix prefix);
+
+/**
+ * Formats a double value in fixed-point notation into the caller provided
+ * `buffer`, without any allocation. The output is the same as
+ * `QString("%1").arg(value, field_width, 'f', decimal_places)`, independent
+ * of the C locale.
+ *
+ * @return The number of chars written, without the terminating null char.
+ */
+int format_double_fixed(char *buffer, size_t buffer_size,
+	const double value, const int decimal_places, const int field_width = 0);
+
+/**
+ * Formats a double value with `precision` significant digits like
+ * `QString("%1").arg(value, 0, 'g', precision)` into the caller provided
+ * `buffer`, without any allocation.
+ *
+ * @return The number of chars written, without the terminating null char.
+ */
+int format_double_general(char *buffer, size_t buffer_size,
+	const double value, const int precision = 6);
+
+/**
+ * Allocation free variant of `format_value_si()`. The digits are written into
+ * the caller provided `buffer` using the "C" locale, `si_prefix` is set to
+ * the UTF-8 symbol of the SI prefix.
+ *
+ * @return The number of chars written, without the terminating null char.
+ */
+int format_value_si(char *buffer, size_t buffer_size,
+	const double value, const int total_digits, const int sr_digits,
+	const char *&si_prefix);
+
+/**
+ * Allocation free variant of `format_value_si_autoscale()`. The digits are
+ * written into the caller provided `buffer` using the "C" locale,
+ * `si_prefix` is set to the UTF-8 symbol of the SI prefix.
+ *
+ * @return The number of chars written, without the terminating null char.
+ */
+int format_value_si_autoscale(char *buffer, size_t buffer_size,
+	const double value, const int total_digits, const int decimal_places,
+	const char *&si_prefix);
+
 /**
  * Formats a given timestamp with the specified SI prefix.
  *
@@ -195,6 +249,14 @@ QString format_time_minutes(const Timestamp& timestamp, signed precision = 0,
  */
 QString format_time_date(double timestamp);
 
+/**
+ * Allocation free variant of `format_time_date()`, that writes the date into
+ * the caller provided `buffer`.
+ *
+ * @return The number of chars written, without the terminating null char.
+ */
+int format_time_date(char *buffer, size_t buffer_size, double timestamp);
+
 /**
  * Format the given UUID as a string without braches.
  *
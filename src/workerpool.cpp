@@ -0,0 +1,240 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <QDebug>
+
+#include "workerpool.hpp"
+
+using std::lock_guard;
+using std::make_shared;
+using std::make_unique;
+using std::unique_lock;
+
+namespace sv {
+
+namespace {
+
+// The pool and the queue index of the actual worker thread. Used to queue
+// tasks, that are submitted from within a worker, into the workers own queue.
+thread_local WorkerPool *current_pool = nullptr;
+thread_local unsigned int current_queue_index = 0;
+
+} // namespace
+
+WorkerPool::WorkerPool(unsigned int thread_count) :
+	queued_task_count_(0),
+	next_queue_(0),
+	stop_(false)
+{
+	if (thread_count == 0) {
+		// Leave one hardware thread for the GUI.
+		unsigned int hw_threads = std::thread::hardware_concurrency();
+		thread_count = hw_threads > 2 ? hw_threads - 1 : 1;
+	}
+
+	for (unsigned int i=0; i<thread_count; ++i)
+		queues_.push_back(make_unique<WorkQueue>());
+	for (unsigned int i=0; i<thread_count; ++i)
+		threads_.emplace_back(&WorkerPool::run, this, i);
+
+	qDebug() << "WorkerPool::WorkerPool(): Started" << thread_count <<
+		"worker threads";
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		lock_guard<mutex> lock(wait_mutex_);
+		stop_ = true;
+	}
+	wait_cv_.notify_all();
+
+	for (auto &thread : threads_) {
+		if (thread.joinable())
+			thread.join();
+	}
+}
+
+unsigned int WorkerPool::thread_count() const
+{
+	return static_cast<unsigned int>(threads_.size());
+}
+
+void WorkerPool::submit(worker_task_t task)
+{
+	unsigned int index;
+	if (current_pool == this)
+		index = current_queue_index;
+	else
+		index = next_queue_++ % queues_.size();
+
+	{
+		lock_guard<mutex> lock(queues_[index]->queue_mutex);
+		queues_[index]->tasks.push_back(std::move(task));
+	}
+	{
+		// Lock the wait mutex, so no worker misses the notification between
+		// checking the task count and going to sleep.
+		lock_guard<mutex> lock(wait_mutex_);
+		++queued_task_count_;
+	}
+	wait_cv_.notify_one();
+}
+
+bool WorkerPool::pop_task(unsigned int index, worker_task_t &task)
+{
+	// Take the newest task from the own queue first (still hot in the cache),
+	// then steal the oldest task from the other queues.
+	{
+		lock_guard<mutex> lock(queues_[index]->queue_mutex);
+		if (!queues_[index]->tasks.empty()) {
+			task = std::move(queues_[index]->tasks.back());
+			queues_[index]->tasks.pop_back();
+			--queued_task_count_;
+			return true;
+		}
+	}
+
+	const size_t queue_count = queues_.size();
+	for (size_t i=1; i<queue_count; ++i) {
+		auto &queue = queues_[(index + i) % queue_count];
+		lock_guard<mutex> lock(queue->queue_mutex);
+		if (!queue->tasks.empty()) {
+			task = std::move(queue->tasks.front());
+			queue->tasks.pop_front();
+			--queued_task_count_;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void WorkerPool::run(unsigned int index)
+{
+	current_pool = this;
+	current_queue_index = index;
+
+	worker_task_t task;
+	while (true) {
+		if (pop_task(index, task)) {
+			task();
+			task = nullptr;
+			continue;
+		}
+
+		unique_lock<mutex> lock(wait_mutex_);
+		wait_cv_.wait(lock, [this] {
+			return stop_ || queued_task_count_ > 0;
+		});
+		// Finish all queued tasks before the pool is stopped.
+		if (stop_ && queued_task_count_ == 0)
+			break;
+	}
+
+	current_pool = nullptr;
+}
+
+
+WorkerStrand::WorkerStrand(shared_ptr<WorkerPool> pool) :
+	state_(make_shared<State>())
+{
+	state_->pool = pool;
+}
+
+WorkerStrand::~WorkerStrand()
+{
+	close();
+}
+
+void WorkerStrand::post(worker_task_t task)
+{
+	if (!state_->pool) {
+		task();
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(state_->strand_mutex);
+		if (state_->closed)
+			return;
+		state_->tasks.push_back(std::move(task));
+		if (state_->scheduled)
+			return;
+		state_->scheduled = true;
+	}
+	schedule(state_);
+}
+
+void WorkerStrand::close()
+{
+	unique_lock<mutex> lock(state_->strand_mutex);
+	state_->closed = true;
+	state_->tasks.clear();
+	// The queued run_next() only holds the state and returns immediately.
+	if (state_->running &&
+			state_->running_thread != std::this_thread::get_id()) {
+		state_->idle_cv.wait(lock, [this] { return !state_->running; });
+	}
+}
+
+void WorkerStrand::schedule(const shared_ptr<State> &state)
+{
+	state->pool->submit([state]() { run_next(state); });
+}
+
+void WorkerStrand::run_next(const shared_ptr<State> &state)
+{
+	worker_task_t task;
+	{
+		lock_guard<mutex> lock(state->strand_mutex);
+		if (state->closed || state->tasks.empty()) {
+			state->scheduled = false;
+			return;
+		}
+		task = std::move(state->tasks.front());
+		state->tasks.pop_front();
+		state->running = true;
+		state->running_thread = std::this_thread::get_id();
+	}
+
+	task();
+	// Destroy the captures of the task, before the strand may be closed.
+	task = nullptr;
+
+	{
+		lock_guard<mutex> lock(state->strand_mutex);
+		state->running = false;
+		state->running_thread = std::thread::id();
+		state->idle_cv.notify_all();
+		if (state->closed || state->tasks.empty()) {
+			state->scheduled = false;
+			return;
+		}
+	}
+	// Re-submit instead of looping, so other strands get their turn.
+	schedule(state);
+}
+
+} // namespace sv
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::atomic;
+using std::condition_variable;
+using std::deque;
+using std::function;
+using std::mutex;
+using std::shared_ptr;
+using std::unique_ptr;
+using std::vector;
+
+namespace sv {
+
+typedef function<void()> worker_task_t;
+
+/**
+ * A work stealing thread pool. Every worker thread has its own task queue.
+ * Tasks submitted from a worker thread are queued in the queue of this
+ * worker, all other tasks are distributed round robin. Idle workers steal
+ * tasks from the other queues.
+ *
+ * There is no ordering between tasks, use a WorkerStrand for that.
+ */
+class WorkerPool
+{
+
+public:
+	/**
+	 * Create a new worker pool.
+	 *
+	 * @param[in] thread_count The number of worker threads. If 0, one thread
+	 *                         per hardware thread (minus the GUI thread) is
+	 *                         created.
+	 */
+	explicit WorkerPool(unsigned int thread_count = 0);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool &) = delete;
+	WorkerPool &operator=(const WorkerPool &) = delete;
+
+	/** Return the number of worker threads. */
+	unsigned int thread_count() const;
+
+	/** Queue a task for execution on one of the worker threads. */
+	void submit(worker_task_t task);
+
+private:
+	struct WorkQueue
+	{
+		mutex queue_mutex;
+		deque<worker_task_t> tasks;
+	};
+
+	void run(unsigned int index);
+	bool pop_task(unsigned int index, worker_task_t &task);
+
+	vector<unique_ptr<WorkQueue>> queues_;
+	vector<std::thread> threads_;
+	atomic<size_t> queued_task_count_;
+	atomic<unsigned int> next_queue_;
+	mutex wait_mutex_;
+	condition_variable wait_cv_;
+	bool stop_;
+
+};
+
+/**
+ * A WorkerStrand runs its tasks on a WorkerPool one after another, in the
+ * order they were posted. Different strands run in parallel. Use one strand
+ * per object, whose state must not be accessed concurrently (e.g. a math
+ * channel or a XY curve).
+ *
+ * If no pool is given, all tasks are executed immediately in the calling
+ * thread.
+ */
+class WorkerStrand
+{
+
+public:
+	explicit WorkerStrand(shared_ptr<WorkerPool> pool);
+	~WorkerStrand();
+
+	WorkerStrand(const WorkerStrand &) = delete;
+	WorkerStrand &operator=(const WorkerStrand &) = delete;
+
+	/** Queue a task at the end of this strand. */
+	void post(worker_task_t task);
+
+	/**
+	 * Drop all pending tasks. No more tasks are accepted after the strand
+	 * was closed.
+	 *
+	 * Only if a task of this strand is running in another thread right now,
+	 * this waits until the task has finished, because the task may still
+	 * access the object the strand belongs to. Queued tasks of the pool are
+	 * not waited for, and there is no waiting when the strand is closed from
+	 * within its own task.
+	 *
+	 * This must be called in the destructor of the object the tasks are
+	 * working on.
+	 */
+	void close();
+
+private:
+	/**
+	 * The state of the strand is shared with the task in the pool queue, so
+	 * the strand can be destroyed before the pool runs the task.
+	 */
+	struct State
+	{
+		shared_ptr<WorkerPool> pool;
+		mutex strand_mutex;
+		condition_variable idle_cv;
+		deque<worker_task_t> tasks;
+		bool scheduled = false;
+		bool closed = false;
+		bool running = false;
+		std::thread::id running_thread;
+	};
+
+	static void schedule(const shared_ptr<State> &state);
+	static void run_next(const shared_ptr<State> &state);
+
+	shared_ptr<State> state_;
+
+};
+
+} // namespace sv
+
+#endif // WORKERPOOL_HPP
@@ -0,0 +1,242 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/mergedtimestampindex.hpp"
+#include "test/test.hpp"
+
+using std::make_shared;
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+using sv::data::AnalogTimeSignal;
+using sv::data::MergedTimestampIndex;
+using Interpolation = sv::data::MergedTimestampIndex::Interpolation;
+
+namespace {
+	shared_ptr<AnalogTimeSignal> create_signal(const string &name)
+	{
+		// A signal with a custom name doesn't need a parent channel.
+		return make_shared<AnalogTimeSignal>(sv::data::Quantity::Voltage,
+			set<sv::data::QuantityFlag>(), sv::data::Unit::Volt, nullptr, 0.,
+			name);
+	}
+
+	void push(const shared_ptr<AnalogTimeSignal> &signal,
+		double timestamp, double value)
+	{
+		signal->push_sample(&value, timestamp, sizeof(double), 7, 3);
+	}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(MergedTimestampIndexTest)
+
+BOOST_AUTO_TEST_CASE(tolerance_grouping_test)
+{
+	auto signal_a = create_signal("A");
+	auto signal_b = create_signal("B");
+	push(signal_a, 1.0, 1.);
+	push(signal_a, 2.0, 2.);
+	push(signal_b, 1.05, 3.);
+	push(signal_b, 2.2, 4.);
+
+	MergedTimestampIndex exact_index(0.);
+	exact_index.add_signal(signal_a);
+	exact_index.add_signal(signal_b);
+	BOOST_CHECK(exact_index.update());
+	BOOST_CHECK_EQUAL(exact_index.row_count(), 4);
+
+	MergedTimestampIndex index(0.1);
+	index.add_signal(signal_a);
+	index.add_signal(signal_b);
+	BOOST_CHECK(index.update());
+	BOOST_CHECK(!index.update());
+	BOOST_REQUIRE_EQUAL(index.row_count(), 3);
+
+	// 1.0 and 1.05 are within the tolerance, 2.2 is not.
+	size_t pos;
+	BOOST_CHECK_EQUAL(index.row_timestamp(0), 1.0);
+	BOOST_CHECK(index.sample_pos(0, 0, pos));
+	BOOST_CHECK_EQUAL(pos, 0);
+	BOOST_CHECK(index.sample_pos(0, 1, pos));
+	BOOST_CHECK_EQUAL(pos, 0);
+
+	BOOST_CHECK_EQUAL(index.row_timestamp(1), 2.0);
+	BOOST_CHECK(index.sample_pos(1, 0, pos));
+	BOOST_CHECK_EQUAL(pos, 1);
+	BOOST_CHECK(!index.sample_pos(1, 1, pos));
+
+	BOOST_CHECK_EQUAL(index.row_timestamp(2), 2.2);
+	BOOST_CHECK(!index.sample_pos(2, 0, pos));
+	BOOST_CHECK(index.sample_pos(2, 1, pos));
+	BOOST_CHECK_EQUAL(pos, 1);
+}
+
+BOOST_AUTO_TEST_CASE(one_sample_per_signal_test)
+{
+	auto signal_a = create_signal("A");
+	auto signal_b = create_signal("B");
+	push(signal_a, 1.0, 1.);
+	push(signal_a, 1.1, 2.);
+	push(signal_a, 1.2, 3.);
+	push(signal_b, 1.05, 4.);
+
+	// All samples are within the tolerance, but a signal can only have one
+	// sample per row.
+	MergedTimestampIndex index(1.);
+	index.add_signal(signal_a);
+	index.add_signal(signal_b);
+	index.update();
+	BOOST_REQUIRE_EQUAL(index.row_count(), 3);
+
+	size_t pos;
+	for (size_t row=0; row<3; ++row) {
+		BOOST_CHECK(index.sample_pos(row, 0, pos));
+		BOOST_CHECK_EQUAL(pos, row);
+	}
+	BOOST_CHECK(index.sample_pos(0, 1, pos));
+	BOOST_CHECK_EQUAL(pos, 0);
+	BOOST_CHECK(!index.sample_pos(1, 1, pos));
+	BOOST_CHECK(!index.sample_pos(2, 1, pos));
+	BOOST_CHECK_EQUAL(index.row_timestamp(1), 1.1);
+	BOOST_CHECK_EQUAL(index.row_timestamp(2), 1.2);
+}
+
+BOOST_AUTO_TEST_CASE(out_of_order_test)
+{
+	auto signal_a = create_signal("A");
+	auto signal_b = create_signal("B");
+	push(signal_a, 1.0, 1.);
+	push(signal_a, 3.0, 2.);
+
+	MergedTimestampIndex index(0.);
+	index.add_signal(signal_a);
+	index.add_signal(signal_b);
+	index.update();
+	BOOST_REQUIRE_EQUAL(index.row_count(), 2);
+
+	// The sample of B is older than the last row, it is appended as new row
+	// and the existing rows are not reordered.
+	push(signal_b, 2.0, 3.);
+	BOOST_CHECK(index.update());
+	BOOST_REQUIRE_EQUAL(index.row_count(), 3);
+	BOOST_CHECK_EQUAL(index.row_timestamp(0), 1.0);
+	BOOST_CHECK_EQUAL(index.row_timestamp(1), 3.0);
+	BOOST_CHECK_EQUAL(index.row_timestamp(2), 2.0);
+
+	size_t pos;
+	BOOST_CHECK(!index.sample_pos(2, 0, pos));
+	BOOST_CHECK(index.sample_pos(2, 1, pos));
+	BOOST_CHECK_EQUAL(pos, 0);
+}
+
+BOOST_AUTO_TEST_CASE(checkpoint_boundaries_test)
+{
+	// Signal A has a sample in every row, signal B in every second row.
+	auto signal_a = create_signal("A");
+	auto signal_b = create_signal("B");
+	MergedTimestampIndex index(0.);
+	index.add_signal(signal_a);
+	index.add_signal(signal_b);
+
+	// Update in chunks, so the checkpoints are added incrementally.
+	const size_t row_count = 600;
+	for (size_t i=0; i<row_count; ++i) {
+		push(signal_a, (double)i, (double)i);
+		if (i % 2 == 0)
+			push(signal_b, (double)i, (double)i);
+		if (i % 100 == 99)
+			index.update();
+	}
+	BOOST_REQUIRE_EQUAL(index.row_count(), row_count);
+
+	size_t pos;
+	for (size_t row=0; row<row_count; ++row) {
+		BOOST_CHECK(index.sample_pos(row, 0, pos));
+		BOOST_CHECK_EQUAL(pos, row);
+		if (row % 2 == 0) {
+			BOOST_CHECK(index.sample_pos(row, 1, pos));
+			BOOST_CHECK_EQUAL(pos, row / 2);
+		}
+		else {
+			BOOST_CHECK(!index.sample_pos(row, 1, pos));
+		}
+	}
+
+	// The rows around the checkpoints at 256 and 512.
+	for (const size_t row : { 255, 256, 257, 511, 512, 513 }) {
+		BOOST_CHECK(index.sample_pos(row, 0, pos));
+		BOOST_CHECK_EQUAL(pos, row);
+		BOOST_CHECK_EQUAL(index.row_timestamp(row), (double)row);
+	}
+	BOOST_CHECK(!index.sample_pos(row_count, 0, pos));
+}
+
+BOOST_AUTO_TEST_CASE(interpolated_values_test)
+{
+	auto signal_a = create_signal("A");
+	auto signal_b = create_signal("B");
+	push(signal_a, 1.0, 10.);
+	push(signal_a, 2.0, 20.);
+	push(signal_a, 3.0, 30.);
+	push(signal_b, 1.5, 5.);
+	push(signal_b, 2.5, 7.);
+
+	MergedTimestampIndex index(0.);
+	index.add_signal(signal_a);
+	index.add_signal(signal_b);
+	index.update();
+	BOOST_REQUIRE_EQUAL(index.row_count(), 5);
+
+	vector<double> values;
+	// B has no sample before 1.0
+	BOOST_CHECK(index.interpolated_values(0, values) ==
+		Interpolation::NoPreviousSample);
+
+	BOOST_CHECK(index.interpolated_values(1, values) == Interpolation::Ok);
+	BOOST_REQUIRE_EQUAL(values.size(), 2);
+	BOOST_CHECK_CLOSE(values[0], 15., 1e-9);
+	BOOST_CHECK_EQUAL(values[1], 5.);
+
+	BOOST_CHECK(index.interpolated_values(2, values) == Interpolation::Ok);
+	BOOST_CHECK_EQUAL(values[0], 20.);
+	BOOST_CHECK_CLOSE(values[1], 6., 1e-9);
+
+	// B has no sample after 3.0 yet
+	BOOST_CHECK(index.interpolated_values(4, values) ==
+		Interpolation::NoNextSample);
+	BOOST_CHECK(index.interpolated_values(5, values) ==
+		Interpolation::NoNextSample);
+
+	push(signal_b, 3.5, 9.);
+	index.update();
+	BOOST_CHECK(index.interpolated_values(4, values) == Interpolation::Ok);
+	BOOST_CHECK_EQUAL(values[0], 30.);
+	BOOST_CHECK_CLOSE(values[1], 8., 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
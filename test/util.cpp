@@ -19,8 +19,12 @@
 
 #include <limits>
 #include <math.h>
+#include <string>
 #include <boost/test/unit_test.hpp>
 
+#include <QLocale>
+#include <QString>
+
 #include "src/util.hpp"
 #include "test/test.hpp"
 
@@ -573,6 +577,158 @@ BOOST_AUTO_TEST_CASE(format_value_si_autoscale_test)
 	BOOST_CHECK_EQUAL(si_prefix_str, mu);
 }
 
+BOOST_AUTO_TEST_CASE(format_value_si_buffer_test)
+{
+	char buffer[FormatBufferSize];
+	const char *si_prefix;
+	int length;
+
+	// The buffer variants must produce the same output as the QString variants
+
+	length = format_value_si(buffer, sizeof(buffer),
+		4635000000., -1, -6, si_prefix);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "4.635");
+	BOOST_CHECK_EQUAL(std::string(si_prefix), "G");
+
+	length = format_value_si(buffer, sizeof(buffer),
+		.0004635, -1, 7, si_prefix);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "463.5");
+	BOOST_CHECK_EQUAL(QString::fromUtf8(si_prefix), mu);
+
+	length = format_value_si(buffer, sizeof(buffer),
+		1234e25, -1, -25, si_prefix);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "12340");
+	BOOST_CHECK_EQUAL(std::string(si_prefix), "Y");
+
+	length = format_value_si(buffer, sizeof(buffer),
+		0, -1, 4, si_prefix);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "0.0000");
+	BOOST_CHECK_EQUAL(std::string(si_prefix), "");
+
+	length = format_value_si(buffer, sizeof(buffer),
+		std::numeric_limits<double>::infinity(), -1, 4, si_prefix);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "inf");
+
+	length = format_value_si(buffer, sizeof(buffer),
+		0.123456, -1, 7, si_prefix);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "123.4560");
+	BOOST_CHECK_EQUAL(std::string(si_prefix), "m");
+
+	length = format_value_si_autoscale(buffer, sizeof(buffer),
+		463500000., -1, 3, si_prefix);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "463.500");
+	BOOST_CHECK_EQUAL(std::string(si_prefix), "M");
+
+	length = format_value_si_autoscale(buffer, sizeof(buffer),
+		0.000123, -1, 2, si_prefix);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "123.00");
+	BOOST_CHECK_EQUAL(QString::fromUtf8(si_prefix), mu);
+
+	/* Field width */
+
+	length = format_value_si(buffer, sizeof(buffer),
+		-0.123456, 8, 5, si_prefix);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), " -123.46");
+
+	length = format_value_si(buffer, sizeof(buffer),
+		-0.123456, -9, 5, si_prefix);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "-123.46  ");
+
+	/* Compare with QString::arg(), which was used before */
+
+	// The values include exact ties (x.xx5), which Qt rounds away from zero.
+	const auto values = { 1.5e-9, -0.125, 0.0625, 1.375, 2.5, 3.3, 12.0,
+		999.9995, 1234.5, 4.2e7, 1234e25 };
+	QString value_str;
+	QString si_prefix_str;
+	for (const double value : values) {
+		for (int sr_digits = -3; sr_digits <= 9; ++sr_digits) {
+			const int prefix = prefix_from_value(value, sr_digits);
+			const int decimal_places =
+				decimal_places_from_prefix(prefix, sr_digits);
+			const double new_value = value * pow(10, -3 * prefix);
+
+			length = format_value_si(buffer, sizeof(buffer),
+				value, 7, sr_digits, si_prefix);
+			BOOST_CHECK_EQUAL(QString::fromLatin1(buffer, length),
+				QString("%1").arg(
+					new_value, 7, 'f', decimal_places, QChar(' ')));
+
+			format_value_si(value, 7, sr_digits, value_str, si_prefix_str,
+				false);
+			BOOST_CHECK_EQUAL(value_str, QString("%1").arg(
+				new_value, 7, 'f', decimal_places, QChar(' ')));
+		}
+	}
+
+	// The locale variant with group separators and a decimal comma
+	const QLocale default_locale;
+	QLocale::setDefault(QLocale(QLocale::German, QLocale::Germany));
+	for (const double value : values) {
+		for (int sr_digits = -3; sr_digits <= 9; ++sr_digits) {
+			const int prefix = prefix_from_value(value, sr_digits);
+			const int decimal_places =
+				decimal_places_from_prefix(prefix, sr_digits);
+			const double new_value = value * pow(10, -3 * prefix);
+
+			format_value_si(value, 7, sr_digits, value_str, si_prefix_str,
+				true);
+			BOOST_CHECK_EQUAL(value_str, QString("%L1").arg(
+				new_value, 7, 'f', decimal_places, QChar(' ')));
+			format_value_si(value, -12, sr_digits, value_str, si_prefix_str,
+				true);
+			BOOST_CHECK_EQUAL(value_str, QString("%L1").arg(
+				new_value, -12, 'f', decimal_places, QChar(' ')));
+		}
+	}
+	QLocale::setDefault(default_locale);
+}
+
+BOOST_AUTO_TEST_CASE(format_double_test)
+{
+	char buffer[FormatBufferSize];
+	int length;
+
+	length = format_double_fixed(buffer, sizeof(buffer), 1.0/3, 4);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "0.3333");
+
+	length = format_double_fixed(buffer, sizeof(buffer), 123.5, 0, 6);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "   124");
+
+	// Exact ties are rounded away from zero like in Qt, not to even.
+	length = format_double_fixed(buffer, sizeof(buffer), 0.125, 2);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "0.13");
+	length = format_double_fixed(buffer, sizeof(buffer), -0.125, 2);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "-0.13");
+	length = format_double_fixed(buffer, sizeof(buffer), 2.5, 0);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "3");
+	// 2.675 is 2.67499999... in binary, so this is no tie
+	length = format_double_fixed(buffer, sizeof(buffer), 2.675, 2);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "2.67");
+
+	length = format_double_general(buffer, sizeof(buffer), 0.5);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "0.5");
+	length = format_double_general(buffer, sizeof(buffer), 100000.);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "100000");
+	length = format_double_general(buffer, sizeof(buffer), 1e6);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "1e+06");
+	length = format_double_general(buffer, sizeof(buffer), 1e-5);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "1e-05");
+	length = format_double_general(buffer, sizeof(buffer), 1234565.);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "1.23457e+06");
+	length = format_double_general(buffer, sizeof(buffer), NAN);
+	BOOST_CHECK_EQUAL(std::string(buffer, length), "nan");
+
+	for (const double value : { 0.125, -2.5, 1.0/3, 1234565., 6.02e23 }) {
+		length = format_double_fixed(buffer, sizeof(buffer), value, 2);
+		BOOST_CHECK_EQUAL(QString::fromLatin1(buffer, length),
+			QString("%1").arg(value, 0, 'f', 2));
+		length = format_double_general(buffer, sizeof(buffer), value);
+		BOOST_CHECK_EQUAL(QString::fromLatin1(buffer, length),
+			QString("%1").arg(value));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(format_time_si_test)
 {
 	// check prefix calculation